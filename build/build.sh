@@ -14,6 +14,16 @@ NC='\033[0m' # No Color
 # Cross-compiler path
 export PATH="/usr/local/i686-elf/bin:$PATH"
 
+# Optional: BGA_BENCH=1 ./build.sh prints a fill/blit benchmark to serial at boot
+#           TRACE=1 ./build.sh builds in the binary trace ring (tools/trace_decode.py)
+KERNEL_DEFINES=""
+if [ -n "$BGA_BENCH" ]; then
+    KERNEL_DEFINES="$KERNEL_DEFINES -DBGA_BENCHMARK"
+fi
+if [ -n "$TRACE" ]; then
+    KERNEL_DEFINES="$KERNEL_DEFINES -DKERNEL_TRACE"
+fi
+
 # Directories
 SRC_DIR="../src"
 BUILD_DIR="."
@@ -28,13 +38,39 @@ echo -e "${YELLOW}======================================${NC}"
 mkdir -p "$BINARIES_DIR"
 mkdir -p "$ISODIR/boot/grub"
 
+echo -e "\n${YELLOW}[0/5] Generating font tables and icon atlas...${NC}"
+# font_data.c is checked in; with python3 the build uses a fresh copy in
+# $BINARIES_DIR and never touches the source tree
+FONT_DATA="$SRC_DIR/lib/font_data.c"
+if command -v python3 > /dev/null; then
+    python3 ../tools/font_to_c.py ../tools/font/maahi_8x16.txt "$BINARIES_DIR/font_data.c"
+    FONT_DATA="$BINARIES_DIR/font_data.c"
+    if ! cmp -s "$FONT_DATA" "$SRC_DIR/lib/font_data.c"; then
+        echo -e "${YELLOW}src/lib/font_data.c is stale - copy $BINARIES_DIR/font_data.c over it${NC}"
+    fi
+else
+    echo -e "${YELLOW}python3 not found - using the checked-in font_data.c${NC}"
+fi
+
+# Same for the icon atlas: orbit and libgui include icon_atlas.h from ICON_DIR
+ICON_DIR="../libraries/icons"
+if command -v python3 > /dev/null; then
+    python3 ../tools/bmp_to_c.py "$BINARIES_DIR/icons/icon_atlas.h" > /dev/null
+    ICON_DIR="$BINARIES_DIR/icons"
+    if ! cmp -s "$ICON_DIR/icon_atlas.h" ../libraries/icons/icon_atlas.h; then
+        echo -e "${YELLOW}libraries/icons/icon_atlas.h is stale - copy $ICON_DIR/icon_atlas.h over it${NC}"
+    fi
+else
+    echo -e "${YELLOW}python3 not found - using the checked-in icon_atlas.h${NC}"
+fi
+
 echo -e "\n${YELLOW}[1/5] Assembling boot.s...${NC}"
 i686-elf-as "$SRC_DIR/boot.s" -o "$BINARIES_DIR/boot.o"
 echo -e "${GREEN}✓ boot.o created${NC}"
 
 echo -e "\n${YELLOW}[2/5] Compiling kernel.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/kernel.c" -o "$BINARIES_DIR/kernel.o" \
-    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
 echo -e "${GREEN}✓ kernel.o created${NC}"
 
 echo -e "\n${YELLOW}[2b/5] Compiling vga.c...${NC}"
@@ -57,11 +93,30 @@ i686-elf-gcc -c "$SRC_DIR/drivers/bga.c" -o "$BINARIES_DIR/bga.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
 echo -e "${GREEN}✓ bga.o created${NC}"
 
+echo -e "\n${YELLOW}[2b4a/5] Assembling bga_blit.s (fill/blit span kernels)...${NC}"
+i686-elf-as "$SRC_DIR/drivers/bga_blit.s" -o "$BINARIES_DIR/bga_blit.o"
+echo -e "${GREEN}✓ bga_blit.o created${NC}"
+
+echo -e "\n${YELLOW}[2b4b/5] Compiling bga_bench.c (fill/blit benchmark)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/drivers/bga_bench.c" -o "$BINARIES_DIR/bga_bench.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ bga_bench.o created${NC}"
+
 echo -e "\n${YELLOW}[2b5/5] Compiling mouse.c (PS/2 mouse driver)...${NC}"
 i686-elf-gcc -c "$SRC_DIR/drivers/mouse.c" -o "$BINARIES_DIR/mouse.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
 echo -e "${GREEN}✓ mouse.o created${NC}"
 
+echo -e "\n${YELLOW}[2b5/5] Compiling input.c (input event queue)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/drivers/input.c" -o "$BINARIES_DIR/input.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ input.o created${NC}"
+
+echo -e "\n${YELLOW}[2b5/5] Compiling keyboard.c (PS/2 keyboard driver)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/drivers/keyboard.c" -o "$BINARIES_DIR/keyboard.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ keyboard.o created${NC}"
+
 echo -e "\n${YELLOW}[2b6/5] Compiling pci.c (PCI access)...${NC}"
 i686-elf-gcc -c "$SRC_DIR/drivers/pci.c" -o "$BINARIES_DIR/pci.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
@@ -77,6 +132,11 @@ i686-elf-gcc -c "$SRC_DIR/managers/gdt/gdt.c" -o "$BINARIES_DIR/gdt.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
 echo -e "${GREEN}✓ gdt.o created${NC}"
 
+echo -e "\n${YELLOW}[2c2/5] Compiling cpu.c (CPU features, SSE, TSC)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/cpu/cpu.c" -o "$BINARIES_DIR/cpu.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ cpu.o created${NC}"
+
 echo -e "\n${YELLOW}[2d/5] Compiling idt.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/managers/interrupt/idt.c" -o "$BINARIES_DIR/idt.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
@@ -88,7 +148,7 @@ echo -e "${GREEN}✓ interrupt_stubs.o created${NC}"
 
 echo -e "\n${YELLOW}[2d3/5] Compiling exception_handler.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/managers/interrupt/exception_handler.c" -o "$BINARIES_DIR/exception_handler.o" \
-    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
 echo -e "${GREEN}✓ exception_handler.o created${NC}"
 
 echo -e "\n${YELLOW}[2e/5] Compiling ring3.c...${NC}"
@@ -98,7 +158,7 @@ echo -e "${GREEN}✓ ring3.o created${NC}"
 
 echo -e "\n${YELLOW}[2h/5] Compiling syscall_handler.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/syscalls/syscall_handler.c" -o "$BINARIES_DIR/syscall_handler.o" \
-    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
 echo -e "${GREEN}✓ syscall_handler.o created${NC}"
 
 echo -e "\n${YELLOW}[2i/5] Compiling pmm.c...${NC}"
@@ -116,6 +176,13 @@ i686-elf-gcc -c "$SRC_DIR/lib/kheap.c" -o "$BINARIES_DIR/kheap.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
 echo -e "${GREEN}✓ kheap.o created${NC}"
 
+echo -e "\n${YELLOW}[2j2a/5] Compiling font.c (shared font)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/lib/font.c" -o "$BINARIES_DIR/font.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+i686-elf-gcc -c "$FONT_DATA" -o "$BINARIES_DIR/font_data.o" -I "$SRC_DIR/lib" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ font.o, font_data.o created${NC}"
+
 echo -e "\n${YELLOW}[2j3/5] Compiling process_manager.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/managers/process/process_manager.c" -o "$BINARIES_DIR/process_manager.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
@@ -126,9 +193,19 @@ i686-elf-gcc -c "$SRC_DIR/managers/timer/pit.c" -o "$BINARIES_DIR/pit.o" \
     -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
 echo -e "${GREEN}✓ pit.o created${NC}"
 
+echo -e "\n${YELLOW}[2k/5] Compiling clock.c (TSC monotonic clock)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/timer/clock.c" -o "$BINARIES_DIR/clock.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ clock.o created${NC}"
+
+echo -e "\n${YELLOW}[2k/5] Compiling timer.c (timer wheel)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/timer/timer.c" -o "$BINARIES_DIR/timer.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ timer.o created${NC}"
+
 echo -e "\n${YELLOW}[2l/5] Compiling scheduler.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/managers/scheduler/scheduler.c" -o "$BINARIES_DIR/scheduler.o" \
-    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
 echo -e "${GREEN}✓ scheduler.o created${NC}"
 
 echo -e "\n${YELLOW}[2m/5] Assembling switch_osdev.s (context switch - OSDev approach)...${NC}"
@@ -137,12 +214,52 @@ echo -e "${GREEN}✓ switch.o created (OSDev approach)${NC}"
 
 echo -e "\n${YELLOW}[2n/5] Compiling irq_manager.c...${NC}"
 i686-elf-gcc -c "$SRC_DIR/managers/irq/irq_manager.c" -o "$BINARIES_DIR/irq_manager.o" \
-    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
 echo -e "${GREEN}✓ irq_manager.o created${NC}"
 
+echo -e "\n${YELLOW}[2n/5] Compiling lapic.c (local APIC timer)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/irq/lapic.c" -o "$BINARIES_DIR/lapic.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
+echo -e "${GREEN}✓ lapic.o created${NC}"
+
+echo -e "\n${YELLOW}[2o/5] Compiling ioapic.c (I/O APIC routing)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/irq/ioapic.c" -o "$BINARIES_DIR/ioapic.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ ioapic.o created${NC}"
+
+echo -e "\n${YELLOW}[2p/5] Compiling acpi.c (MADT parsing)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/acpi/acpi.c" -o "$BINARIES_DIR/acpi.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ acpi.o created${NC}"
+
+echo -e "\n${YELLOW}[2q/5] Compiling softirq.c (deferred IRQ work)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/irq/softirq.c" -o "$BINARIES_DIR/softirq.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ softirq.o created${NC}"
+
+echo -e "\n${YELLOW}[2r/5] Compiling klog.c (kernel log)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/log/klog.c" -o "$BINARIES_DIR/klog.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ klog.o created${NC}"
+
+echo -e "\n${YELLOW}[2s/5] Compiling trace.c (trace ring)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/trace/trace.c" -o "$BINARIES_DIR/trace.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32 $KERNEL_DEFINES
+echo -e "${GREEN}✓ trace.o created${NC}"
+
+echo -e "\n${YELLOW}[2t/5] Compiling profiler.c (sampling profiler)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/profile/profiler.c" -o "$BINARIES_DIR/profiler.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ profiler.o created${NC}"
+
+echo -e "\n${YELLOW}[2u/5] Compiling pmc.c (performance counters)...${NC}"
+i686-elf-gcc -c "$SRC_DIR/managers/pmc/pmc.c" -o "$BINARIES_DIR/pmc.o" \
+    -ffreestanding -fno-stack-protector -fno-pic -fno-pie -m32
+echo -e "${GREEN}✓ pmc.o created${NC}"
+
 echo -e "\n${YELLOW}[3/5] Linking kernel...${NC}"
 i686-elf-ld -T "$SRC_DIR/linker.ld" -o "$BUILD_DIR/kernel.bin" \
-    "$BINARIES_DIR/boot.o" "$BINARIES_DIR/kernel.o" "$BINARIES_DIR/vga.o" "$BINARIES_DIR/graphics.o" "$BINARIES_DIR/vbe.o" "$BINARIES_DIR/bga.o" "$BINARIES_DIR/mouse.o" "$BINARIES_DIR/pci.o" "$BINARIES_DIR/usb.o" "$BINARIES_DIR/gdt.o" "$BINARIES_DIR/idt.o" "$BINARIES_DIR/interrupt_stubs.o" "$BINARIES_DIR/exception_handler.o" "$BINARIES_DIR/ring3.o" "$BINARIES_DIR/syscall_handler.o" "$BINARIES_DIR/pmm.o" "$BINARIES_DIR/paging.o" "$BINARIES_DIR/kheap.o" "$BINARIES_DIR/process_manager.o" "$BINARIES_DIR/pit.o" "$BINARIES_DIR/scheduler.o" "$BINARIES_DIR/switch.o" "$BINARIES_DIR/irq_manager.o"
+    "$BINARIES_DIR/boot.o" "$BINARIES_DIR/kernel.o" "$BINARIES_DIR/vga.o" "$BINARIES_DIR/graphics.o" "$BINARIES_DIR/vbe.o" "$BINARIES_DIR/bga.o" "$BINARIES_DIR/bga_blit.o" "$BINARIES_DIR/bga_bench.o" "$BINARIES_DIR/mouse.o" "$BINARIES_DIR/input.o" "$BINARIES_DIR/keyboard.o" "$BINARIES_DIR/pci.o" "$BINARIES_DIR/usb.o" "$BINARIES_DIR/gdt.o" "$BINARIES_DIR/cpu.o" "$BINARIES_DIR/idt.o" "$BINARIES_DIR/interrupt_stubs.o" "$BINARIES_DIR/exception_handler.o" "$BINARIES_DIR/ring3.o" "$BINARIES_DIR/syscall_handler.o" "$BINARIES_DIR/pmm.o" "$BINARIES_DIR/paging.o" "$BINARIES_DIR/kheap.o" "$BINARIES_DIR/font.o" "$BINARIES_DIR/font_data.o" "$BINARIES_DIR/process_manager.o" "$BINARIES_DIR/pit.o" "$BINARIES_DIR/clock.o" "$BINARIES_DIR/timer.o" "$BINARIES_DIR/scheduler.o" "$BINARIES_DIR/switch.o" "$BINARIES_DIR/irq_manager.o" "$BINARIES_DIR/lapic.o" "$BINARIES_DIR/ioapic.o" "$BINARIES_DIR/acpi.o" "$BINARIES_DIR/softirq.o" "$BINARIES_DIR/klog.o" "$BINARIES_DIR/trace.o" "$BINARIES_DIR/profiler.o" "$BINARIES_DIR/pmc.o"
 echo -e "${GREEN}✓ kernel.bin created${NC}"
 
 echo -e "\n${YELLOW}[4a/7] Building sysman (Ring 3 System Manager)...${NC}"
@@ -196,21 +313,46 @@ i686-elf-gcc -c "$SRC_DIR/libgui/cursor.c" -o "$BINARIES_DIR/gui_cursor.o" \
     -ffreestanding -fno-stack-protector -fPIC -m32
 echo -e "${GREEN}✓ gui_cursor.o created${NC}"
 
+i686-elf-gcc -c "$SRC_DIR/libgui/text.c" -o "$BINARIES_DIR/gui_text.o" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+echo -e "${GREEN}✓ gui_text.o created${NC}"
+
+i686-elf-gcc -c "$SRC_DIR/libgui/damage.c" -o "$BINARIES_DIR/gui_damage.o" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+echo -e "${GREEN}✓ gui_damage.o created${NC}"
+
+i686-elf-gcc -c "$SRC_DIR/libgui/sprite.c" -o "$BINARIES_DIR/gui_sprite.o" -I "$ICON_DIR" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+echo -e "${GREEN}✓ gui_sprite.o created${NC}"
+
+# Shared font tables for text measurement (position-independent)
+i686-elf-gcc -c "$SRC_DIR/lib/font.c" -o "$BINARIES_DIR/gui_font.o" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+i686-elf-gcc -c "$FONT_DATA" -o "$BINARIES_DIR/gui_font_data.o" -I "$SRC_DIR/lib" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+echo -e "${GREEN}✓ gui_font.o, gui_font_data.o created${NC}"
+
 # Compile cursor compositor
 i686-elf-gcc -c "$SRC_DIR/libgui/cursor_compositor.c" -o "$BINARIES_DIR/cursor_compositor.o" \
     -ffreestanding -fno-stack-protector -fPIC -m32
 echo -e "${GREEN}✓ cursor_compositor.o created${NC}"
 
 # Compile orbit C code (position-independent)
-i686-elf-gcc -c "$SRC_DIR/orbit/orbit.c" -o "$BINARIES_DIR/orbit.o" \
+i686-elf-gcc -c "$SRC_DIR/orbit/orbit.c" -o "$BINARIES_DIR/orbit.o" -I "$ICON_DIR" \
     -ffreestanding -fno-stack-protector -fPIC -m32
 echo -e "${GREEN}✓ orbit.o created (position-independent)${NC}"
 
+i686-elf-gcc -c "$SRC_DIR/orbit/monitor.c" -o "$BINARIES_DIR/orbit_monitor.o" \
+    -ffreestanding -fno-stack-protector -fPIC -m32
+echo -e "${GREEN}✓ orbit_monitor.o created${NC}"
+
 # Link orbit with LibGUI (uses syscalls only)
 i686-elf-ld -T "$SRC_DIR/orbit/orbit_linker.ld" -o "$BUILD_DIR/orbit.elf" \
-    "$BINARIES_DIR/orbit_entry.o" "$BINARIES_DIR/orbit.o" \
+    "$BINARIES_DIR/orbit_entry.o" "$BINARIES_DIR/orbit.o" "$BINARIES_DIR/orbit_monitor.o" \
     "$BINARIES_DIR/gui_draw.o" "$BINARIES_DIR/gui_window.o" \
     "$BINARIES_DIR/gui_controls.o" "$BINARIES_DIR/gui_cursor.o" \
+    "$BINARIES_DIR/gui_text.o" "$BINARIES_DIR/gui_font.o" "$BINARIES_DIR/gui_font_data.o" \
+    "$BINARIES_DIR/gui_sprite.o" "$BINARIES_DIR/gui_damage.o" \
     "$BINARIES_DIR/cursor_compositor.o" \
     "$BINARIES_DIR/user_syscalls.o"
 echo -e "${GREEN}✓ orbit.elf created (with mouse support)${NC}"
@@ -4,184 +4,616 @@
  */
 
 #include "bga.h"
+#include "../managers/cpu/cpu.h"
+#include "../lib/font.h"
+#include "../managers/log/klog.h"
 #include <stdint.h>
 
-/* Serial debug helpers */
-static inline unsigned char inb(unsigned short port) {
-    unsigned char ret;
-    __asm__ volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
-    return ret;
+/* Span kernels (bga_blit.s) */
+extern void bga_fill32_rep(uint32_t *dst, uint32_t value, uint32_t count);
+extern void bga_copy32_rep(uint32_t *dst, const uint32_t *src, uint32_t count);
+extern void bga_fill32_nt(uint32_t *dst, uint32_t value, uint32_t count);
+extern void bga_copy32_nt(uint32_t *dst, const uint32_t *src, uint32_t count);
+extern void bga_blend32_sse2(uint32_t *dst, const uint32_t *src, uint32_t count);
+extern void bga_blend32_pm_sse2(uint32_t *dst, const uint32_t *src, uint32_t count);
+
+/* Global state */
+static uint32_t *framebuffer = 0;       // Draw target (back page / RAM shadow)
+static uint32_t *frontbuffer = 0;       // Page currently scanned out
+static uint32_t *vram_base = 0;         // Start of linear framebuffer
+static uint32_t *shadowbuffer = 0;      // Cacheable RAM copy of the screen
+static int present_mode = BGA_PRESENT_DIRECT;
+static int flip_capable = 0;            // Virtual height holds two pages
+static int front_page = 0;              // 0 or 1 - which page is visible
+static int scroll_y = 0;                // Y offset of the visible window (console panning)
+static int accel_level = BGA_ACCEL_SCALAR;
+static uint16_t screen_width = 0;
+static uint16_t screen_height = 0;
+static uint16_t screen_bpp = 0;
+static int cursor_x = 0;
+static int cursor_y = 0;
+
+/* Text console (defined with bga_print) */
+static void console_init(void);
+static void console_unpan(void);
+static void console_reset(uint32_t color);
+
+/**
+ * Kernel-managed mouse cursor sprite
+ * The sprite is composited straight into the framebuffer from the mouse
+ * IRQ, so pointer latency is IRQ latency rather than a Ring 3 polling loop.
+ * Writes to the front page are bracketed with sprite_begin()/sprite_end();
+ * while one is running the IRQ only records the new position and the move
+ * is applied when the write finishes.
+ * The sprite always lives on the front page; with page flipping or the
+ * RAM shadow the primitives never write there directly.
+ */
+static uint32_t sprite_image[BGA_CURSOR_MAX_W * BGA_CURSOR_MAX_H];
+static uint32_t sprite_backup[BGA_CURSOR_MAX_W * BGA_CURSOR_MAX_H];
+static int sprite_width = 0;
+static int sprite_height = 0;
+static int sprite_hot_x = 0;
+static int sprite_hot_y = 0;
+static int sprite_pos_x = 0;            // Pointer position (hotspot)
+static int sprite_pos_y = 0;
+static int sprite_drawn = 0;            // Sprite currently in framebuffer
+static int sprite_drawn_x = 0;          // Top-left of composited sprite
+static int sprite_drawn_y = 0;
+static volatile int sprite_draw_depth = 0;   // Primitives in progress
+static volatile int sprite_move_pending = 0; // IRQ moved pointer mid-draw
+
+/**
+ * Blend one ARGB pixel over an RGB framebuffer pixel
+ * Divides by 255 with rounding, matching bga_blend32_sse2 bit for bit
+ */
+static inline uint32_t blend_pixel(uint32_t src, uint32_t dst) {
+    uint32_t a = src >> 24;
+    if (a == 0xFF) return src & 0x00FFFFFF;
+    if (a == 0) return dst & 0x00FFFFFF;
+
+    uint32_t inv = 255 - a;
+    uint32_t rb = (src & 0x00FF00FF) * a + (dst & 0x00FF00FF) * inv + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    uint32_t g = ((src >> 8) & 0xFF) * a + ((dst >> 8) & 0xFF) * inv + 0x80;
+    g = (g + (g >> 8)) >> 8;
+    return rb | (g << 8);
 }
 
-static inline void outb(unsigned short port, unsigned char val) {
-    __asm__ volatile("outb %0, %1" : : "a"(val), "Nd"(port));
+/**
+ * Blend one premultiplied ARGB pixel over an RGB framebuffer pixel
+ * Matches bga_blend32_pm_sse2 for valid input (colour <= alpha)
+ */
+static inline uint32_t blend_pixel_premul(uint32_t src, uint32_t dst) {
+    uint32_t inv = 255 - (src >> 24);
+    if (inv == 0) return src & 0x00FFFFFF;
+
+    uint32_t rb = (dst & 0x00FF00FF) * inv + 0x00800080;
+    rb = ((rb + ((rb >> 8) & 0x00FF00FF)) >> 8) & 0x00FF00FF;
+    uint32_t g = ((dst >> 8) & 0xFF) * inv + 0x80;
+    g = (g + (g >> 8)) >> 8;
+    return (src & 0x00FFFFFF) + (rb | (g << 8));
 }
 
-static void serial_print(const char *str) {
-    while (*str) {
-        while ((inb(0x3FD) & 0x20) == 0);
-        outb(0x3F8, *str++);
+/**
+ * Restore the pixels under the sprite (interrupts must be off or the
+ * sprite owned by the caller)
+ */
+static void sprite_hide(void) {
+    if (!sprite_drawn) return;
+
+    for (int row = 0; row < sprite_height; row++) {
+        int py = sprite_drawn_y + row;
+        if (py < 0 || py >= screen_height) continue;
+        for (int col = 0; col < sprite_width; col++) {
+            int px = sprite_drawn_x + col;
+            if (px < 0 || px >= screen_width) continue;
+            frontbuffer[py * screen_width + px] = sprite_backup[row * BGA_CURSOR_MAX_W + col];
+        }
     }
+    sprite_drawn = 0;
 }
 
-static void serial_hex(uint32_t value) {
-    char hex[] = "0123456789ABCDEF";
-    for (int i = 7; i >= 0; i--) {
-        unsigned char nibble = (value >> (i * 4)) & 0xF;
-        while ((inb(0x3FD) & 0x20) == 0);
-        outb(0x3F8, hex[nibble]);
+/**
+ * Save the background and composite the sprite at the pointer position
+ */
+static void sprite_show(void) {
+    if (!frontbuffer || sprite_width == 0) return;
+
+    sprite_drawn_x = sprite_pos_x - sprite_hot_x;
+    sprite_drawn_y = sprite_pos_y - sprite_hot_y;
+
+    for (int row = 0; row < sprite_height; row++) {
+        int py = sprite_drawn_y + row;
+        if (py < 0 || py >= screen_height) continue;
+        for (int col = 0; col < sprite_width; col++) {
+            int px = sprite_drawn_x + col;
+            if (px < 0 || px >= screen_width) continue;
+            uint32_t *pixel = &frontbuffer[py * screen_width + px];
+            sprite_backup[row * BGA_CURSOR_MAX_W + col] = *pixel;
+            *pixel = blend_pixel(sprite_image[row * BGA_CURSOR_MAX_W + col], *pixel);
+        }
     }
+    sprite_drawn = 1;
 }
 
-/* Global state */
-static uint32_t *framebuffer = 0;
-static uint16_t screen_width = 0;
-static uint16_t screen_height = 0;
-static uint16_t screen_bpp = 0;
-static int cursor_x = 0;
-static int cursor_y = 0;
+/**
+ * Start a front page write covering (x, y, width, height)
+ * Hides the sprite only if the area overlaps it
+ */
+static void sprite_begin(int x, int y, int width, int height) {
+    sprite_draw_depth++;
+
+    // IRQ12 defers to us from here on, so the sprite state is stable
+    if (!sprite_drawn) return;
+    if (x >= sprite_drawn_x + sprite_width || x + width <= sprite_drawn_x ||
+        y >= sprite_drawn_y + sprite_height || y + height <= sprite_drawn_y) {
+        return;
+    }
+    sprite_hide();
+}
+
+/**
+ * Finish a front page write and put the sprite back
+ */
+static void sprite_end(void) {
+    uint32_t flags = irq_save();
+
+    if (--sprite_draw_depth == 0 && sprite_width != 0) {
+        if (!sprite_drawn || sprite_move_pending) {
+            sprite_hide();
+            sprite_show();
+        }
+        sprite_move_pending = 0;
+    }
+
+    irq_restore(flags);
+}
+
+/**
+ * Move the cursor sprite (called from the mouse IRQ)
+ */
+void bga_cursor_move(int x, int y) {
+    uint32_t flags = irq_save();
+
+    sprite_pos_x = x;
+    sprite_pos_y = y;
+
+    if (sprite_draw_depth > 0) {
+        sprite_move_pending = 1;  // Applied by sprite_end()
+    } else if (sprite_width != 0) {
+        sprite_hide();
+        sprite_show();
+    }
+
+    irq_restore(flags);
+}
+
+/**
+ * Install a new cursor sprite
+ * argb: width*height pixels, alpha 0 = transparent, 255 = opaque
+ * Returns 1 on success, 0 if the image is too large
+ */
+int bga_cursor_set_image(const uint32_t *argb, int width, int height, int hot_x, int hot_y) {
+    if (width < 0 || height < 0 || width > BGA_CURSOR_MAX_W || height > BGA_CURSOR_MAX_H) {
+        return 0;
+    }
+    if (width > 0 && !argb) return 0;
+
+    uint32_t flags = irq_save();
+
+    sprite_hide();
+    for (int row = 0; row < height; row++) {
+        for (int col = 0; col < width; col++) {
+            sprite_image[row * BGA_CURSOR_MAX_W + col] = argb[row * width + col];
+        }
+    }
+    sprite_width = width;
+    sprite_height = height;
+    sprite_hot_x = hot_x;
+    sprite_hot_y = hot_y;
+    if (sprite_draw_depth == 0) {
+        sprite_show();
+    } else {
+        sprite_move_pending = 1;
+    }
+
+    irq_restore(flags);
+    return 1;
+}
+
+/**
+ * Rectangles as edges - right/bottom are exclusive
+ */
+typedef struct {
+    int x1, y1, x2, y2;
+} rect_t;
+
+/**
+ * Intersect two rectangles
+ * Returns 0 (and leaves out untouched) if they do not overlap
+ */
+static int rect_intersect(const rect_t *a, const rect_t *b, rect_t *out) {
+    int x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    int y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    int x2 = a->x2 < b->x2 ? a->x2 : b->x2;
+    int y2 = a->y2 < b->y2 ? a->y2 : b->y2;
+    if (x1 >= x2 || y1 >= y2) return 0;
+
+    out->x1 = x1;
+    out->y1 = y1;
+    out->x2 = x2;
+    out->y2 = y2;
+    return 1;
+}
+
+/**
+ * Clip stack
+ * Entry 0 is the screen; every push is intersected with the entry below,
+ * so the top is always the effective clip. Primitives clip once against
+ * it and then draw whole spans with no per-pixel bounds checks.
+ * bga_clear() is the exception and always clears the whole screen.
+ */
+static rect_t clip_stack[BGA_CLIP_DEPTH + 1];
+static int clip_depth = 0;
+
+/**
+ * Clip (x, y, width, height) against the current clip
+ * Returns 0 if nothing is left
+ */
+static int clip_rect(int *x, int *y, int *width, int *height) {
+    rect_t r = { *x, *y, *x + *width, *y + *height };
+    if (*width <= 0 || *height <= 0) return 0;
+    if (!rect_intersect(&r, &clip_stack[clip_depth], &r)) return 0;
+
+    *x = r.x1;
+    *y = r.y1;
+    *width = r.x2 - r.x1;
+    *height = r.y2 - r.y1;
+    return 1;
+}
+
+/**
+ * Push a clip rectangle (intersected with the current clip)
+ * Returns the new depth, or -1 if the stack is full
+ */
+int bga_clip_push(int x, int y, int width, int height) {
+    if (clip_depth >= BGA_CLIP_DEPTH) return -1;
+
+    rect_t r = { x, y, x + width, y + height };
+    rect_t *top = &clip_stack[clip_depth + 1];
+    if (width <= 0 || height <= 0 || !rect_intersect(&r, &clip_stack[clip_depth], top)) {
+        // Nothing visible - an empty clip swallows all drawing
+        top->x1 = top->x2 = 0;
+        top->y1 = top->y2 = 0;
+    }
+    return ++clip_depth;
+}
 
 /**
- * Read a pixel from the framebuffer
- * Used by cursor compositor to save/restore background
+ * Pop the last clip rectangle
+ * Returns the remaining depth (0 = whole screen)
+ */
+int bga_clip_pop(void) {
+    if (clip_depth > 0) clip_depth--;
+    return clip_depth;
+}
+
+/**
+ * Drop every pushed clip rectangle
+ */
+void bga_clip_reset(void) {
+    clip_depth = 0;
+}
+
+/**
+ * Rectangle kernels - strides are in pixels and may be negative
+ * Pick the span loop for the current accel level once per rectangle.
+ * to_vram selects non-temporal stores, which only pay off for memory
+ * that is not read back through the cache.
+ */
+static void rect_fill(uint32_t *dst, int stride, int width, int height, uint32_t value, int to_vram) {
+    // Contiguous rows become one span
+    if (stride == width) {
+        width *= height;
+        height = 1;
+    }
+
+    if (accel_level == BGA_ACCEL_SSE2 && to_vram) {
+        kernel_fpu_begin();
+        for (int row = 0; row < height; row++, dst += stride) {
+            bga_fill32_nt(dst, value, width);
+        }
+        kernel_fpu_end();
+    } else if (accel_level >= BGA_ACCEL_REP) {
+        for (int row = 0; row < height; row++, dst += stride) {
+            bga_fill32_rep(dst, value, width);
+        }
+    } else {
+        for (int row = 0; row < height; row++, dst += stride) {
+            for (int col = 0; col < width; col++) {
+                dst[col] = value;
+            }
+        }
+    }
+}
+
+static void rect_copy(uint32_t *dst, int dst_stride, const uint32_t *src, int src_stride,
+                      int width, int height, int to_vram) {
+    if (accel_level == BGA_ACCEL_SSE2 && to_vram) {
+        kernel_fpu_begin();
+        for (int row = 0; row < height; row++, dst += dst_stride, src += src_stride) {
+            bga_copy32_nt(dst, src, width);
+        }
+        kernel_fpu_end();
+    } else if (accel_level >= BGA_ACCEL_REP) {
+        for (int row = 0; row < height; row++, dst += dst_stride, src += src_stride) {
+            bga_copy32_rep(dst, src, width);
+        }
+    } else {
+        for (int row = 0; row < height; row++, dst += dst_stride, src += src_stride) {
+            for (int col = 0; col < width; col++) {
+                dst[col] = src[col];
+            }
+        }
+    }
+}
+
+static void rect_blend(uint32_t *dst, int dst_stride, const uint32_t *src, int src_stride,
+                       int width, int height) {
+    int simd = (accel_level == BGA_ACCEL_SSE2) ? (width & ~3) : 0;
+
+    if (simd) kernel_fpu_begin();
+    for (int row = 0; row < height; row++, dst += dst_stride, src += src_stride) {
+        if (simd) bga_blend32_sse2(dst, src, simd);
+        for (int col = simd; col < width; col++) {
+            dst[col] = blend_pixel(src[col], dst[col]);
+        }
+    }
+    if (simd) kernel_fpu_end();
+}
+
+static void rect_blend_premul(uint32_t *dst, int dst_stride, const uint32_t *src, int src_stride,
+                              int width, int height) {
+    int simd = (accel_level == BGA_ACCEL_SSE2) ? (width & ~3) : 0;
+
+    if (simd) kernel_fpu_begin();
+    for (int row = 0; row < height; row++, dst += dst_stride, src += src_stride) {
+        if (simd) bga_blend32_pm_sse2(dst, src, simd);
+        for (int col = simd; col < width; col++) {
+            dst[col] = blend_pixel_premul(src[col], dst[col]);
+        }
+    }
+    if (simd) kernel_fpu_end();
+}
+
+/**
+ * Dirty rectangles for the RAM shadow and the flip back page
+ * Overlapping or touching rectangles are merged as they are added when
+ * the union costs no more to copy than the two parts, so the list stays
+ * short without an outline dragging its whole interior into present().
+ */
+static rect_t dirty_rects[BGA_DIRTY_MAX];
+static int dirty_count = 0;
+
+static int rect_area(int x1, int y1, int x2, int y2) {
+    return (x2 - x1) * (y2 - y1);
+}
+
+static void dirty_add(int x, int y, int width, int height) {
+    rect_t area = { x, y, x + width, y + height };
+    if (width <= 0 || height <= 0 || !rect_intersect(&area, &clip_stack[0], &area)) return;
+    int x1 = area.x1;
+    int y1 = area.y1;
+    int x2 = area.x2;
+    int y2 = area.y2;
+
+    // Absorb every rectangle worth merging; growing can reach new ones, so rescan
+    int i = 0;
+    while (i < dirty_count) {
+        rect_t *r = &dirty_rects[i];
+        if (x1 <= r->x2 && r->x1 <= x2 && y1 <= r->y2 && r->y1 <= y2 &&
+            rect_area(r->x1 < x1 ? r->x1 : x1, r->y1 < y1 ? r->y1 : y1,
+                      r->x2 > x2 ? r->x2 : x2, r->y2 > y2 ? r->y2 : y2) <=
+            rect_area(x1, y1, x2, y2) + rect_area(r->x1, r->y1, r->x2, r->y2)) {
+            if (r->x1 < x1) x1 = r->x1;
+            if (r->y1 < y1) y1 = r->y1;
+            if (r->x2 > x2) x2 = r->x2;
+            if (r->y2 > y2) y2 = r->y2;
+            dirty_rects[i] = dirty_rects[--dirty_count];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    if (dirty_count == BGA_DIRTY_MAX) {
+        // List full - collapse everything into one bounding box
+        for (i = 0; i < dirty_count; i++) {
+            if (dirty_rects[i].x1 < x1) x1 = dirty_rects[i].x1;
+            if (dirty_rects[i].y1 < y1) y1 = dirty_rects[i].y1;
+            if (dirty_rects[i].x2 > x2) x2 = dirty_rects[i].x2;
+            if (dirty_rects[i].y2 > y2) y2 = dirty_rects[i].y2;
+        }
+        dirty_count = 0;
+    }
+
+    dirty_rects[dirty_count].x1 = x1;
+    dirty_rects[dirty_count].y1 = y1;
+    dirty_rects[dirty_count].x2 = x2;
+    dirty_rects[dirty_count].y2 = y2;
+    dirty_count++;
+}
+
+/**
+ * Copy the dirty spans between the front page and another buffer
+ * SHADOW: RAM shadow -> front page. FLIP: new front page -> new back
+ * page, so the back page holds the current frame again.
+ */
+static void dirty_flush(uint32_t *dst, const uint32_t *src) {
+    for (int i = 0; i < dirty_count; i++) {
+        rect_t *r = &dirty_rects[i];
+        int offset = r->y1 * screen_width + r->x1;
+
+        sprite_begin(r->x1, r->y1, r->x2 - r->x1, r->y2 - r->y1);
+        rect_copy(dst + offset, screen_width, src + offset, screen_width,
+                  r->x2 - r->x1, r->y2 - r->y1, 1);
+        sprite_end();
+    }
+    dirty_count = 0;
+}
+
+/**
+ * Start a primitive writing (x, y, width, height) of the draw target
+ */
+static void draw_begin(int x, int y, int width, int height) {
+    // DIRECT draws off the front page only while the console renders its
+    // next page - the sprite is not there, so leave it alone
+    if (present_mode == BGA_PRESENT_DIRECT && framebuffer == frontbuffer) {
+        sprite_begin(x, y, width, height);
+    } else if (present_mode != BGA_PRESENT_DIRECT) {
+        dirty_add(x, y, width, height);
+    }
+}
+
+static void draw_end(void) {
+    if (present_mode == BGA_PRESENT_DIRECT && framebuffer == frontbuffer) {
+        sprite_end();
+    }
+}
+
+/**
+ * Read a pixel from the draw target
+ * Returns the background under the cursor sprite, never the sprite itself.
+ * With the RAM shadow this never touches VRAM.
  */
 uint32_t bga_get_pixel(int x, int y) {
     if (!framebuffer || x < 0 || y < 0 || x >= screen_width || y >= screen_height) {
         return 0x000000;  // Black for out-of-bounds
     }
-    return framebuffer[y * screen_width + x];
-}
-
-/* 8x16 VGA Font (same as VBE - for text rendering) */
-static const uint8_t font_8x16[128][16] = {
-    [0 ... 31] = {0},
-    [32] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // Space
-    [33] = {0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x18, 0x18,
-            0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},  // !
-    [48] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x6E, 0x76, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 0
-    [49] = {0x00, 0x00, 0x18, 0x38, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // 1
-    [50] = {0x00, 0x00, 0x3C, 0x66, 0x06, 0x0C, 0x18, 0x30,
-            0x60, 0x66, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // 2
-    [65] = {0x00, 0x00, 0x18, 0x3C, 0x66, 0x66, 0x66, 0x7E,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // A
-    [66] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x66,
-            0x66, 0x66, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00},  // B
-    [67] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x60, 0x60, 0x60,
-            0x60, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // C
-    [68] = {0x00, 0x00, 0x78, 0x6C, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x6C, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00},  // D
-    [69] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x60, 0x7C, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // E
-    [72] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x66,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // H
-    [73] = {0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // I
-    [76] = {0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // L
-    [77] = {0x00, 0x00, 0x63, 0x77, 0x7F, 0x6B, 0x63, 0x63,
-            0x63, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00},  // M
-    [79] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // O
-    [82] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x6C,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // R
-    [83] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x30, 0x18, 0x0C,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // S
-    [84] = {0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // T
-    [85] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // U
-    [86] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // V
-    [87] = {0x00, 0x00, 0x63, 0x63, 0x63, 0x6B, 0x6B, 0x7F,
-            0x77, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00},  // W
-    [88] = {0x00, 0x00, 0x66, 0x66, 0x3C, 0x18, 0x18, 0x3C,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // X
-    [89] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x18,
-            0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // Y
-    [90] = {0x00, 0x00, 0x7E, 0x06, 0x0C, 0x18, 0x30, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // Z
-    [70] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x60, 0x7C, 0x60,
-            0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00},  // F
-    [71] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x60, 0x6E, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // G
-    [75] = {0x00, 0x00, 0x66, 0x6C, 0x78, 0x70, 0x78, 0x6C,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // K
-    [78] = {0x00, 0x00, 0x66, 0x66, 0x76, 0x7E, 0x6E, 0x66,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // N
-    [80] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x60,
-            0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00},  // P
-    [81] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x3C, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00},  // Q
-    [51] = {0x00, 0x00, 0x3C, 0x66, 0x06, 0x0C, 0x18, 0x0C,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 3
-    [52] = {0x00, 0x00, 0x0C, 0x1C, 0x3C, 0x6C, 0x6C, 0x7E,
-            0x0C, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 4
-    [53] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x7C, 0x06, 0x06,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 5
-    [54] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x60, 0x7C, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 6
-    [55] = {0x00, 0x00, 0x7E, 0x06, 0x0C, 0x0C, 0x18, 0x18,
-            0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00},  // 7
-    [56] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 8
-    [57] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3E, 0x06,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 9
-    [97] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x06, 0x3E, 0x66,
-            0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00},  // a
-    [98] = {0x00, 0x00, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00},  // b
-    [99] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x60, 0x60,
-            0x60, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // c
-    [100] = {0x00, 0x00, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00}, // d
-    [101] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x7E,
-             0x60, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00}, // e
-    [102] = {0x00, 0x00, 0x1E, 0x30, 0x30, 0x7C, 0x30, 0x30,
-             0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00}, // f
-    [103] = {0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66,
-             0x66, 0x3E, 0x06, 0x66, 0x3C, 0x00, 0x00, 0x00}, // g
-    [104] = {0x00, 0x00, 0x60, 0x60, 0x6C, 0x76, 0x66, 0x66,
-             0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00}, // h
-    [105] = {0x00, 0x00, 0x18, 0x00, 0x38, 0x18, 0x18, 0x18,
-             0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00}, // i
-    [106] = {0x00, 0x00, 0x0C, 0x00, 0x1C, 0x0C, 0x0C, 0x0C,
-             0x0C, 0x0C, 0x0C, 0x6C, 0x38, 0x00, 0x00, 0x00}, // j
-    [107] = {0x00, 0x00, 0x60, 0x60, 0x66, 0x6C, 0x78, 0x70,
-             0x78, 0x6C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00}, // k
-    [108] = {0x00, 0x00, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18,
-             0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00}, // l
-    [109] = {0x00, 0x00, 0x00, 0x00, 0x6C, 0x7E, 0x6B, 0x6B,
-             0x6B, 0x6B, 0x6B, 0x00, 0x00, 0x00, 0x00, 0x00}, // m
-    [110] = {0x00, 0x00, 0x00, 0x00, 0x6C, 0x76, 0x66, 0x66,
-             0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00}, // n
-    [111] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00}, // o
-    [112] = {0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66,
-             0x66, 0x7C, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00}, // p
-    [113] = {0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66,
-             0x66, 0x3E, 0x06, 0x06, 0x06, 0x00, 0x00, 0x00}, // q
-    [114] = {0x00, 0x00, 0x00, 0x00, 0x6C, 0x76, 0x60, 0x60,
-             0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00}, // r (fixed)
-    [115] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x60, 0x3C, 0x06,
-             0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00}, // s
-    [116] = {0x00, 0x00, 0x30, 0x30, 0x7C, 0x30, 0x30, 0x30,
-             0x30, 0x30, 0x1E, 0x00, 0x00, 0x00, 0x00, 0x00}, // t
-    [117] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00}, // u
-    [118] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x66, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00}, // v
-    [119] = {0x00, 0x00, 0x00, 0x00, 0x63, 0x63, 0x6B, 0x6B,
-             0x6B, 0x7E, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00}, // w
-    [120] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x3C, 0x18,
-             0x3C, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00}, // x
-    [121] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x66, 0x3E, 0x06, 0x66, 0x3C, 0x00, 0x00, 0x00}, // y
-    [122] = {0x00, 0x00, 0x00, 0x00, 0x7E, 0x06, 0x0C, 0x18,
-             0x30, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00}, // z
-};
+
+    uint32_t flags = irq_save();
+    uint32_t pixel = framebuffer[y * screen_width + x];
+    int sx = x - sprite_drawn_x;
+    int sy = y - sprite_drawn_y;
+    if (framebuffer == frontbuffer && sprite_drawn && sx >= 0 && sy >= 0 && sx < sprite_width && sy < sprite_height) {
+        pixel = sprite_backup[sy * BGA_CURSOR_MAX_W + sx];
+    }
+    irq_restore(flags);
+
+    return pixel;
+}
+
+/**
+ * Glyph rendering
+ * Glyphs come from the shared font tables (src/lib/font_data.c). Opaque
+ * text (bg alpha != 0) copies whole rows from cell tiles that are expanded
+ * once per (glyph, fg, bg, style) and kept in a small set-associative LRU
+ * cache. Transparent 1bpp text fills the runs of set bits in each font row;
+ * the runs for all 256 row patterns are precomputed. Transparent
+ * anti-aliased text blends a cached ARGB tile of the glyph's ink box.
+ */
+#define GLYPH_W     (FONT_CELL_WIDTH + 1)   // Widest proportional advance
+#define GLYPH_H     FONT_HEIGHT
+
+typedef struct {
+    uint32_t fg, bg;            // RGB; bg has alpha 0xFF for opaque tiles, 0 for AA ink tiles
+    uint32_t stamp;             // Last use, 0 = empty
+    uint8_t index;              // Glyph index in font_glyphs
+    uint8_t style;              // FONT_STYLE_* the tile was expanded for
+    uint32_t pixels[GLYPH_W * GLYPH_H];
+} glyph_tile_t;
+
+typedef struct {
+    uint8_t count;              // Runs in this row pattern (max 4)
+    uint8_t start[4];
+    uint8_t len[4];
+} glyph_runs_t;
+
+static glyph_tile_t glyph_cache[BGA_GLYPH_SETS][BGA_GLYPH_WAYS];
+static uint32_t glyph_clock = 0;
+static glyph_runs_t glyph_runs[256];
+
+/**
+ * Precompute the set-bit runs of every possible font row
+ */
+static void glyph_runs_init(void) {
+    for (int bits = 0; bits < 256; bits++) {
+        glyph_runs_t *runs = &glyph_runs[bits];
+        runs->count = 0;
+        int col = 0;
+        while (col < FONT_CELL_WIDTH) {
+            if (!(bits & (0x80 >> col))) {
+                col++;
+                continue;
+            }
+            int start = col;
+            while (col < FONT_CELL_WIDTH && (bits & (0x80 >> col))) col++;
+            runs->start[runs->count] = start;
+            runs->len[runs->count] = col - start;
+            runs->count++;
+        }
+    }
+}
+
+/**
+ * Coverage of one ink pixel, 0-255
+ */
+static inline uint32_t glyph_coverage(int index, int row, int col, int style) {
+    const font_glyph_t *glyph = &font_glyphs[index];
+    if (style & FONT_STYLE_ANTIALIAS) {
+        return font_alpha_at(glyph, row, col) * 17;
+    }
+    return (font_bitmap[index * FONT_HEIGHT + row] & (0x80 >> col)) ? 0xFF : 0;
+}
+
+/**
+ * Find or build the tile for (index, fg, bg, style)
+ * bg alpha != 0 builds an opaque cell (mono: 8 wide with the ink at its
+ * bearing, proportional: advance wide with the ink at 0). bg alpha 0 builds
+ * the ink box with the coverage in the alpha byte, for rect_blend.
+ */
+static const uint32_t *glyph_lookup(int index, uint32_t fg, uint32_t bg, int style) {
+    bg = (bg >> 24) ? (bg | 0xFF000000) : 0;
+    uint32_t hash = index * 31 + fg * 7 + bg + style * 131;
+    hash ^= (hash >> 8) ^ (hash >> 16);
+    glyph_tile_t *set = glyph_cache[hash & (BGA_GLYPH_SETS - 1)];
+    glyph_tile_t *victim = &set[0];
+
+    for (int way = 0; way < BGA_GLYPH_WAYS; way++) {
+        glyph_tile_t *tile = &set[way];
+        if (tile->stamp && tile->index == index && tile->fg == fg && tile->bg == bg && tile->style == style) {
+            tile->stamp = ++glyph_clock;
+            return tile->pixels;
+        }
+        if (tile->stamp < victim->stamp) victim = tile;
+    }
+
+    // Miss - expand the glyph into the least recently used way
+    const font_glyph_t *glyph = &font_glyphs[index];
+    if (bg) {
+        int cell_w = (style & FONT_STYLE_PROPORTIONAL) ? glyph->advance : FONT_CELL_WIDTH;
+        int ink_x = (style & FONT_STYLE_PROPORTIONAL) ? 0 : glyph->bearing;
+        for (int row = 0; row < GLYPH_H; row++) {
+            for (int col = 0; col < cell_w; col++) {
+                int ink = col - ink_x;
+                uint32_t a = (ink >= 0 && ink < glyph->width) ? glyph_coverage(index, row, ink, style) : 0;
+                victim->pixels[row * GLYPH_W + col] = blend_pixel((a << 24) | fg, bg & 0x00FFFFFF);
+            }
+        }
+    } else {
+        for (int row = 0; row < GLYPH_H; row++) {
+            for (int col = 0; col < glyph->width; col++) {
+                victim->pixels[row * GLYPH_W + col] = (glyph_coverage(index, row, col, style) << 24) | fg;
+            }
+        }
+    }
+    victim->index = index;
+    victim->style = style;
+    victim->fg = fg;
+    victim->bg = bg;
+    victim->stamp = ++glyph_clock;
+    return victim->pixels;
+}
 
 /* Port I/O functions */
 static inline void outw(uint16_t port, uint16_t val) {
@@ -230,6 +662,8 @@ int bga_is_available(void) {
 
 /**
  * Set video mode
+ * The virtual height is twice the visible height so two pages fit in
+ * VRAM for page flipping (the adapter clamps it if VRAM is too small)
  */
 void bga_set_video_mode(uint16_t width, uint16_t height, uint16_t bpp) {
     // Disable VBE extensions
@@ -240,6 +674,12 @@ void bga_set_video_mode(uint16_t width, uint16_t height, uint16_t bpp) {
     bga_write_register(VBE_DISPI_INDEX_YRES, height);
     bga_write_register(VBE_DISPI_INDEX_BPP, bpp);
     
+    // Two pages stacked vertically, showing the first
+    bga_write_register(VBE_DISPI_INDEX_VIRT_WIDTH, width);
+    bga_write_register(VBE_DISPI_INDEX_VIRT_HEIGHT, height * BGA_PAGE_COUNT);
+    bga_write_register(VBE_DISPI_INDEX_X_OFFSET, 0);
+    bga_write_register(VBE_DISPI_INDEX_Y_OFFSET, 0);
+    
     // Enable VBE extensions with linear framebuffer
     bga_write_register(VBE_DISPI_INDEX_ENABLE, VBE_DISPI_ENABLED | VBE_DISPI_LFB_ENABLED);
 }
@@ -319,24 +759,156 @@ int bga_init(uint16_t width, uint16_t height, uint16_t bpp) {
     screen_bpp = actual_bpp;
     
     // Get framebuffer address
-    framebuffer = (uint32_t *)bga_get_framebuffer_addr();
+    vram_base = (uint32_t *)bga_get_framebuffer_addr();
+    
+    // Page flipping needs the full virtual height (QEMU clamps it to VRAM)
+    uint16_t virt_height = bga_read_register(VBE_DISPI_INDEX_VIRT_HEIGHT);
+    flip_capable = (virt_height >= screen_height * BGA_PAGE_COUNT);
+    
+    // RAM shadow - reads and writes stay in cacheable memory (heap must be up)
+    extern void* kmalloc_aligned(uint32_t size, uint32_t alignment);
+    shadowbuffer = (uint32_t *)kmalloc_aligned(bga_get_framebuffer_size(), 4096);
+    
+    // Page 0 is visible; prefer the shadow, then flipping, then direct
+    front_page = 0;
+    frontbuffer = vram_base;
+    framebuffer = vram_base;
+    present_mode = BGA_PRESENT_DIRECT;
+    dirty_count = 0;
+    if (shadowbuffer) {
+        framebuffer = shadowbuffer;
+        present_mode = BGA_PRESENT_SHADOW;
+    } else if (flip_capable) {
+        framebuffer = vram_base + screen_width * screen_height;
+        present_mode = BGA_PRESENT_FLIP;
+    }
+    
+    // Row runs for transparent text
+    glyph_runs_init();
+    
+    // No clipping beyond the screen edges
+    clip_depth = 0;
+    clip_stack[0].x1 = 0;
+    clip_stack[0].y1 = 0;
+    clip_stack[0].x2 = screen_width;
+    clip_stack[0].y2 = screen_height;
+    
+    // Fastest span kernels the CPU has (cpu_init has enabled SSE)
+    bga_set_accel(BGA_ACCEL_SSE2);
     
     cursor_x = 0;
     cursor_y = 0;
+    console_init();
     
     return 1;  // Success
 }
 
+/**
+ * Select how drawing reaches the screen
+ * The current screen contents carry over to the new draw target.
+ * Returns 1 on success, 0 if the mode is not available.
+ */
+int bga_set_present_mode(int mode) {
+    if (mode == BGA_PRESENT_FLIP && !flip_capable) return 0;
+    if (mode == BGA_PRESENT_SHADOW && !shadowbuffer) return 0;
+    if (mode != BGA_PRESENT_DIRECT && mode != BGA_PRESENT_FLIP && mode != BGA_PRESENT_SHADOW) return 0;
+    
+    // Get anything pending onto the screen first, back on page 0
+    console_unpan();
+    bga_present();
+    
+    uint32_t *target = frontbuffer;
+    if (mode == BGA_PRESENT_FLIP) {
+        target = vram_base + (front_page ^ 1) * screen_width * screen_height;
+    } else if (mode == BGA_PRESENT_SHADOW) {
+        target = shadowbuffer;
+    }
+    
+    // Seed the new target with what is visible (background under the sprite)
+    if (target != frontbuffer) {
+        uint32_t pixels = screen_width * screen_height;
+        for (uint32_t i = 0; i < pixels; i++) {
+            target[i] = frontbuffer[i];
+        }
+        for (int row = 0; sprite_drawn && row < sprite_height; row++) {
+            int py = sprite_drawn_y + row;
+            if (py < 0 || py >= screen_height) continue;
+            for (int col = 0; col < sprite_width; col++) {
+                int px = sprite_drawn_x + col;
+                if (px < 0 || px >= screen_width) continue;
+                target[py * screen_width + px] = sprite_backup[row * BGA_CURSOR_MAX_W + col];
+            }
+        }
+    }
+    
+    framebuffer = target;
+    present_mode = mode;
+    dirty_count = 0;
+    scroll_y = (frontbuffer - vram_base) / screen_width;  // Page 1 if FLIP left it there
+    return 1;
+}
+
+/**
+ * Get the active present mode (BGA_PRESENT_*)
+ */
+int bga_get_present_mode(void) {
+    return present_mode;
+}
+
+/**
+ * Make everything drawn since the last present visible
+ * SHADOW: copies the merged dirty rectangles from RAM to the screen; the
+ *         draw target keeps its contents, so partial redraws are fine.
+ * FLIP:   moves the Y offset, then copies the dirty rectangles onto the
+ *         new back page so it holds this frame too - partial redraws
+ *         (libgui's damage) stay correct.
+ * DIRECT: nothing to do.
+ */
+void bga_present(void) {
+    if (present_mode == BGA_PRESENT_SHADOW) {
+        dirty_flush(frontbuffer, shadowbuffer);
+        return;
+    }
+    if (present_mode != BGA_PRESENT_FLIP) return;
+    
+    // Carry the cursor sprite over to the new front page
+    uint32_t flags = irq_save();
+    sprite_hide();
+    
+    front_page ^= 1;
+    bga_write_register(VBE_DISPI_INDEX_Y_OFFSET, front_page * screen_height);
+    
+    uint32_t *old_front = frontbuffer;
+    frontbuffer = framebuffer;
+    framebuffer = old_front;
+    
+    sprite_show();
+    irq_restore(flags);
+
+    // The new back page is the frame before last - bring it up to date
+    dirty_flush(framebuffer, frontbuffer);
+}
+
+/**
+ * Check whether drawing goes through bga_present()
+ */
+int bga_is_double_buffered(void) {
+    return present_mode != BGA_PRESENT_DIRECT;
+}
+
 /**
  * Clear screen
  */
 void bga_clear(uint32_t color) {
     if (!framebuffer) return;
     
-    uint32_t pixels = screen_width * screen_height;
-    for (uint32_t i = 0; i < pixels; i++) {
-        framebuffer[i] = color & 0x00FFFFFF;  // Strip alpha byte
-    }
+    console_unpan();
+    console_reset(color & 0x00FFFFFF);
+    
+    draw_begin(0, 0, screen_width, screen_height);
+    rect_fill(framebuffer, screen_width, screen_width, screen_height,
+              color & 0x00FFFFFF, framebuffer != shadowbuffer);  // Strip alpha byte
+    draw_end();
 }
 
 /**
@@ -344,57 +916,287 @@ void bga_clear(uint32_t color) {
  */
 void bga_putpixel(int x, int y, uint32_t color) {
     if (!framebuffer) return;
-    if (x < 0 || x >= screen_width || y < 0 || y >= screen_height) return;
+    const rect_t *clip = &clip_stack[clip_depth];
+    if (x < clip->x1 || x >= clip->x2 || y < clip->y1 || y >= clip->y2) return;
     
+    draw_begin(x, y, 1, 1);
     framebuffer[y * screen_width + x] = color & 0x00FFFFFF;  // Strip alpha byte
+    draw_end();
 }
 
 /**
- * Draw character
+ * Draw one glyph, returns the pen advance
  */
-static void bga_putchar(int x, int y, char c, uint32_t fg, uint32_t bg) {
-    uint8_t uc = (uint8_t)c;
-    if (uc >= 128) uc = 0;
+static int bga_draw_glyph(int x, int y, char c, uint32_t fg, uint32_t bg, int style) {
+    int index = font_glyph_index((uint8_t)c);
+    const font_glyph_t *glyph = &font_glyphs[index];
+    int prop = style & FONT_STYLE_PROPORTIONAL;
+    int advance = prop ? glyph->advance : FONT_CELL_WIDTH;
+    int opaque = (bg >> 24) != 0;
+    
+    // Opaque text covers the whole cell, transparent text only the ink
+    int ax = opaque ? x : x + (prop ? 0 : glyph->bearing);
+    int aw = opaque ? advance : glyph->width;
+    
+    // Visible part of the area
+    int cx = ax, cy = y, width = aw, height = GLYPH_H;
+    if (!clip_rect(&cx, &cy, &width, &height)) return advance;
+    int col0 = cx - ax;
+    int row0 = cy - y;
     
-    const uint8_t *glyph = font_8x16[uc];
+    fg &= 0x00FFFFFF;
+    draw_begin(cx, cy, width, height);
     
-    for (int row = 0; row < 16; row++) {
-        uint8_t line = glyph[row];
-        for (int col = 0; col < 8; col++) {
-            // Only draw foreground pixels if bit is set, skip background (transparent)
-            if (line & (0x80 >> col)) {
-                bga_putpixel(x + col, y + row, fg);
+    if (opaque) {
+        // Opaque background - whole rows from the cached tile
+        const uint32_t *tile = glyph_lookup(index, fg, bg, style);
+        rect_copy(framebuffer + cy * screen_width + cx, screen_width,
+                  tile + row0 * GLYPH_W + col0, GLYPH_W, width, height, 0);
+    } else if (style & FONT_STYLE_ANTIALIAS) {
+        // Transparent anti-aliased - blend the cached ink tile
+        const uint32_t *tile = glyph_lookup(index, fg, 0, style);
+        rect_blend(framebuffer + cy * screen_width + cx, screen_width,
+                   tile + row0 * GLYPH_W + col0, GLYPH_W, width, height);
+    } else {
+        // Transparent background - fill the set-bit runs of each row
+        const uint8_t *bits = &font_bitmap[index * FONT_HEIGHT];
+        int col1 = col0 + width;
+        for (int row = row0; row < row0 + height; row++) {
+            const glyph_runs_t *runs = &glyph_runs[bits[row]];
+            uint32_t *line = framebuffer + (y + row) * screen_width + ax;
+            for (int i = 0; i < runs->count; i++) {
+                int start = runs->start[i] < col0 ? col0 : runs->start[i];
+                int end = runs->start[i] + runs->len[i];
+                if (end > col1) end = col1;
+                for (int col = start; col < end; col++) {
+                    line[col] = fg;
+                }
             }
         }
     }
+    
+    draw_end();
+    return advance;
+}
+
+/**
+ * Text console (bga_print)
+ * Every character printed is also kept in a ring of screen rows, so a
+ * scroll only rotates the ring instead of moving text around. Pixels
+ * scroll by panning the Y offset through the virtual screen: the visible
+ * window slides down one line and only the newly exposed line is drawn.
+ * When the window reaches the end of the virtual height it jumps back to
+ * page 0. SHADOW mode moves the RAM copy up and flushes just the new line
+ * (the whole screen on the jump); DIRECT mode re-renders the ring onto
+ * page 0 while the window is on page 1, then jumps, instead of reading
+ * VRAM back. FLIP mode, or a screen without the virtual height, falls
+ * back to one bulk memmove.
+ */
+typedef struct {
+    char c;                     // 0 = empty cell
+    uint32_t fg, bg;
+} console_cell_t;
+
+static console_cell_t *console_cells = 0;   // console_rows x console_cols ring
+static int console_cols = 0;
+static int console_rows = 0;
+static int console_top = 0;                 // Ring row shown at the top
+static uint32_t console_bg = 0;             // Colour of the last bga_clear
+
+static console_cell_t *console_line(int row) {
+    return &console_cells[((console_top + row) % console_rows) * console_cols];
+}
+
+static void console_clear_line(console_cell_t *line) {
+    for (int col = 0; col < console_cols; col++) {
+        line[col].c = 0;
+    }
+}
+
+/**
+ * Record a character drawn at pixel (x, y)
+ */
+static void console_store(int x, int y, char c, uint32_t fg, uint32_t bg) {
+    int row = y / FONT_HEIGHT;
+    int col = x / FONT_CELL_WIDTH;
+    if (!console_cells || row < 0 || row >= console_rows || col < 0 || col >= console_cols) return;
+
+    console_cell_t *cell = &console_line(row)[col];
+    cell->c = c;
+    cell->fg = fg;
+    cell->bg = bg;
+}
+
+/**
+ * Draw the whole ring into the draw target
+ */
+static void console_redraw(void) {
+    draw_begin(0, 0, screen_width, screen_height);
+    rect_fill(framebuffer, screen_width, screen_width, screen_height, console_bg, framebuffer != shadowbuffer);
+    draw_end();
+
+    for (int row = 0; row < console_rows; row++) {
+        const console_cell_t *line = console_line(row);
+        for (int col = 0; col < console_cols; col++) {
+            if (line[col].c) {
+                bga_draw_glyph(col * FONT_CELL_WIDTH, row * FONT_HEIGHT, line[col].c,
+                               line[col].fg, line[col].bg, FONT_STYLE_MONO);
+            }
+        }
+    }
+}
+
+/**
+ * Show the virtual screen from scanline y, carrying the cursor sprite
+ */
+static void console_pan(int y) {
+    uint32_t flags = irq_save();
+    sprite_hide();
+
+    scroll_y = y;
+    front_page = 0;
+    frontbuffer = vram_base + y * screen_width;
+    if (present_mode == BGA_PRESENT_DIRECT) {
+        framebuffer = frontbuffer;
+    }
+    bga_write_register(VBE_DISPI_INDEX_Y_OFFSET, y);
+
+    sprite_show();
+    irq_restore(flags);
+}
+
+/**
+ * Move a panned screen back to page 0 (before a mode change or clear)
+ */
+static void console_unpan(void) {
+    if (scroll_y == 0 || present_mode == BGA_PRESENT_FLIP) return;
+
+    if (present_mode == BGA_PRESENT_SHADOW) {
+        console_pan(0);
+        dirty_add(0, 0, screen_width, screen_height);
+        return;
+    }
+
+    // DIRECT - copy the window down (pages overlap, so copy forwards)
+    uint32_t flags = irq_save();
+    sprite_hide();
+    rect_copy(vram_base, screen_width, frontbuffer, screen_width, screen_width, screen_height, 0);
+    irq_restore(flags);
+    console_pan(0);
+}
+
+/**
+ * Scroll the console up one text line
+ */
+static void console_scroll(void) {
+    int line = FONT_HEIGHT;
+    int keep = screen_height - line;
+    int can_pan = flip_capable && scroll_y + line + screen_height <= screen_height * BGA_PAGE_COUNT;
+
+    // DIRECT only wraps once the window sits entirely on page 1, which
+    // whole-line steps reach only if the height is a multiple of a line
+    if (present_mode == BGA_PRESENT_DIRECT && screen_height % line) can_pan = 0;
+
+    // The old top row becomes the new, empty bottom row
+    if (console_cells) {
+        console_top = (console_top + 1) % console_rows;
+        console_clear_line(console_line(console_rows - 1));
+    }
+
+    if (present_mode == BGA_PRESENT_SHADOW) {
+        dirty_flush(frontbuffer, shadowbuffer);  // Pending rectangles are in pre-scroll coordinates
+        rect_copy(shadowbuffer, screen_width, shadowbuffer + line * screen_width, screen_width,
+                  screen_width, keep, 0);
+        rect_fill(shadowbuffer + keep * screen_width, screen_width, screen_width, line, console_bg, 0);
+        if (can_pan) {
+            // VRAM already holds everything but the new line
+            console_pan(scroll_y + line);
+            dirty_add(0, keep, screen_width, line);
+        } else {
+            console_pan(0);
+            dirty_add(0, 0, screen_width, screen_height);
+        }
+    } else if (present_mode == BGA_PRESENT_DIRECT && can_pan) {
+        // Blank the line below the window while it is still off screen
+        rect_fill(vram_base + (scroll_y + screen_height) * screen_width, screen_width,
+                  screen_width, line, console_bg, 1);
+        console_pan(scroll_y + line);
+    } else if (present_mode == BGA_PRESENT_DIRECT && console_cells && scroll_y >= screen_height) {
+        // Out of virtual height - page 0 is off screen, so render the text
+        // there and jump; the sprite stays on the front page until the pan
+        framebuffer = vram_base;
+        console_redraw();
+        console_pan(0);
+    } else {
+        // Bulk memmove of the draw target
+        draw_begin(0, 0, screen_width, screen_height);
+        rect_copy(framebuffer, screen_width, framebuffer + line * screen_width, screen_width,
+                  screen_width, keep, 0);
+        rect_fill(framebuffer + keep * screen_width, screen_width, screen_width, line,
+                  console_bg, framebuffer != shadowbuffer);
+        draw_end();
+    }
+}
+
+/**
+ * Allocate the text ring (heap must be up)
+ */
+static void console_init(void) {
+    extern void* kmalloc(uint32_t size);
+    console_cols = screen_width / FONT_CELL_WIDTH;
+    console_rows = screen_height / FONT_HEIGHT;
+    console_top = 0;
+    console_bg = 0;
+    scroll_y = 0;
+    console_cells = (console_cell_t *)kmalloc(console_cols * console_rows * sizeof(console_cell_t));
+    for (int row = 0; console_cells && row < console_rows; row++) {
+        console_clear_line(console_line(row));
+    }
+}
+
+/**
+ * Forget the text after the screen was cleared to color
+ */
+static void console_reset(uint32_t color) {
+    console_top = 0;
+    console_bg = color;
+    for (int row = 0; console_cells && row < console_rows; row++) {
+        console_clear_line(console_line(row));
+    }
+}
+
+/**
+ * Move the console cursor to the start of the next line, scrolling at the bottom
+ */
+static void console_newline(void) {
+    cursor_x = 0;
+    cursor_y += FONT_HEIGHT;
+    if (cursor_y + FONT_HEIGHT > screen_height) {
+        cursor_y -= FONT_HEIGHT;
+        console_scroll();
+    }
 }
 
 /**
  * Print string at current cursor position
+ * bg with alpha 0 draws transparent text, any other alpha an opaque cell.
+ * Scrolls instead of wrapping to the top when the screen is full.
  */
 void bga_print(const char *str, uint32_t fg, uint32_t bg) {
     if (!framebuffer) return;
     
     while (*str) {
         if (*str == '\n') {
-            cursor_x = 0;
-            cursor_y += 16;
-            if (cursor_y >= screen_height) {
-                cursor_y = 0;  // Wrap to top (simple for now)
-            }
+            console_newline();
             str++;
             continue;
         }
         
-        bga_putchar(cursor_x, cursor_y, *str, fg, bg);
-        cursor_x += 8;
+        console_store(cursor_x, cursor_y, *str, fg, bg);
+        cursor_x += bga_draw_glyph(cursor_x, cursor_y, *str, fg, bg, FONT_STYLE_MONO);
         
-        if (cursor_x + 8 > screen_width) {
-            cursor_x = 0;
-            cursor_y += 16;
-            if (cursor_y >= screen_height) {
-                cursor_y = 0;
-            }
+        if (cursor_x + FONT_CELL_WIDTH > screen_width) {
+            console_newline();
         }
         
         str++;
@@ -402,10 +1204,11 @@ void bga_print(const char *str, uint32_t fg, uint32_t bg) {
 }
 
 /**
- * Print string at specific position (doesn't update cursor)
+ * Draw a string with FONT_STYLE_* flags (doesn't update cursor)
+ * Lines wrap back to x. Returns the pen x after the last character.
  */
-void bga_print_at(int x, int y, const char *str, uint32_t fg, uint32_t bg) {
-    if (!framebuffer) return;
+int bga_draw_text(int x, int y, const char *str, uint32_t fg, uint32_t bg, int style) {
+    if (!framebuffer) return x;
     
     int pos_x = x;
     int pos_y = y;
@@ -413,21 +1216,30 @@ void bga_print_at(int x, int y, const char *str, uint32_t fg, uint32_t bg) {
     while (*str) {
         if (*str == '\n') {
             pos_x = x;
-            pos_y += 16;
+            pos_y += FONT_HEIGHT;
             str++;
             continue;
         }
         
-        bga_putchar(pos_x, pos_y, *str, fg, bg);
-        pos_x += 8;
+        pos_x += bga_draw_glyph(pos_x, pos_y, *str, fg, bg, style);
         
-        if (pos_x + 8 > screen_width) {
+        if (pos_x + FONT_CELL_WIDTH > screen_width) {
             pos_x = x;
-            pos_y += 16;
+            pos_y += FONT_HEIGHT;
         }
         
         str++;
     }
+    
+    return pos_x;
+}
+
+/**
+ * Print string at specific position (doesn't update cursor)
+ * Same colour rules as bga_print
+ */
+void bga_print_at(int x, int y, const char *str, uint32_t fg, uint32_t bg) {
+    bga_draw_text(x, y, str, fg, bg, FONT_STYLE_MONO);
 }
 
 /**
@@ -452,72 +1264,131 @@ void bga_get_cursor(int *x, int *y) {
 void bga_fill_rect(int x, int y, int width, int height, uint32_t color) {
     if (!framebuffer) return;
     
-    // Strip alpha byte if present
-    uint32_t rgb_color = color & 0x00FFFFFF;
+    // Clip once, then fill whole spans
+    if (!clip_rect(&x, &y, &width, &height)) return;
     
-    for (int row = y; row < y + height && row < screen_height; row++) {
-        for (int col = x; col < x + width && col < screen_width; col++) {
-            if (row >= 0 && col >= 0) {
-                framebuffer[row * screen_width + col] = rgb_color;
-            }
-        }
-    }
+    draw_begin(x, y, width, height);
+    rect_fill(framebuffer + y * screen_width + x, screen_width, width, height,
+              color & 0x00FFFFFF, framebuffer != shadowbuffer);  // Strip alpha byte
+    draw_end();
+}
+
+/**
+ * Draw a horizontal line of length pixels starting at (x, y)
+ */
+void bga_draw_hline(int x, int y, int length, uint32_t color) {
+    bga_fill_rect(x, y, length, 1, color);
+}
+
+/**
+ * Draw a vertical line of length pixels starting at (x, y)
+ */
+void bga_draw_vline(int x, int y, int length, uint32_t color) {
+    bga_fill_rect(x, y, 1, length, color);
 }
 
 /**
  * Draw a rectangle outline
+ * Four clipped spans; the corners belong to the horizontal edges
  */
 void bga_draw_rect(int x, int y, int width, int height, uint32_t color) {
-    if (!framebuffer) return;
+    if (!framebuffer || width <= 0 || height <= 0) return;
     
-    // Top and bottom lines
-    for (int col = x; col < x + width && col < screen_width; col++) {
-        if (col >= 0) {
-            if (y >= 0 && y < screen_height) bga_putpixel(col, y, color);
-            if (y + height - 1 >= 0 && y + height - 1 < screen_height) 
-                bga_putpixel(col, y + height - 1, color);
-        }
+    bga_draw_hline(x, y, width, color);
+    if (height > 1) {
+        bga_draw_hline(x, y + height - 1, width, color);
     }
-    
-    // Left and right lines
-    for (int row = y; row < y + height && row < screen_height; row++) {
-        if (row >= 0) {
-            if (x >= 0 && x < screen_width) bga_putpixel(x, row, color);
-            if (x + width - 1 >= 0 && x + width - 1 < screen_width) 
-                bga_putpixel(x + width - 1, row, color);
+    if (height > 2) {
+        bga_draw_vline(x, y + 1, height - 2, color);
+        if (width > 1) {
+            bga_draw_vline(x + width - 1, y + 1, height - 2, color);
         }
     }
 }
 
+/**
+ * Copy a block of RGB pixels to the screen
+ * src_stride is in pixels and may be negative (bottom-up images)
+ */
+void bga_blit(int x, int y, int width, int height, const uint32_t *src, int src_stride) {
+    if (!framebuffer || !src) return;
+    
+    int cx = x, cy = y;
+    if (!clip_rect(&cx, &cy, &width, &height)) return;
+    src += (cy - y) * src_stride + (cx - x);
+    
+    draw_begin(cx, cy, width, height);
+    rect_copy(framebuffer + cy * screen_width + cx, screen_width, src, src_stride,
+              width, height, framebuffer != shadowbuffer);
+    draw_end();
+}
+
+/**
+ * Alpha-blend a block of ARGB pixels onto the screen
+ * Alpha 0 leaves the screen untouched, 255 replaces it
+ */
+void bga_blend_blit(int x, int y, int width, int height, const uint32_t *src, int src_stride) {
+    if (!framebuffer || !src) return;
+    
+    int cx = x, cy = y;
+    if (!clip_rect(&cx, &cy, &width, &height)) return;
+    src += (cy - y) * src_stride + (cx - x);
+    
+    draw_begin(cx, cy, width, height);
+    rect_blend(framebuffer + cy * screen_width + cx, screen_width, src, src_stride, width, height);
+    draw_end();
+}
+
+/**
+ * Blend a block of premultiplied ARGB pixels onto the screen
+ * For preconverted sprites: colour channels are already scaled by alpha
+ */
+void bga_blend_blit_premul(int x, int y, int width, int height, const uint32_t *src, int src_stride) {
+    if (!framebuffer || !src) return;
+    
+    int cx = x, cy = y;
+    if (!clip_rect(&cx, &cy, &width, &height)) return;
+    src += (cy - y) * src_stride + (cx - x);
+    
+    draw_begin(cx, cy, width, height);
+    rect_blend_premul(framebuffer + cy * screen_width + cx, screen_width, src, src_stride, width, height);
+    draw_end();
+}
+
+/**
+ * Select the span kernels (BGA_ACCEL_*)
+ * Falls back to the best level the CPU supports; returns the level used
+ */
+int bga_set_accel(int level) {
+    if (level >= BGA_ACCEL_SSE2 && !cpu_has_sse2()) level = BGA_ACCEL_REP;
+    if (level > BGA_ACCEL_SSE2) level = BGA_ACCEL_SSE2;
+    if (level < BGA_ACCEL_SCALAR) level = BGA_ACCEL_SCALAR;
+    accel_level = level;
+    return level;
+}
+
+/**
+ * Get the active span kernel level
+ */
+int bga_get_accel(void) {
+    return accel_level;
+}
+
 /**
  * Draw BMP image from memory
  * Supports 32-bit BMP files only
  */
 void bga_draw_bmp(int x, int y, const uint8_t *bmp_data) {
-    if (!framebuffer || !bmp_data) {
-        serial_print("[BMP] NULL pointer\n");
-        return;
-    }
-    
-    // Debug: Print first few bytes
-    serial_print("[BMP] Data at 0x");
-    serial_hex((uint32_t)bmp_data);
-    serial_print(" bytes: 0x");
-    serial_hex(bmp_data[0]);
-    serial_print(" 0x");
-    serial_hex(bmp_data[1]);
-    serial_print("\n");
+    if (!framebuffer || !bmp_data) return;
     
     // Verify BMP signature (should be 'BM')
     if (bmp_data[0] != 0x42 || bmp_data[1] != 0x4D) {
         // Invalid BMP - just draw a red square to show error
-        serial_print("[BMP] Invalid signature!\n");
+        klog(KLOG_WARN, "BMP", "Invalid signature!");
         bga_fill_rect(x, y, 32, 32, 0xFF0000);
         return;
     }
     
-    serial_print("[BMP] Valid signature, drawing...\n");
-    
     // Parse BMP header to get dimensions
     // Offset 18: width (4 bytes, little-endian)
     // Offset 22: height (4 bytes, little-endian)
@@ -532,26 +1403,9 @@ void bga_draw_bmp(int x, int y, const uint8_t *bmp_data) {
     }
     
     // Pixel data starts at offset 54 for our 32-bit BMPs
-    const uint8_t *pixel_data = bmp_data + 54;
-    
-    // BMP stores pixels bottom-to-top, so we need to flip vertically
-    for (uint32_t row = 0; row < height; row++) {
-        for (uint32_t col = 0; col < width; col++) {
-            // Calculate index in BMP data (bottom-to-top)
-            uint32_t bmp_row = height - 1 - row;
-            uint32_t pixel_index = (bmp_row * width + col) * 4;
-            
-            uint8_t b = pixel_data[pixel_index + 0];
-            uint8_t g = pixel_data[pixel_index + 1];
-            uint8_t r = pixel_data[pixel_index + 2];
-            uint8_t a = pixel_data[pixel_index + 3];
-            
-            // Skip transparent pixels (alpha == 0)
-            if (a == 0) continue;
-            
-            // Draw pixel as RGB (strip alpha)
-            uint32_t color = (r << 16) | (g << 8) | b;
-            bga_putpixel(x + col, y + row, color);
-        }
-    }
+    // BGRA bytes are ARGB pixels in memory, so rows blend directly
+    const uint32_t *pixel_data = (const uint32_t *)(bmp_data + 54);
+    
+    // BMP stores pixels bottom-to-top: walk source rows backwards
+    bga_blend_blit(x, y, width, height, pixel_data + (height - 1) * width, -(int)width);
 }
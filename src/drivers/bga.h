@@ -46,6 +46,33 @@
 #define VBE_DISPI_BPP_24                0x18
 #define VBE_DISPI_BPP_32                0x20
 
+/* Pages in the virtual framebuffer (front + back for page flipping) */
+#define BGA_PAGE_COUNT                  2
+
+/* Present modes - how primitives reach the screen */
+#define BGA_PRESENT_DIRECT              0   // Draw straight to the visible page
+#define BGA_PRESENT_FLIP                1   // Draw to back page, flip Y offset
+#define BGA_PRESENT_SHADOW              2   // Draw to RAM, copy dirty rects
+
+/* Dirty rectangles tracked in SHADOW mode before collapsing to one */
+#define BGA_DIRTY_MAX                   32
+
+/* Span kernel levels for fills and blits */
+#define BGA_ACCEL_SCALAR                0   // Plain C loops
+#define BGA_ACCEL_REP                   1   // rep stosl / rep movsl
+#define BGA_ACCEL_SSE2                  2   // Non-temporal stores + SSE2 blend
+
+/* Nested clip rectangles (bga_clip_push) */
+#define BGA_CLIP_DEPTH                  16
+
+/* Glyph tile cache - sets x ways of glyph cells (sets must be a power of 2) */
+#define BGA_GLYPH_SETS                  32
+#define BGA_GLYPH_WAYS                  4
+
+/* Kernel cursor sprite limits */
+#define BGA_CURSOR_MAX_W                32
+#define BGA_CURSOR_MAX_H                32
+
 /* PCI IDs for BGA device */
 #define BGA_PCI_VENDOR_ID               0x1234
 #define BGA_PCI_DEVICE_ID               0x1111
@@ -59,16 +86,41 @@ uint32_t bga_get_framebuffer_size(void);
 uint16_t bga_get_width(void);
 uint16_t bga_get_height(void);
 
+/* Buffering - primitives draw to the back page or RAM shadow */
+void bga_present(void);
+int bga_is_double_buffered(void);
+int bga_set_present_mode(int mode);
+int bga_get_present_mode(void);
+int bga_set_accel(int level);
+int bga_get_accel(void);
+
 /* Drawing primitives */
 void bga_clear(uint32_t color);
 void bga_putpixel(int x, int y, uint32_t color);
 void bga_fill_rect(int x, int y, int width, int height, uint32_t color);
 void bga_draw_rect(int x, int y, int width, int height, uint32_t color);
+void bga_draw_hline(int x, int y, int length, uint32_t color);
+void bga_draw_vline(int x, int y, int length, uint32_t color);
 void bga_draw_bmp(int x, int y, const uint8_t *bmp_data);
+void bga_blit(int x, int y, int width, int height, const uint32_t *src, int src_stride);
+void bga_blend_blit(int x, int y, int width, int height, const uint32_t *src, int src_stride);
+void bga_blend_blit_premul(int x, int y, int width, int height, const uint32_t *src, int src_stride);
+uint32_t bga_get_pixel(int x, int y);
+
+/* Clip stack - every primitive except bga_clear draws inside the top entry */
+int bga_clip_push(int x, int y, int width, int height);
+int bga_clip_pop(void);
+void bga_clip_reset(void);
+
+/* Cursor sprite - composited by the kernel, moved from the mouse IRQ */
+int bga_cursor_set_image(const uint32_t *argb, int width, int height, int hot_x, int hot_y);
+void bga_cursor_move(int x, int y);
 
-/* Text output - kernel manages cursor position */
+/* Text output - kernel manages cursor position
+ * bg alpha 0 = transparent background, otherwise the cell is filled */
 void bga_print(const char *str, uint32_t fg, uint32_t bg);
 void bga_print_at(int x, int y, const char *str, uint32_t fg, uint32_t bg);
+int bga_draw_text(int x, int y, const char *str, uint32_t fg, uint32_t bg, int style);
 void bga_set_cursor(int x, int y);
 void bga_get_cursor(int *x, int *y);
 
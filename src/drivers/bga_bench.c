@@ -0,0 +1,135 @@
+/**
+ * BGA fill/blit benchmark
+ * Times bga_clear, bga_fill_rect, bga_blit and bga_blend_blit at every
+ * span kernel level, drawing to the RAM shadow and straight to VRAM,
+ * and prints a Mpixels/s table to the kernel log. When performance
+ * counters are available each row is followed by instructions per pixel
+ * and LLC/branch misses per 1000 pixels (kpx).
+ * Built in with -DBGA_BENCHMARK (BGA_BENCH=1 ./build.sh).
+ */
+
+#include "bga.h"
+#include "../managers/cpu/cpu.h"
+#include "../managers/log/klog.h"
+#include "../managers/pmc/pmc.h"
+#include <stdint.h>
+
+#define BENCH_BLIT_W    256
+#define BENCH_BLIT_H    256
+#define BENCH_FILL_W    400
+#define BENCH_FILL_H    300
+#define BENCH_REPEAT    8
+
+enum { OP_CLEAR, OP_FILL, OP_BLIT, OP_BLEND, OP_COUNT };
+
+/* Source image: opaque gradient for blit, alpha ramp for blend */
+static uint32_t *bench_src = 0;
+
+/**
+ * Run one operation BENCH_REPEAT times inside region; returns Mpixels/s
+ * x10 and the pixels drawn
+ */
+static uint32_t bench_run(int op, uint32_t khz, pmc_region_t *region, uint32_t *drawn) {
+    uint32_t pixels = 0;
+    pmc_region_start(region);
+
+    for (int i = 0; i < BENCH_REPEAT; i++) {
+        switch (op) {
+            case OP_CLEAR:
+                bga_clear(0x102030 + i);
+                pixels += bga_get_width() * bga_get_height();
+                break;
+            case OP_FILL:
+                bga_fill_rect(100 + i, 100, BENCH_FILL_W, BENCH_FILL_H, 0x405060);
+                pixels += BENCH_FILL_W * BENCH_FILL_H;
+                break;
+            case OP_BLIT:
+                bga_blit(200 + i, 200, BENCH_BLIT_W, BENCH_BLIT_H, bench_src, BENCH_BLIT_W);
+                pixels += BENCH_BLIT_W * BENCH_BLIT_H;
+                break;
+            case OP_BLEND:
+                bga_blend_blit(200 + i, 200, BENCH_BLIT_W, BENCH_BLIT_H, bench_src, BENCH_BLIT_W);
+                pixels += BENCH_BLIT_W * BENCH_BLIT_H;
+                break;
+        }
+    }
+    bga_present();
+    pmc_region_stop(region);
+    *drawn = pixels;
+
+    uint32_t us = pmc_region_per(region, PMC_EVENTS, khz / 1000, 1);
+    if (us == 0) us = 1;
+    return pixels * 10 / us;
+}
+
+/**
+ * One counter row under a Mpixels/s row: event count per pixel x scale,
+ * printed with one fractional digit
+ */
+static void bench_print_counter(const char *label, int event, uint32_t scale,
+                                pmc_region_t *regions, const uint32_t *pixels) {
+    if (!(regions[0].events & (1u << event))) return;
+
+    uint32_t v[OP_COUNT];
+    for (int op = 0; op < OP_COUNT; op++) v[op] = pmc_region_per(&regions[op], event, pixels[op], scale * 10);
+    klog(KLOG_INFO, "BENCH", "           %-13s %6u.%u %6u.%u %6u.%u %6u.%u", label,
+         v[OP_CLEAR] / 10, v[OP_CLEAR] % 10, v[OP_FILL] / 10, v[OP_FILL] % 10,
+         v[OP_BLIT] / 10, v[OP_BLIT] % 10, v[OP_BLEND] / 10, v[OP_BLEND] % 10);
+}
+
+/**
+ * Print the benchmark table, then restore the boot settings
+ */
+void bga_benchmark(void) {
+    static const char *accel_names[] = { "scalar", "rep   ", "sse2  " };
+    static const int modes[] = { BGA_PRESENT_SHADOW, BGA_PRESENT_DIRECT };
+    static const char *mode_names[] = { "ram ", "vram" };
+
+    uint32_t khz = cpu_tsc_khz();
+    if (khz == 0) khz = cpu_calibrate_tsc();
+    if (khz < 1000) {
+        klog(KLOG_WARN, "BENCH", "No usable TSC - skipped");
+        return;
+    }
+
+    extern void* kmalloc(uint32_t size);
+    bench_src = (uint32_t *)kmalloc(BENCH_BLIT_W * BENCH_BLIT_H * 4);
+    if (!bench_src) return;
+    for (int y = 0; y < BENCH_BLIT_H; y++) {
+        for (int x = 0; x < BENCH_BLIT_W; x++) {
+            bench_src[y * BENCH_BLIT_W + x] = ((uint32_t)x << 24) | (x << 16) | (y << 8) | 0x80;
+        }
+    }
+
+    int boot_mode = bga_get_present_mode();
+    int boot_accel = bga_get_accel();
+
+    pmc_info_t pmc;
+    pmc_get_info(&pmc);
+
+    klog(KLOG_INFO, "BENCH", "Mpixels/s  target accel     clear     fill     blit    blend");
+    for (int m = 0; m < 2; m++) {
+        if (!bga_set_present_mode(modes[m])) continue;
+        for (int level = BGA_ACCEL_SCALAR; level <= BGA_ACCEL_SSE2; level++) {
+            if (bga_set_accel(level) != level) continue;  // CPU lacks it
+
+            // Mpixels/s x10, printed with one fractional digit
+            uint32_t r[OP_COUNT], pixels[OP_COUNT];
+            pmc_region_t regions[OP_COUNT];
+            for (int op = 0; op < OP_COUNT; op++) {
+                pmc_region_init(&regions[op], &pmc);
+                r[op] = bench_run(op, khz, &regions[op], &pixels[op]);
+            }
+            klog(KLOG_INFO, "BENCH", "           %s   %s %6u.%u %6u.%u %6u.%u %6u.%u",
+                 mode_names[m], accel_names[level],
+                 r[OP_CLEAR] / 10, r[OP_CLEAR] % 10, r[OP_FILL] / 10, r[OP_FILL] % 10,
+                 r[OP_BLIT] / 10, r[OP_BLIT] % 10, r[OP_BLEND] / 10, r[OP_BLEND] % 10);
+            bench_print_counter("instr/px", PMC_EVENT_INSTRUCTIONS, 1, regions, pixels);
+            bench_print_counter("llc miss/kpx", PMC_EVENT_LLC_MISSES, 1000, regions, pixels);
+            bench_print_counter("br miss/kpx", PMC_EVENT_BRANCH_MISSES, 1000, regions, pixels);
+        }
+    }
+
+    bga_set_accel(boot_accel);
+    bga_set_present_mode(boot_mode);
+}
@@ -0,0 +1,265 @@
+/*
+ * BGA span kernels
+ * 32-bit pixel fill/copy/blend loops used by bga.c. All take cdecl args:
+ *   fill:  (uint32_t *dst, uint32_t value, uint32_t count)
+ *   copy:  (uint32_t *dst, const uint32_t *src, uint32_t count)
+ *   blend: (uint32_t *dst, const uint32_t *src, uint32_t count)
+ *   blend_pm: same, src alpha premultiplied
+ * The SSE2 versions must be bracketed by kernel_fpu_begin/end.
+ */
+.section .text
+.globl bga_fill32_rep
+.globl bga_copy32_rep
+.globl bga_fill32_nt
+.globl bga_copy32_nt
+.globl bga_blend32_sse2
+.globl bga_blend32_pm_sse2
+
+/* rep stosl fill */
+.align 16
+bga_fill32_rep:
+    push %edi
+    mov 8(%esp), %edi           /* dst */
+    mov 12(%esp), %eax          /* value */
+    mov 16(%esp), %ecx          /* count */
+    cld
+    rep stosl
+    pop %edi
+    ret
+
+/* rep movsl copy */
+.align 16
+bga_copy32_rep:
+    push %edi
+    push %esi
+    mov 12(%esp), %edi          /* dst */
+    mov 16(%esp), %esi          /* src */
+    mov 20(%esp), %ecx          /* count */
+    cld
+    rep movsl
+    pop %esi
+    pop %edi
+    ret
+
+/* SSE2 fill with non-temporal stores (bypasses the cache - for VRAM) */
+.align 16
+bga_fill32_nt:
+    push %edi
+    mov 8(%esp), %edi           /* dst */
+    mov 12(%esp), %eax          /* value */
+    mov 16(%esp), %ecx          /* count */
+    cld
+
+    /* Scalar stores until dst is 16-byte aligned */
+1:  test %ecx, %ecx
+    jz 4f
+    test $15, %edi
+    jz 2f
+    stosl
+    dec %ecx
+    jmp 1b
+
+    /* 16 pixels per iteration */
+2:  movd %eax, %xmm0
+    pshufd $0, %xmm0, %xmm0
+    mov %ecx, %edx
+    shr $4, %edx
+    jz 3f
+5:  movntdq %xmm0, (%edi)
+    movntdq %xmm0, 16(%edi)
+    movntdq %xmm0, 32(%edi)
+    movntdq %xmm0, 48(%edi)
+    add $64, %edi
+    dec %edx
+    jnz 5b
+
+    /* Remaining 0-15 pixels */
+3:  and $15, %ecx
+    rep stosl
+    sfence
+4:  pop %edi
+    ret
+
+/* SSE2 copy with non-temporal stores (RAM shadow -> VRAM) */
+.align 16
+bga_copy32_nt:
+    push %edi
+    push %esi
+    mov 12(%esp), %edi          /* dst */
+    mov 16(%esp), %esi          /* src */
+    mov 20(%esp), %ecx          /* count */
+    cld
+
+    /* Scalar copies until dst is 16-byte aligned */
+1:  test %ecx, %ecx
+    jz 4f
+    test $15, %edi
+    jz 2f
+    movsl
+    dec %ecx
+    jmp 1b
+
+    /* 16 pixels per iteration, src may be unaligned */
+2:  mov %ecx, %edx
+    shr $4, %edx
+    jz 3f
+5:  movdqu (%esi), %xmm0
+    movdqu 16(%esi), %xmm1
+    movdqu 32(%esi), %xmm2
+    movdqu 48(%esi), %xmm3
+    movntdq %xmm0, (%edi)
+    movntdq %xmm1, 16(%edi)
+    movntdq %xmm2, 32(%edi)
+    movntdq %xmm3, 48(%edi)
+    add $64, %esi
+    add $64, %edi
+    dec %edx
+    jnz 5b
+
+    /* Remaining 0-15 pixels */
+3:  and $15, %ecx
+    rep movsl
+    sfence
+4:  pop %esi
+    pop %edi
+    ret
+
+/*
+ * SSE2 alpha blend of ARGB src over RGB dst, 4 pixels per iteration
+ *   out = (src * a + dst * (255 - a)) / 255, alpha byte cleared
+ * Handles count & ~3 pixels; the caller blends the 0-3 left over.
+ */
+.align 16
+bga_blend32_sse2:
+    push %edi
+    push %esi
+    mov 12(%esp), %edi          /* dst */
+    mov 16(%esp), %esi          /* src */
+    mov 20(%esp), %ecx          /* count */
+    shr $2, %ecx
+    jz 2f
+
+    pxor %xmm7, %xmm7           /* 0 for byte -> word unpacking */
+    pcmpeqw %xmm6, %xmm6
+    psrlw $8, %xmm6             /* 0x00FF words */
+    pcmpeqw %xmm5, %xmm5
+    psrlw $15, %xmm5
+    psllw $7, %xmm5             /* 0x0080 words (rounding) */
+
+1:  movdqu (%esi), %xmm0        /* 4 src pixels */
+    movdqu (%edi), %xmm1        /* 4 dst pixels */
+
+    /* Low two pixels */
+    movdqa %xmm0, %xmm2
+    punpcklbw %xmm7, %xmm2      /* src lo as words */
+    movdqa %xmm1, %xmm3
+    punpcklbw %xmm7, %xmm3      /* dst lo as words */
+    pshuflw $0xFF, %xmm2, %xmm4
+    pshufhw $0xFF, %xmm4, %xmm4 /* alpha in every word of each pixel */
+    pmullw %xmm4, %xmm2         /* src * a */
+    pxor %xmm6, %xmm4           /* 255 - a */
+    pmullw %xmm4, %xmm3         /* dst * (255 - a) */
+    paddw %xmm3, %xmm2
+    paddw %xmm5, %xmm2          /* t = x + 128 */
+    movdqa %xmm2, %xmm3
+    psrlw $8, %xmm3
+    paddw %xmm3, %xmm2
+    psrlw $8, %xmm2             /* (t + (t >> 8)) >> 8 == x / 255 rounded */
+
+    /* High two pixels */
+    punpckhbw %xmm7, %xmm0
+    punpckhbw %xmm7, %xmm1
+    pshuflw $0xFF, %xmm0, %xmm4
+    pshufhw $0xFF, %xmm4, %xmm4
+    pmullw %xmm4, %xmm0
+    pxor %xmm6, %xmm4
+    pmullw %xmm4, %xmm1
+    paddw %xmm1, %xmm0
+    paddw %xmm5, %xmm0
+    movdqa %xmm0, %xmm1
+    psrlw $8, %xmm1
+    paddw %xmm1, %xmm0
+    psrlw $8, %xmm0
+
+    packuswb %xmm0, %xmm2       /* back to 4 pixels */
+    pslld $8, %xmm2
+    psrld $8, %xmm2             /* clear alpha byte */
+    movdqu %xmm2, (%edi)
+
+    add $16, %esi
+    add $16, %edi
+    dec %ecx
+    jnz 1b
+
+2:  pop %esi
+    pop %edi
+    ret
+
+/*
+ * SSE2 blend of premultiplied ARGB src over RGB dst, 4 pixels per iteration
+ *   out = src + dst * (255 - a) / 255 (saturating), alpha byte cleared
+ * Handles count & ~3 pixels; the caller blends the 0-3 left over.
+ */
+.align 16
+bga_blend32_pm_sse2:
+    push %edi
+    push %esi
+    mov 12(%esp), %edi          /* dst */
+    mov 16(%esp), %esi          /* src */
+    mov 20(%esp), %ecx          /* count */
+    shr $2, %ecx
+    jz 2f
+
+    pxor %xmm7, %xmm7           /* 0 for byte -> word unpacking */
+    pcmpeqw %xmm6, %xmm6
+    psrlw $8, %xmm6             /* 0x00FF words */
+    pcmpeqw %xmm5, %xmm5
+    psrlw $15, %xmm5
+    psllw $7, %xmm5             /* 0x0080 words (rounding) */
+
+1:  movdqu (%esi), %xmm0        /* 4 src pixels */
+    movdqu (%edi), %xmm1        /* 4 dst pixels */
+
+    /* Low two pixels: dst * (255 - a) / 255 */
+    movdqa %xmm0, %xmm2
+    punpcklbw %xmm7, %xmm2
+    pshuflw $0xFF, %xmm2, %xmm4
+    pshufhw $0xFF, %xmm4, %xmm4 /* alpha in every word of each pixel */
+    pxor %xmm6, %xmm4           /* 255 - a */
+    movdqa %xmm1, %xmm3
+    punpcklbw %xmm7, %xmm3
+    pmullw %xmm4, %xmm3
+    paddw %xmm5, %xmm3          /* t = x + 128 */
+    movdqa %xmm3, %xmm2
+    psrlw $8, %xmm2
+    paddw %xmm2, %xmm3
+    psrlw $8, %xmm3             /* (t + (t >> 8)) >> 8 == x / 255 rounded */
+
+    /* High two pixels */
+    movdqa %xmm0, %xmm2
+    punpckhbw %xmm7, %xmm2
+    pshuflw $0xFF, %xmm2, %xmm4
+    pshufhw $0xFF, %xmm4, %xmm4
+    pxor %xmm6, %xmm4
+    punpckhbw %xmm7, %xmm1
+    pmullw %xmm4, %xmm1
+    paddw %xmm5, %xmm1
+    movdqa %xmm1, %xmm2
+    psrlw $8, %xmm2
+    paddw %xmm2, %xmm1
+    psrlw $8, %xmm1
+
+    packuswb %xmm1, %xmm3       /* back to 4 pixels */
+    paddusb %xmm0, %xmm3        /* + premultiplied src */
+    pslld $8, %xmm3
+    psrld $8, %xmm3             /* clear alpha byte */
+    movdqu %xmm3, (%edi)
+
+    add $16, %esi
+    add $16, %edi
+    dec %ecx
+    jnz 1b
+
+2:  pop %esi
+    pop %edi
+    ret
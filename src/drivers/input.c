@@ -0,0 +1,259 @@
+/**
+ * MaahiOS Input Event Queue
+ * A single-producer/single-consumer ring of input_event_t: IRQ handlers
+ * produce, SYSCALL_GET_EVENTS consumes. The indices run freely and are
+ * only masked on access, so head - tail is always the fill level. Keys
+ * come from IRQ1 and the repeat timer, pointer reports from softirqs
+ * that run with interrupts on; every report masks interrupts while it
+ * updates the ring, so together they are still a single producer.
+ * The producer writes a slot and then publishes it with a release store
+ * of head; the consumer loads head with acquire before reading slots and
+ * releases tail once it has copied them out.
+ *
+ * Pointer motion is coalesced: a move merges into the newest queued event
+ * while that event is still an unread move (wheel clicks likewise), so a slow reader gets one
+ * event with the summed delta rather than a backlog. Merging rewrites a
+ * published slot, which is safe because the consumer never overlaps the
+ * producer: syscalls run with interrupts on, so input_wait_events does an
+ * explicit cli before every input_read_events.
+ * When the ring is full, motion is carried and folded into the next event
+ * that fits; button and key events that do not fit are dropped and
+ * counted, and every later event still reports the true button and
+ * modifier state.
+ */
+
+#include "input.h"
+#include "../managers/timer/timer.h"
+#include "../managers/process/process_manager.h"
+#include "../managers/cpu/cpu.h"
+#include <stdint.h>
+
+extern unsigned int pit_get_ticks(void);
+
+static input_event_t queue[INPUT_QUEUE_SIZE];
+static uint32_t queue_head = 0;     // Next slot to write (producer owns)
+static uint32_t queue_tail = 0;     // Next slot to read (consumer owns)
+static input_stats_t stats;
+static uint8_t last_buttons = 0;
+static uint16_t last_modifiers = 0;
+static int16_t last_x = 0, last_y = 0;
+
+/* Motion that arrived while the ring was full */
+static int carry_dx = 0, carry_dy = 0;
+
+/**
+ * Producer: free slot to fill, or NULL when full
+ * The slot becomes visible to the reader only at queue_publish()
+ */
+static input_event_t *queue_reserve(void) {
+    uint32_t tail = __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE);
+    if (queue_head - tail >= INPUT_QUEUE_SIZE) return 0;
+    return &queue[queue_head & (INPUT_QUEUE_SIZE - 1)];
+}
+
+static void queue_publish(void) {
+    __atomic_store_n(&queue_head, queue_head + 1, __ATOMIC_RELEASE);
+    stats.queued++;
+}
+
+/**
+ * Producer: newest published event if the reader has not taken it yet
+ */
+static input_event_t *queue_newest_unread(void) {
+    if (queue_head == __atomic_load_n(&queue_tail, __ATOMIC_ACQUIRE)) return 0;
+    return &queue[(queue_head - 1) & (INPUT_QUEUE_SIZE - 1)];
+}
+
+/**
+ * Pointer update from a driver: position after the move, the move
+ * itself and the button state reported with it
+ */
+void input_report_pointer(int x, int y, int dx, int dy, uint8_t buttons) {
+    uint32_t now = pit_get_ticks();
+    uint32_t flags = irq_save();
+
+    last_x = x;
+    last_y = y;
+    dx += carry_dx;
+    dy += carry_dy;
+    carry_dx = carry_dy = 0;
+
+    if (dx || dy) {
+        input_event_t *newest = queue_newest_unread();
+        input_event_t *event;
+        if (newest && newest->type == INPUT_EVENT_MOTION) {
+            // Coalesce with the unread move
+            newest->time_ms = now;
+            newest->x = x;
+            newest->y = y;
+            newest->dx += dx;
+            newest->dy += dy;
+            stats.coalesced++;
+        } else if ((event = queue_reserve())) {
+            event->time_ms = now;
+            event->type = INPUT_EVENT_MOTION;
+            event->buttons = last_buttons;
+            event->x = x;
+            event->y = y;
+            event->dx = dx;
+            event->dy = dy;
+            event->code = 0;
+            event->modifiers = last_modifiers;
+            event->ascii = 0;
+            queue_publish();
+        } else {
+            // Full - keep the movement for the next event that fits
+            carry_dx = dx;
+            carry_dy = dy;
+            stats.coalesced++;
+        }
+    }
+
+    // One event per button that changed, at the new position
+    uint8_t changed = buttons ^ last_buttons;
+    for (uint8_t bit = 1; changed; bit <<= 1) {
+        if (!(changed & bit)) continue;
+        changed &= ~bit;
+        last_buttons ^= bit;
+
+        input_event_t *event = queue_reserve();
+        if (!event) {
+            stats.dropped++;
+            continue;
+        }
+        event->time_ms = now;
+        event->type = (buttons & bit) ? INPUT_EVENT_BUTTON_DOWN : INPUT_EVENT_BUTTON_UP;
+        event->buttons = last_buttons;
+        event->x = x;
+        event->y = y;
+        event->dx = 0;
+        event->dy = 0;
+        event->code = bit;
+        event->modifiers = last_modifiers;
+        event->ascii = 0;
+        queue_publish();
+    }
+    irq_restore(flags);
+}
+
+/**
+ * Wheel clicks from the mouse, reported after the packet's motion
+ */
+void input_report_wheel(int dz) {
+    uint32_t flags = irq_save();
+    input_event_t *newest = queue_newest_unread();
+    if (newest && newest->type == INPUT_EVENT_WHEEL) {
+        newest->time_ms = pit_get_ticks();
+        newest->dy += dz;
+        stats.coalesced++;
+        irq_restore(flags);
+        return;
+    }
+
+    input_event_t *event = queue_reserve();
+    if (!event) {
+        stats.dropped++;
+        irq_restore(flags);
+        return;
+    }
+    event->time_ms = pit_get_ticks();
+    event->type = INPUT_EVENT_WHEEL;
+    event->buttons = last_buttons;
+    event->x = last_x;
+    event->y = last_y;
+    event->dx = 0;
+    event->dy = dz;
+    event->code = 0;
+    event->modifiers = last_modifiers;
+    event->ascii = 0;
+    queue_publish();
+    irq_restore(flags);
+}
+
+/**
+ * Key change from the keyboard driver (IRQ1, or IRQ0 for repeats)
+ * Key events carry the pointer position and buttons like any other
+ */
+void input_report_key(int type, uint32_t keycode, uint16_t ascii, uint16_t modifiers) {
+    uint32_t flags = irq_save();
+    last_modifiers = modifiers;
+
+    input_event_t *event = queue_reserve();
+    if (!event) {
+        stats.dropped++;
+        irq_restore(flags);
+        return;
+    }
+    event->time_ms = pit_get_ticks();
+    event->type = type;
+    event->buttons = last_buttons;
+    event->x = last_x;
+    event->y = last_y;
+    event->dx = 0;
+    event->dy = 0;
+    event->code = keycode;
+    event->modifiers = modifiers;
+    event->ascii = ascii;
+    queue_publish();
+    irq_restore(flags);
+}
+
+/**
+ * Consumer: copy up to max queued events to buf (interrupts must be off,
+ * see the coalescing note above). Returns the number copied
+ */
+int input_read_events(input_event_t *buf, int max) {
+    uint32_t head = __atomic_load_n(&queue_head, __ATOMIC_ACQUIRE);
+    uint32_t tail = queue_tail;
+    int count = 0;
+
+    while (count < max && tail != head) {
+        buf[count++] = queue[tail & (INPUT_QUEUE_SIZE - 1)];
+        tail++;
+    }
+    __atomic_store_n(&queue_tail, tail, __ATOMIC_RELEASE);
+    return count;
+}
+
+/**
+ * Wait up to timeout_ms for events, then return a batch of them
+ * Sleeps with hlt between interrupts; a timer wakes the CPU at the
+ * timeout, since nothing ticks while the system is idle. If IRQ12 stalls
+ * (seen in QEMU) the 8042 is polled on each wakeup instead.
+ */
+int input_wait_events(input_event_t *buf, int max, uint32_t timeout_ms) {
+    extern int mouse_poll(void);
+    static ktimer_t wake_timer;     // Single consumer - one waiter at a time
+    uint32_t start = pit_get_ticks();
+    int count = 0;
+
+    if (!buf || max <= 0) return 0;
+
+    if (timeout_ms != INPUT_NO_WAIT && timeout_ms != INPUT_WAIT_FOREVER) {
+        // A waiter that never came back (switched away) may have left it queued
+        timer_del(&wake_timer);
+        timer_setup(&wake_timer, 0, 0);
+        timer_add_ns(&wake_timer, (uint64_t)timeout_ms * 1000000);
+    }
+
+    while (1) {
+        __asm__ volatile("cli" ::: "memory");
+        count = input_read_events(buf, max);
+        if (count > 0 || timeout_ms == INPUT_NO_WAIT) break;
+        if (timeout_ms != INPUT_WAIT_FOREVER && pit_get_ticks() - start >= timeout_ms) break;
+
+        if (!mouse_poll()) {
+            // Atomically enable interrupts and sleep until the next one
+            int mode = process_account_mode(PROCESS_MODE_IDLE);
+            __asm__ volatile("sti; hlt" ::: "memory");
+            process_account_mode(mode);
+        }
+    }
+
+    timer_del(&wake_timer);
+    return count;
+}
+
+void input_get_stats(input_stats_t *out) {
+    *out = stats;
+}
@@ -0,0 +1,55 @@
+/**
+ * MaahiOS Input Event Queue
+ * The mouse and keyboard drivers report input from their IRQ handlers; user programs collect
+ * batches of events with SYSCALL_GET_EVENTS. The event layout below is
+ * shared with Ring 3.
+ */
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include <stdint.h>
+
+/* Event types */
+#define INPUT_EVENT_MOTION          1   // Pointer moved (consecutive moves coalesce)
+#define INPUT_EVENT_BUTTON_DOWN     2   // code = button bit pressed
+#define INPUT_EVENT_BUTTON_UP       3   // code = button bit released
+#define INPUT_EVENT_KEY_DOWN        4   // code = KEY_* keycode pressed
+#define INPUT_EVENT_KEY_UP          5   // code = KEY_* keycode released
+#define INPUT_EVENT_KEY_REPEAT      6   // code = held key, generated by the kernel
+#define INPUT_EVENT_WHEEL           7   // dy = wheel clicks, positive = towards the user
+
+/* SYSCALL_GET_EVENTS timeouts (otherwise milliseconds) */
+#define INPUT_NO_WAIT               0
+#define INPUT_WAIT_FOREVER          0xFFFFFFFF
+
+/* Queued events (power of 2) */
+#define INPUT_QUEUE_SIZE            256
+
+typedef struct {
+    uint32_t time_ms;       // Milliseconds since boot (last coalesced move)
+    uint16_t type;          // INPUT_EVENT_*
+    uint16_t buttons;       // Button state after the event (MOUSE_*_BUTTON bits)
+    int16_t x, y;           // Pointer position after the event
+    int16_t dx, dy;         // MOTION: summed movement, WHEEL: summed clicks, otherwise 0
+    uint32_t code;          // BUTTON_*: the button that changed, KEY_*: keycode
+    uint16_t modifiers;     // KEY_MOD_* state after the event
+    uint16_t ascii;         // KEY_DOWN/REPEAT: character for the key, or 0
+} input_event_t;
+
+/* Queue accounting since boot */
+typedef struct {
+    uint32_t queued;        // Events published to the ring
+    uint32_t coalesced;     // Moves merged into an unread move or carried
+    uint32_t dropped;       // Button/key events lost to a full ring
+} input_stats_t;
+
+/* Kernel side */
+void input_report_pointer(int x, int y, int dx, int dy, uint8_t buttons);
+void input_report_wheel(int dz);
+void input_report_key(int type, uint32_t keycode, uint16_t ascii, uint16_t modifiers);
+int input_read_events(input_event_t *buf, int max);
+int input_wait_events(input_event_t *buf, int max, uint32_t timeout_ms);
+void input_get_stats(input_stats_t *out);
+
+#endif // INPUT_H
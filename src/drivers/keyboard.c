@@ -0,0 +1,201 @@
+/**
+ * MaahiOS PS/2 Keyboard Driver
+ * Decodes IRQ1 scancodes into KEY_DOWN/KEY_UP events on the shared input
+ * queue. The 8042 normally translates to scancode set 1; if translation
+ * is off the raw set 2 codes are mapped to set 1 here, so keycodes are the
+ * same either way. Typematic repeats from the keyboard are swallowed and
+ * the kernel generates KEY_REPEAT from a timer at a fixed delay and rate.
+ */
+
+#include "keyboard.h"
+#include "input.h"
+#include "mouse.h"
+#include "../managers/timer/timer.h"
+#include "../managers/cpu/cpu.h"
+#include <stdint.h>
+
+#define PS2_DATA    0x60
+#define PS2_STATUS  0x64
+#define PS2_CMD     0x64
+
+#define STATUS_OBF  0x01
+#define STATUS_AUX  0x20
+
+#define CMD_TRANSLATE   0x40    // Command byte bit 6: 8042 translates to set 1
+
+// Port I/O helpers
+static inline uint8_t inb(uint16_t p) {
+    uint8_t r;
+    __asm__ volatile("inb %1, %0":"=a"(r):"Nd"(p));
+    return r;
+}
+
+static inline void outb(uint16_t p, uint8_t v) {
+    __asm__ volatile("outb %0,%1"::"a"(v),"Nd"(p));
+}
+
+/* Set 2 -> set 1 (the 8042 translation table, codes 0x00-0x83) */
+static const uint8_t set2_to_set1[0x84] = {
+    0xFF, 0x43, 0x41, 0x3F, 0x3D, 0x3B, 0x3C, 0x58, 0x64, 0x44, 0x42, 0x40, 0x3E, 0x0F, 0x29, 0x59,
+    0x65, 0x38, 0x2A, 0x70, 0x1D, 0x10, 0x02, 0x5A, 0x66, 0x71, 0x2C, 0x1F, 0x1E, 0x11, 0x03, 0x5B,
+    0x67, 0x2E, 0x2D, 0x20, 0x12, 0x05, 0x04, 0x5C, 0x68, 0x39, 0x2F, 0x21, 0x14, 0x13, 0x06, 0x5D,
+    0x69, 0x31, 0x30, 0x23, 0x22, 0x15, 0x07, 0x5E, 0x6A, 0x72, 0x32, 0x24, 0x16, 0x08, 0x09, 0x5F,
+    0x6B, 0x33, 0x25, 0x17, 0x18, 0x0B, 0x0A, 0x60, 0x6C, 0x34, 0x35, 0x26, 0x27, 0x19, 0x0C, 0x61,
+    0x6D, 0x73, 0x28, 0x74, 0x1A, 0x0D, 0x62, 0x6E, 0x3A, 0x36, 0x1C, 0x1B, 0x75, 0x2B, 0x63, 0x76,
+    0x55, 0x56, 0x77, 0x78, 0x79, 0x7A, 0x0E, 0x7B, 0x7C, 0x4F, 0x7D, 0x4B, 0x47, 0x7E, 0x7F, 0x6F,
+    0x52, 0x53, 0x50, 0x4C, 0x4D, 0x48, 0x01, 0x45, 0x57, 0x4E, 0x51, 0x4A, 0x37, 0x49, 0x46, 0x54,
+    0x80, 0x81, 0x82, 0x41,
+};
+
+/* US layout, set 1 codes 0x00-0x39 */
+static const char keymap[0x3A] =
+    "\0\033" "1234567890-=\b\t" "qwertyuiop[]\n\0" "asdfghjkl;'`\0\\" "zxcvbnm,./\0*\0 ";
+static const char keymap_shift[0x3A] =
+    "\0\033" "!@#$%^&*()_+\b\t" "QWERTYUIOP{}\n\0" "ASDFGHJKL:\"~\0|" "ZXCVBNM<>?\0*\0 ";
+
+// Decoder state
+static int raw_set2 = 0;            // 8042 translation off - decode set 2
+static int prefix_e0 = 0;           // Next code is an extended key
+static int prefix_f0 = 0;           // Next code is a release (set 2)
+static int skip_bytes = 0;          // Rest of a Pause sequence
+static uint16_t modifiers = 0;
+
+// Key repeat state
+static uint32_t held_key = 0;       // Key being repeated, 0 = none
+static uint16_t held_ascii = 0;
+static ktimer_t repeat_timer;       // Next KEY_REPEAT
+
+static uint16_t key_ascii(uint32_t key) {
+    if (key == KEY_KP_ENTER) return '\n';
+    if (key == (0x80 | 0x35)) return '/';   // Keypad slash
+    if (key >= sizeof(keymap)) return 0;
+
+    char c = (modifiers & KEY_MOD_SHIFT) ? keymap_shift[key] : keymap[key];
+    int letter = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    if (letter && (modifiers & KEY_MOD_CAPSLOCK)) c ^= 0x20;
+    if (letter && (modifiers & KEY_MOD_CTRL)) c &= 0x1F;
+    return (uint8_t)c;
+}
+
+static uint16_t key_modifier(uint32_t key) {
+    switch (key) {
+        case KEY_LSHIFT:
+        case KEY_RSHIFT:    return KEY_MOD_SHIFT;
+        case KEY_LCTRL:
+        case KEY_RCTRL:     return KEY_MOD_CTRL;
+        case KEY_LALT:
+        case KEY_RALT:      return KEY_MOD_ALT;
+    }
+    return 0;
+}
+
+/**
+ * A decoded set 1 key change
+ */
+static void key_event(uint32_t key, int released) {
+    uint16_t mod = key_modifier(key);
+
+    if (released) {
+        if (mod) modifiers &= ~mod;
+        if (key == held_key) {
+            held_key = 0;
+            timer_del(&repeat_timer);
+        }
+        input_report_key(INPUT_EVENT_KEY_UP, key, 0, modifiers);
+        return;
+    }
+
+    // Typematic make code for the key we already repeat ourselves
+    if (key == held_key) return;
+
+    if (mod) modifiers |= mod;
+    if (key == KEY_CAPSLOCK) modifiers ^= KEY_MOD_CAPSLOCK;
+
+    uint16_t ascii = key_ascii(key);
+    input_report_key(INPUT_EVENT_KEY_DOWN, key, ascii, modifiers);
+
+    if (!mod && key != KEY_CAPSLOCK) {
+        held_key = key;
+        held_ascii = ascii;
+        timer_add_ns(&repeat_timer, KEY_REPEAT_DELAY * 1000000ULL);
+    }
+}
+
+void keyboard_process_byte(uint8_t b) {
+    if (skip_bytes) {
+        skip_bytes--;
+        return;
+    }
+
+    if (raw_set2) {
+        switch (b) {
+            case 0xE0: prefix_e0 = 1; return;
+            case 0xF0: prefix_f0 = 1; return;
+            case 0xE1: skip_bytes = 7; return;              // Pause: E1 14 77 E1 F0 14 F0 77
+            case 0x00: case 0xAA: case 0xEE:
+            case 0xFA: case 0xFE: case 0xFF: return;        // Errors, BAT, echo, ACK, resend
+        }
+        int released = prefix_f0;
+        prefix_f0 = 0;
+        if (b >= sizeof(set2_to_set1)) {
+            prefix_e0 = 0;
+            return;
+        }
+        b = set2_to_set1[b] | (released ? 0x80 : 0);
+    } else {
+        switch (b) {
+            case 0xE0: prefix_e0 = 1; return;
+            case 0xE1: skip_bytes = 5; return;              // Pause: E1 1D 45 E1 9D C5
+            case 0x00: case 0xEE: case 0xFA:
+            case 0xFE: case 0xFF: return;
+        }
+    }
+
+    int extended = prefix_e0;
+    prefix_e0 = 0;
+
+    uint32_t key = b & 0x7F;
+    if (extended) {
+        // E0 2A / E0 36 are fake shifts around some extended keys
+        if (key == KEY_LSHIFT || key == KEY_RSHIFT) return;
+        key |= 0x80;
+    }
+    key_event(key, b & 0x80);
+}
+
+/**
+ * IRQ1 Handler
+ * Mouse bytes are left in the 8042 for IRQ12
+ */
+void keyboard_handler(void *ctx) {
+    (void)ctx;
+    uint8_t status = inb(PS2_STATUS);
+    if ((status & (STATUS_OBF | STATUS_AUX)) != STATUS_OBF)
+        return;
+    keyboard_process_byte(inb(PS2_DATA));
+}
+
+/**
+ * Repeat timer - re-armed from its own deadline so the rate does not drift
+ */
+static void keyboard_repeat(ktimer_t *timer) {
+    if (!held_key) return;
+    input_report_key(INPUT_EVENT_KEY_REPEAT, held_key, held_ascii, modifiers);
+    timer_add(timer, timer->expires + KEY_REPEAT_INTERVAL * 1000000ULL);
+}
+
+void keyboard_init(void) {
+    prefix_e0 = prefix_f0 = skip_bytes = 0;
+    modifiers = 0;
+    held_key = 0;
+    timer_setup(&repeat_timer, keyboard_repeat, 0);
+
+    // Read the command byte to see whether the 8042 translates; IRQ12
+    // is already live and must not take the reply
+    uint32_t flags = irq_save();
+    ps2_wait_input_clear();
+    outb(PS2_CMD, 0x20);
+    ps2_wait_output_full();
+    raw_set2 = !(inb(PS2_DATA) & CMD_TRANSLATE);
+    irq_restore(flags);
+}
@@ -0,0 +1,64 @@
+#ifndef KEYBOARD_H
+#define KEYBOARD_H
+
+#include <stdint.h>
+
+/*
+ * Keycodes are scancode set 1 make codes; E0-prefixed keys get bit 7
+ * set (KEY_UP = E0 48 -> 0xC8). Raw set 2 input is translated first.
+ */
+#define KEY_ESC             0x01
+#define KEY_BACKSPACE       0x0E
+#define KEY_TAB             0x0F
+#define KEY_ENTER           0x1C
+#define KEY_LCTRL           0x1D
+#define KEY_LSHIFT          0x2A
+#define KEY_RSHIFT          0x36
+#define KEY_LALT            0x38
+#define KEY_SPACE           0x39
+#define KEY_CAPSLOCK        0x3A
+#define KEY_F1              0x3B
+#define KEY_F10             0x44
+#define KEY_F11             0x57
+#define KEY_F12             0x58
+#define KEY_KP_ENTER        0x9C
+#define KEY_RCTRL           0x9D
+#define KEY_RALT            0xB8
+#define KEY_HOME            0xC7
+#define KEY_UP              0xC8
+#define KEY_PAGEUP          0xC9
+#define KEY_LEFT            0xCB
+#define KEY_RIGHT           0xCD
+#define KEY_END             0xCF
+#define KEY_DOWN            0xD0
+#define KEY_PAGEDOWN        0xD1
+#define KEY_INSERT          0xD2
+#define KEY_DELETE          0xD3
+
+// Modifier state (input_event_t.modifiers)
+#define KEY_MOD_SHIFT       0x01
+#define KEY_MOD_CTRL        0x02
+#define KEY_MOD_ALT         0x04
+#define KEY_MOD_CAPSLOCK    0x08
+
+// Kernel key repeat (milliseconds)
+#define KEY_REPEAT_DELAY    500
+#define KEY_REPEAT_INTERVAL 33
+
+/**
+ * Initialize the keyboard driver (call before enabling IRQ1)
+ * Detects whether the 8042 translates to set 1 or passes set 2 through
+ */
+void keyboard_init(void);
+
+/**
+ * Keyboard IRQ handler (registered on IRQ1)
+ */
+void keyboard_handler(void *ctx);
+
+/**
+ * Feed one byte read from the 8042 (for handlers that read a key byte)
+ */
+void keyboard_process_byte(uint8_t b);
+
+#endif // KEYBOARD_H
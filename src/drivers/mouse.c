@@ -4,6 +4,11 @@
  */
 
 #include "mouse.h"
+#include "bga.h"
+#include "input.h"
+#include "keyboard.h"
+#include "../managers/irq/softirq.h"
+#include "../managers/cpu/cpu.h"
 #include <stdint.h>
 
 #define PS2_DATA    0x60
@@ -15,25 +20,41 @@
 #define STATUS_IBF  0x02
 #define STATUS_AUX  0x20  // mouse data in output buffer
 
-// Ring buffer for packets
-#define MOUSE_BUF_SIZE 128
-
-typedef struct {
-    int8_t dx, dy;
-    uint8_t buttons;
-} mouse_packet_t;
-
-static mouse_packet_t ring[MOUSE_BUF_SIZE];
-static volatile int head = 0;
-static volatile int tail = 0;
-
-// Partial packet assembly
-static uint8_t pkt[3];
+// Partial packet assembly (3 bytes, 4 with a wheel)
+static uint8_t pkt[4];
 static uint8_t pkt_i = 0;
+static uint8_t pkt_size = 3;
+static uint8_t device_id = 0;               // 0 = standard, 3 = wheel, 4 = wheel + 5 buttons
+static uint8_t sample_rate = 100;
 
 volatile int mouse_x = 320;
 volatile int mouse_y = 240;
 volatile int irq_total = 0;
+static volatile int sync_errors = 0;        // Bytes discarded to regain packet sync
+
+// Pointer bounds - the active BGA mode (set at init or by mouse_set_bounds)
+static int bound_w = 1024;
+static int bound_h = 768;
+
+// Acceleration curve (see mouse_set_accel) and sub-pixel remainders
+static mouse_accel_t accel = { MOUSE_ACCEL_DEFAULT_SENSITIVITY, MOUSE_ACCEL_DEFAULT_THRESHOLD,
+                               MOUSE_ACCEL_DEFAULT_FACTOR };
+static int frac_x = 0, frac_y = 0;
+static volatile uint8_t mouse_buttons = 0;  // State from the latest packet
+
+// Decoded packets waiting for the bottom half (IRQ12 produces, softirq consumes)
+#define MOUSE_PENDING_SIZE 16
+typedef struct {
+    int16_t dx, dy;
+    int8_t dz;
+    uint8_t buttons;
+} mouse_packet_t;
+
+static mouse_packet_t pending[MOUSE_PENDING_SIZE];
+static uint32_t pending_head = 0;
+static uint32_t pending_tail = 0;
+static void mouse_packet_work(void *ctx);
+static softirq_work_t packet_work = SOFTIRQ_WORK_INIT(mouse_packet_work, 0);
 
 // Port I/O helpers
 static inline uint8_t inb(uint16_t p) {
@@ -46,7 +67,7 @@ static inline void outb(uint16_t p, uint8_t v) {
     __asm__ volatile("outb %0,%1"::"a"(v),"Nd"(p));
 }
 
-static int wait_input_clear() {
+int ps2_wait_input_clear(void) {
     for (int i = 0; i < 50000; i++) {
         if (!(inb(PS2_STATUS) & STATUS_IBF))
             return 1;
@@ -54,7 +75,7 @@ static int wait_input_clear() {
     return 0;
 }
 
-static int wait_output_full() {
+int ps2_wait_output_full(void) {
     for (int i = 0; i < 50000; i++) {
         if (inb(PS2_STATUS) & STATUS_OBF)
             return 1;
@@ -72,39 +93,83 @@ static void flush_output() {
 
 // Mouse command helpers
 static uint8_t read_cmd_byte() {
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_CMD, 0x20);
-    wait_output_full();
+    ps2_wait_output_full();
     return inb(PS2_DATA);
 }
 
 static void write_cmd_byte(uint8_t b) {
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_CMD, 0x60);
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_DATA, b);
 }
 
-static uint8_t mouse_write(uint8_t b) {
-    wait_input_clear();
+/**
+ * Send a byte to the mouse and wait for its ACK
+ * Packet bytes still in flight are skipped; returns 1 on ACK
+ */
+static int mouse_write(uint8_t b) {
+    ps2_wait_input_clear();
     outb(PS2_CMD, 0xD4);
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_DATA, b);
-    wait_output_full();
+    for (int i = 0; i < 4; i++) {
+        if (!ps2_wait_output_full()) return 0;
+        uint8_t r = inb(PS2_DATA);
+        if (r == 0xFA) return 1;
+        if (r == 0xFE || r == 0xFC) return 0;
+    }
+    return 0;
+}
+
+static int mouse_set_rate(uint8_t rate) {
+    return mouse_write(0xF3) && mouse_write(rate);
+}
+
+static uint8_t mouse_get_id(void) {
+    if (!mouse_write(0xF2) || !ps2_wait_output_full()) return 0;
     return inb(PS2_DATA);
 }
 
+/**
+ * IntelliMouse detection - the magic sample rate sequences
+ * 200,100,80 turns on the wheel (ID 3); then 200,200,80 the 4th and
+ * 5th buttons (ID 4). Either way packets grow to 4 bytes.
+ */
+static void mouse_detect_extensions(void) {
+    mouse_set_rate(200);
+    mouse_set_rate(100);
+    mouse_set_rate(80);
+    device_id = mouse_get_id();
+
+    if (device_id == 3) {
+        mouse_set_rate(200);
+        mouse_set_rate(200);
+        mouse_set_rate(80);
+        device_id = mouse_get_id();
+    }
+
+    pkt_size = (device_id == 3 || device_id == 4) ? 4 : 3;
+}
+
 /**
  * Initialize PS/2 mouse (CORRECTED - proper command byte, no delays in wrong places)
  */
 int mouse_init() {
+    // The replies below must not be taken by IRQ12
+    uint32_t flags = irq_save();
+
     pkt_i = 0;
-    head = tail = 0;
+    mouse_buttons = 0;
     irq_total = 0;
+    sync_errors = 0;
+    mouse_set_bounds(bga_get_width(), bga_get_height());
 
     // Disable PS/2 ports
-    wait_input_clear(); outb(PS2_CMD, 0xAD);
-    wait_input_clear(); outb(PS2_CMD, 0xA7);
+    ps2_wait_input_clear(); outb(PS2_CMD, 0xAD);
+    ps2_wait_input_clear(); outb(PS2_CMD, 0xA7);
 
     flush_output();
 
@@ -118,41 +183,116 @@ int mouse_init() {
     write_cmd_byte(cb);
 
     // Enable mouse port
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_CMD, 0xA8);
 
     // Enable keyboard port
-    wait_input_clear();
+    ps2_wait_input_clear();
     outb(PS2_CMD, 0xAE);
 
     flush_output();
 
+    // Wheel/5-button mode, then a higher sample rate for lower latency
+    mouse_detect_extensions();
+    if (mouse_set_rate(MOUSE_SAMPLE_RATE))
+        sample_rate = MOUSE_SAMPLE_RATE;
+
     // Enable data reporting
-    uint8_t ack = mouse_write(0xF4);
-    // ACK check removed from ISR - can check outside if needed
+    mouse_write(0xF4);
 
     flush_output();
+    pkt_i = 0;
 
+    irq_restore(flags);
     return 1;
 }
 
-// Add packet to ring buffer
-static void push_packet(int8_t dx, int8_t dy, uint8_t btn) {
-    mouse_packet_t p;
-    p.dx = dx;
-    p.dy = dy;
-    p.buttons = btn;
+/**
+ * Apply the acceleration curve to one packet's movement
+ * Gain is sensitivity up to threshold counts per packet; above it the
+ * excess is multiplied by factor. Fractions carry to the next packet so
+ * slow movement is not lost.
+ */
+static void accelerate(int *dx, int *dy) {
+    int speed = (*dx < 0 ? -*dx : *dx) + (*dy < 0 ? -*dy : *dy);
+    if (speed == 0) return;
+
+    // Gain in 1/256 units. The curve is reduced to a per-count multiplier
+    // before scaling by sensitivity so the product stays within 32 bits
+    // for every setting mouse_set_accel accepts (no 64-bit divide here)
+    int gain = accel.sensitivity;
+    if (speed > accel.threshold) {
+        int curve = (accel.threshold * 256 + (speed - accel.threshold) * accel.factor) / speed;
+        gain = gain * curve / 256;
+    }
 
-    ring[head] = p;
-    head = (head + 1) % MOUSE_BUF_SIZE;
+    int x = *dx * gain + frac_x;
+    int y = *dy * gain + frac_y;
+    *dx = x / 256;
+    *dy = y / 256;
+    frac_x = x - *dx * 256;
+    frac_y = y - *dy * 256;
+}
+
+// Apply a complete packet and queue it as input events
+static void push_packet(int dx, int dy, int dz, uint8_t btn) {
+    accelerate(&dx, &dy);
 
-    // Update cursor position (2x sensitivity for responsiveness)
-    mouse_x += dx * 2;
-    mouse_y += dy * 2;
+    // Update cursor position
+    mouse_x += dx;
+    mouse_y += dy;
     if (mouse_x < 0) mouse_x = 0;
     if (mouse_y < 0) mouse_y = 0;
-    if (mouse_x > 1023) mouse_x = 1023;
-    if (mouse_y > 767)  mouse_y = 767;
+    if (mouse_x > bound_w - 1) mouse_x = bound_w - 1;
+    if (mouse_y > bound_h - 1) mouse_y = bound_h - 1;
+
+    // Composite the kernel cursor sprite at the new position
+    bga_cursor_move(mouse_x, mouse_y);
+
+    mouse_buttons = btn;
+    input_report_pointer(mouse_x, mouse_y, dx, dy, btn);
+    if (dz)
+        input_report_wheel(dz);
+}
+
+/**
+ * Pointer reports from other devices (the USB HID driver)
+ * Both feed the same position, cursor sprite and input events as PS/2
+ */
+void mouse_report_relative(int dx, int dy, int dz, uint8_t buttons) {
+    push_packet(dx, dy, dz, buttons);
+}
+
+/**
+ * Bottom half: apply the queued packets with interrupts enabled
+ */
+static void mouse_packet_work(void *ctx) {
+    (void)ctx;
+    uint32_t head = __atomic_load_n(&pending_head, __ATOMIC_ACQUIRE);
+    while (pending_tail != head) {
+        mouse_packet_t *p = &pending[pending_tail & (MOUSE_PENDING_SIZE - 1)];
+        push_packet(p->dx, p->dy, p->dz, p->buttons);
+        __atomic_store_n(&pending_tail, pending_tail + 1, __ATOMIC_RELEASE);
+    }
+}
+
+void mouse_report_absolute(int x, int y, int dz, uint8_t buttons) {
+    if (x < 0) x = 0;
+    if (y < 0) y = 0;
+    if (x > bound_w - 1) x = bound_w - 1;
+    if (y > bound_h - 1) y = bound_h - 1;
+
+    int dx = x - mouse_x;
+    int dy = y - mouse_y;
+    mouse_x = x;
+    mouse_y = y;
+    if (dx || dy)
+        bga_cursor_move(mouse_x, mouse_y);
+
+    mouse_buttons = buttons;
+    input_report_pointer(mouse_x, mouse_y, dx, dy, buttons);
+    if (dz)
+        input_report_wheel(dz);
 }
 
 /**
@@ -162,8 +302,10 @@ static void push_packet(int8_t dx, int8_t dy, uint8_t btn) {
  * 2. Check AUX bit BEFORE reading data (was mixing keyboard/mouse)
  * 3. Proper packet sync with bit3 check
  * 4. Fast execution keeps 8042 buffer from staying full
+ * 5. Cursor and input events are left to a softirq (mouse_packet_work)
  */
-void mouse_handler() {
+void mouse_handler(void *ctx) {
+    (void)ctx;
     irq_total++;
 
     // CRITICAL FIX #1: Read status FIRST
@@ -174,7 +316,7 @@ void mouse_handler() {
 
     // CRITICAL FIX #2: Check if it's mouse data BEFORE reading
     if (!(status & STATUS_AUX)) {
-        (void)inb(PS2_DATA);  // Discard keyboard byte
+        keyboard_process_byte(inb(PS2_DATA));  // Keyboard byte - hand it over
         return;
     }
 
@@ -182,36 +324,63 @@ void mouse_handler() {
     uint8_t b = inb(PS2_DATA);
 
     // Packet sync: first byte must have bit3=1
-    if (pkt_i == 0 && !(b & 0x08))
+    if (pkt_i == 0 && !(b & 0x08)) {
+        sync_errors++;
         return; // ignore until proper sync
+    }
 
     pkt[pkt_i++] = b;
 
-    if (pkt_i < 3)
+    if (pkt_i < pkt_size)
         return;
 
     // Full packet ready
     pkt_i = 0;
 
-    int8_t dx = (int8_t)pkt[1];
-    int8_t dy = -(int8_t)pkt[2]; // invert Y
+    // 9-bit deltas, sign bits in byte 0 (bit 4 = X, bit 5 = Y)
+    int dx = pkt[1] - ((pkt[0] << 4) & 0x100);
+    int dy = -(pkt[2] - ((pkt[0] << 3) & 0x100)); // invert Y
 
-    uint8_t buttons = pkt[0] & 0x07;
+    // X/Y overflow (bits 6/7) - the deltas are meaningless, keep the buttons
+    if (pkt[0] & 0xC0)
+        dx = dy = 0;
 
-    push_packet(dx, dy, buttons);
+    uint8_t buttons = pkt[0] & 0x07;
+    int dz = 0;
+
+    if (device_id == 4) {
+        // Byte 3: 4-bit wheel delta, buttons 4/5 in bits 4/5
+        dz = (int)(pkt[3] & 0x0F) - ((pkt[3] & 0x08) ? 16 : 0);
+        buttons |= (pkt[3] >> 1) & (MOUSE_BUTTON_4 | MOUSE_BUTTON_5);
+    } else if (device_id == 3) {
+        dz = (int8_t)pkt[3];
+    }
 
-    // Send EOI to both PICs
-    outb(0xA0, 0x20);
-    outb(0x20, 0x20);
+    // Hand it to the bottom half; when it is behind, drop the packet
+    uint32_t tail = __atomic_load_n(&pending_tail, __ATOMIC_ACQUIRE);
+    if (pending_head - tail >= MOUSE_PENDING_SIZE) {
+        return;
+    }
+    mouse_packet_t *p = &pending[pending_head & (MOUSE_PENDING_SIZE - 1)];
+    p->dx = dx;
+    p->dy = dy;
+    p->dz = dz;
+    p->buttons = buttons;
+    __atomic_store_n(&pending_head, pending_head + 1, __ATOMIC_RELEASE);
+    softirq_raise(&packet_work);
 }
 
-// Ring buffer read function
-static int mouse_read(mouse_packet_t *out) {
-    if (head == tail) return 0; // no data
-
-    *out = ring[tail];
-    tail = (tail + 1) % MOUSE_BUF_SIZE;
-
+/**
+ * Process a pending mouse byte without waiting for IRQ12
+ * Workaround for when IRQ12 stops firing; returns 1 if a byte was taken
+ */
+int mouse_poll(void) {
+    uint8_t status = inb(PS2_STATUS);
+    if ((status & (STATUS_OBF | STATUS_AUX)) != (STATUS_OBF | STATUS_AUX))
+        return 0;
+    mouse_handler(0);
+    // No interrupt exit to run the bottom half here - apply the packet now
+    mouse_packet_work(0);
     return 1;
 }
 
@@ -239,18 +408,88 @@ int mouse_get_irq_total() {
     return irq_total; 
 }
 
+/**
+ * Current button state - reading it does not consume anything, so
+ * presses between two reads are only seen through input events
+ */
 uint8_t mouse_get_buttons() { 
-    mouse_packet_t p;
-    if (!mouse_read(&p)) return 0;
-    return p.buttons;
+    __asm__ volatile("" ::: "memory");
+    return mouse_buttons;
+}
+
+/**
+ * Set the acceleration curve (all values validated, 1/256 fixed point)
+ * Returns 1 on success, 0 if a value is out of range
+ */
+int mouse_set_accel(const mouse_accel_t *curve) {
+    if (curve->sensitivity < 16 || curve->sensitivity > 4096) return 0;
+    if (curve->threshold > 255) return 0;
+    if (curve->factor < 256 || curve->factor > 4096) return 0;
+
+    uint32_t flags = irq_save();
+    accel = *curve;
+    frac_x = frac_y = 0;
+    irq_restore(flags);
+    return 1;
+}
+
+void mouse_get_accel(mouse_accel_t *curve) {
+    *curve = accel;
 }
 
-// Additional compatibility functions
+/**
+ * Change the sample rate while the mouse is running
+ * Reporting is paused around the command so packet bytes do not mix
+ * with the replies. Returns the rate in effect afterwards.
+ */
+int mouse_set_sample_rate(int rate) {
+    static const uint8_t valid[] = { 10, 20, 40, 60, 80, 100, 200 };
+    int ok = 0;
+    for (unsigned i = 0; i < sizeof(valid); i++) {
+        if (valid[i] == rate) ok = 1;
+    }
+    if (!ok || rate == sample_rate) return sample_rate;
+
+    uint32_t flags = irq_save();
+    mouse_write(0xF5);
+    flush_output();
+    if (mouse_set_rate((uint8_t)rate))
+        sample_rate = rate;
+    mouse_write(0xF4);
+    flush_output();
+    pkt_i = 0;
+    irq_restore(flags);
+
+    return sample_rate;
+}
+
+/**
+ * 0 = standard, 3 = wheel, 4 = wheel + buttons 4/5
+ */
+int mouse_get_device_id() {
+    return device_id;
+}
+
+int mouse_get_sync_errors() {
+    __asm__ volatile("" ::: "memory");
+    return sync_errors;
+}
+
+/**
+ * Clamp the pointer to width x height (normally the BGA mode)
+ * Ignored until a mode is set; the current position is pulled inside
+ */
 void mouse_set_bounds(int width, int height) {
-    // Bounds are hardcoded in push_packet for now (1024x768)
+    if (width <= 0 || height <= 0) return;
+
+    bound_w = width;
+    bound_h = height;
+    if (mouse_x > bound_w - 1) mouse_x = bound_w - 1;
+    if (mouse_y > bound_h - 1) mouse_y = bound_h - 1;
 }
 
 void mouse_reset_position(int x, int y) {
     mouse_x = x;
     mouse_y = y;
+    bga_cursor_move(x, y);
 }
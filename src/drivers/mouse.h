@@ -7,6 +7,27 @@
 #define MOUSE_LEFT_BUTTON   0x01
 #define MOUSE_RIGHT_BUTTON  0x02
 #define MOUSE_MIDDLE_BUTTON 0x04
+#define MOUSE_BUTTON_4      0x08    // IntelliMouse Explorer (ID 4) only
+#define MOUSE_BUTTON_5      0x10
+
+// Sample rate set at init (reports per second)
+#define MOUSE_SAMPLE_RATE   200
+
+/*
+ * Acceleration curve, gains in 1/256 units: movement up to threshold
+ * counts per packet is scaled by sensitivity, the excess additionally
+ * by factor. 256 = 1x.
+ */
+typedef struct {
+    uint16_t sensitivity;   // Base gain (16-4096)
+    uint16_t threshold;     // Counts per packet before acceleration (0-255)
+    uint16_t factor;        // Gain on the excess (256-4096)
+} mouse_accel_t;
+
+// Defaults: 2x as before, 1.5x more on fast flicks (tuned for 200 Hz)
+#define MOUSE_ACCEL_DEFAULT_SENSITIVITY 512
+#define MOUSE_ACCEL_DEFAULT_THRESHOLD   4
+#define MOUSE_ACCEL_DEFAULT_FACTOR      384
 
 /**
  * Initialize PS/2 mouse
@@ -15,9 +36,25 @@
 int mouse_init(void);
 
 /**
- * Mouse IRQ handler (IRQ12)
+ * Mouse IRQ handler (registered on IRQ12)
+ * Assembles packets; the cursor and input events are updated from a
+ * softirq once the interrupt is acknowledged
+ */
+void mouse_handler(void *ctx);
+
+/**
+ * Process pending mouse data by polling the 8042 (IRQ12 stall workaround)
+ * @return 1 if a byte was processed, 0 if none was waiting
  */
-void mouse_handler(void);
+int mouse_poll(void);
+
+/**
+ * Pointer input from another device (USB HID), in pixels
+ * Relative reports go through the acceleration curve; absolute ones are
+ * screen positions. Both move the cursor and queue input events.
+ */
+void mouse_report_relative(int dx, int dy, int dz, uint8_t buttons);
+void mouse_report_absolute(int x, int y, int dz, uint8_t buttons);
 
 /**
  * Get current mouse X position
@@ -30,13 +67,36 @@ int mouse_get_x(void);
 int mouse_get_y(void);
 
 /**
- * Get mouse button state
+ * Get mouse button state (non-destructive, state of the latest packet)
  * @return Bitmap of button states (MOUSE_LEFT_BUTTON | MOUSE_RIGHT_BUTTON | MOUSE_MIDDLE_BUTTON)
  */
 uint8_t mouse_get_buttons(void);
 
 /**
- * Set screen bounds for mouse
+ * Set / get the acceleration curve
+ * @return 1 on success, 0 if a value is out of range
+ */
+int mouse_set_accel(const mouse_accel_t *curve);
+void mouse_get_accel(mouse_accel_t *curve);
+
+/**
+ * Change the sample rate (10, 20, 40, 60, 80, 100 or 200)
+ * @return The rate in effect afterwards
+ */
+int mouse_set_sample_rate(int rate);
+
+/**
+ * Device ID: 0 = standard, 3 = wheel, 4 = wheel + 5 buttons
+ */
+int mouse_get_device_id(void);
+
+/**
+ * Bytes discarded while waiting for a packet's first byte (lost sync)
+ */
+int mouse_get_sync_errors(void);
+
+/**
+ * Set screen bounds for mouse (mouse_init takes them from the BGA mode)
  */
 void mouse_set_bounds(int width, int height);
 
@@ -45,4 +105,12 @@ void mouse_set_bounds(int width, int height);
  */
 void mouse_reset_position(int x, int y);
 
+/**
+ * 8042 controller handshakes (also used by the keyboard driver)
+ * Spin until the controller can take a byte / has one for us;
+ * return 0 on timeout
+ */
+int ps2_wait_input_clear(void);
+int ps2_wait_output_full(void);
+
 #endif // MOUSE_H
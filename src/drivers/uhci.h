@@ -17,6 +17,7 @@
 #define UHCI_CMD_RS         (1 << 0)  // Run/Stop
 #define UHCI_CMD_HCRESET    (1 << 1)  // Host Controller Reset
 #define UHCI_CMD_GRESET     (1 << 2)  // Global Reset
+#define UHCI_CMD_CF         (1 << 6)  // Configure Flag
 #define UHCI_CMD_MAXP       (1 << 7)  // Max Packet (1=64, 0=32)
 
 // UHCI Status Register Bits
@@ -35,6 +36,41 @@
 #define UHCI_PORT_LSDA      (1 << 8)  // Low Speed Device Attached
 #define UHCI_PORT_PR        (1 << 9)  // Port Reset
 #define UHCI_PORT_SUSP      (1 << 12) // Suspend
+#define UHCI_PORT_RWC       (UHCI_PORT_CSC | UHCI_PORT_PEC)  // Write-1-to-clear bits
+
+// Frame list / QH link pointers
+#define UHCI_LINK_TERMINATE (1 << 0)  // T - end of list
+#define UHCI_LINK_QH        (1 << 1)  // Q - points to a QH, not a TD
+#define UHCI_LINK_DEPTH     (1 << 2)  // Vf - depth first (finish this queue first)
+
+// TD control/status
+#define UHCI_TD_ACTLEN_MASK 0x7FF     // Actual length - 1 (0x7FF = none)
+#define UHCI_TD_BITSTUFF    (1 << 17)
+#define UHCI_TD_CRC_TIMEOUT (1 << 18)
+#define UHCI_TD_NAK         (1 << 19)
+#define UHCI_TD_BABBLE      (1 << 20)
+#define UHCI_TD_DBUFFER     (1 << 21)
+#define UHCI_TD_STALLED     (1 << 22)
+#define UHCI_TD_ACTIVE      (1 << 23)
+#define UHCI_TD_IOC         (1 << 24)
+#define UHCI_TD_LS          (1 << 26)  // Low speed device
+#define UHCI_TD_CERR_3      (3 << 27)  // Retry 3 times on error
+#define UHCI_TD_SPD         (1 << 29)  // Short packet detect
+#define UHCI_TD_ERRORS      (UHCI_TD_BITSTUFF | UHCI_TD_CRC_TIMEOUT | UHCI_TD_BABBLE | \
+                             UHCI_TD_DBUFFER | UHCI_TD_STALLED)
+
+// TD token
+#define UHCI_PID_SETUP      0x2D
+#define UHCI_PID_IN         0x69
+#define UHCI_PID_OUT        0xE1
+#define UHCI_TOKEN(pid, addr, ep, toggle, len) \
+    ((uint32_t)(pid) | ((uint32_t)(addr) << 8) | ((uint32_t)(ep) << 15) | \
+     ((uint32_t)(toggle) << 19) | ((((uint32_t)(len) - 1) & 0x7FF) << 21))
+
+// Schedule sizes
+#define UHCI_FRAME_COUNT    1024      // Frame list entries (4KB, 4KB aligned)
+#define UHCI_TD_POOL        32        // TDs for control and interrupt transfers
+#define UHCI_QH_POOL        4         // QHs (interrupt + control in use)
 
 // UHCI Transfer Descriptor (TD)
 typedef struct {
@@ -55,21 +91,18 @@ typedef struct {
 } __attribute__((aligned(16))) uhci_qh_t;
 
 // UHCI Controller Structure
+// Every frame points at interrupt_qh, which links on to control_qh, so
+// interrupt endpoints are polled each millisecond ahead of control traffic
 typedef struct {
     uint16_t io_base;
     uint8_t  irq;
     uint32_t *frame_list;
+    uhci_qh_t *interrupt_qh;
     uhci_qh_t *control_qh;
-    uhci_td_t *setup_td;
-    uhci_td_t *data_td;
-    uhci_td_t *status_td;
+    uhci_td_t *td_pool;         // UHCI_TD_POOL TDs (identity mapped, so virt = phys)
+    uhci_qh_t *qh_pool;         // UHCI_QH_POOL QHs
+    uint8_t  td_used[UHCI_TD_POOL];
+    uint8_t  qh_used[UHCI_QH_POOL];
 } uhci_controller_t;
 
-// UHCI Functions
-int uhci_init(void);
-int uhci_detect_controller(void);
-int uhci_reset(uhci_controller_t *ctrl);
-int uhci_control_transfer(uhci_controller_t *ctrl, uint8_t dev_addr,
-                          uint8_t *setup, uint8_t *data, uint16_t length);
-
 #endif // UHCI_H
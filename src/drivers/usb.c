@@ -1,14 +1,20 @@
-// USB Driver - Basic USB HID Tablet Support
-// This is a simplified USB driver for QEMU's USB tablet emulation
+// USB Driver - UHCI host controller and USB HID pointer support
+// Builds a real UHCI schedule, enumerates the first device it finds and
+// polls its interrupt-IN endpoint. Reports are decoded with the device's
+// HID report descriptor, so QEMU's usb-tablet gives absolute coordinates
+// and a boot-protocol mouse gives relative ones. The TD is checked from a
+// kernel timer at the endpoint's bInterval.
 
 #include "usb.h"
 #include "uhci.h"
+#include "bga.h"
+#include "mouse.h"
 #include "../managers/memory/paging.h"
+#include "../managers/timer/timer.h"
+#include "../managers/irq/softirq.h"
+#include "../managers/log/klog.h"
 
-// Simple output functions (assuming these exist)
-extern void vga_puts(const char *str);
-extern void *kmalloc(uint32_t size);
-extern void kfree(void *ptr);
+extern void *kmalloc_aligned(uint32_t size, uint32_t alignment);
 
 // PCI access functions (assuming these exist)
 extern uint16_t pci_config_read_word(uint8_t bus, uint8_t slot, uint8_t func, uint8_t offset);
@@ -46,6 +52,16 @@ static inline uint32_t inl(uint16_t port) {
     return ret;
 }
 
+// Short polls spin on port 0x80 writes (~1us each); waits of a
+// millisecond or more sleep on the timer (running since timer_init)
+static void delay_us(uint32_t us) {
+    if (us >= 1000) {
+        timer_sleep_ns((uint64_t)us * 1000);
+        return;
+    }
+    while (us--) outb(0x80, 0);
+}
+
 // Global USB state
 static uhci_controller_t g_uhci_ctrl;
 static usb_device_t g_tablet_device;
@@ -55,41 +71,76 @@ static int32_t g_last_x = 512;  // Center of 1024x768
 static int32_t g_last_y = 384;
 static uint8_t g_last_buttons = 0;
 
-// USB HID Boot Protocol Mouse Report (5 bytes)
+// Control transfer buffers (DMA, from the heap)
+#define USB_CTRL_BUF_SIZE   256
+static usb_setup_packet_t *g_setup_buf;
+static uint8_t *g_ctrl_buf;
+
+// Interrupt-IN transfer for the HID device
+#define USB_REPORT_MAX      64
+static uhci_td_t *g_int_td;
+static uint8_t *g_report_buf;
+static uint8_t g_int_toggle = 0;
+static uint16_t g_int_max_packet = 8;
+static volatile int g_int_running = 0;
+static uint32_t g_int_errors = 0;
+static uint8_t g_int_interval = 10;     // Endpoint bInterval (ms)
+static ktimer_t g_poll_timer;
+static softirq_work_t g_poll_work;
+
+/* HID report layout, from the report descriptor */
 typedef struct {
-    uint8_t buttons;   // Button states
-    int8_t  x;         // X movement
-    int8_t  y;         // Y movement
-    int8_t  wheel;     // Wheel movement
-    int8_t  reserved;  // Reserved
-} __attribute__((packed)) usb_hid_mouse_report_t;
-
-// Simplified PCI scan for UHCI controller
+    uint16_t offset;        // Bit offset in the report (after any report ID)
+    uint8_t  size;          // Bits
+    uint8_t  present;
+    uint8_t  relative;
+    int32_t  logical_min;
+    int32_t  logical_max;
+} hid_field_t;
+
+static struct {
+    uint8_t report_id;      // 0 = reports carry no ID byte
+    hid_field_t x, y, wheel;
+    hid_field_t buttons[5];
+} g_hid;
+
+// Find the UHCI controller (Class 0x0C, Subclass 0x03, Interface 0x00)
+// Checks every function - QEMU's PIIX3 UHCI is function 2 of slot 1
 static int find_uhci_controller(void) {
-    // Scan PCI bus for UHCI controller (Class 0x0C, Subclass 0x03, Interface 0x00)
     for (uint16_t bus = 0; bus < 256; bus++) {
         for (uint8_t slot = 0; slot < 32; slot++) {
-            uint16_t vendor = pci_config_read_word(bus, slot, 0, 0);
-            if (vendor == 0xFFFF) continue;
-            
-            uint32_t class_code = pci_config_read_dword(bus, slot, 0, 0x08);
-            uint8_t class = (class_code >> 24) & 0xFF;
-            uint8_t subclass = (class_code >> 16) & 0xFF;
-            uint8_t interface = (class_code >> 8) & 0xFF;
-            
-            // USB UHCI controller
-            if (class == 0x0C && subclass == 0x03 && interface == 0x00) {
-                // Read BAR4 (I/O base address)
-                uint32_t bar4 = pci_config_read_dword(bus, slot, 0, 0x20);
-                g_uhci_ctrl.io_base = bar4 & 0xFFFE;  // Clear bit 0 (I/O space indicator)
+            for (uint8_t func = 0; func < 8; func++) {
+                uint16_t vendor = pci_config_read_word(bus, slot, func, 0);
+                if (vendor == 0xFFFF) {
+                    if (func == 0) break;
+                    continue;
+                }
                 
-                // Enable bus mastering and I/O space
-                uint16_t cmd = pci_config_read_word(bus, slot, 0, 0x04);
-                cmd |= 0x05;  // Enable I/O space and bus mastering
-                pci_config_write_word(bus, slot, 0, 0x04, cmd);
+                uint32_t class_code = pci_config_read_dword(bus, slot, func, 0x08);
+                uint8_t class = (class_code >> 24) & 0xFF;
+                uint8_t subclass = (class_code >> 16) & 0xFF;
+                uint8_t interface = (class_code >> 8) & 0xFF;
                 
-                vga_puts("USB: Found UHCI controller\n");
-                return 1;
+                if (class == 0x0C && subclass == 0x03 && interface == 0x00) {
+                    // BAR4 holds the I/O base
+                    uint32_t bar4 = pci_config_read_dword(bus, slot, func, 0x20);
+                    g_uhci_ctrl.io_base = bar4 & 0xFFFC;
+                    g_uhci_ctrl.irq = pci_config_read_dword(bus, slot, func, 0x3C) & 0xFF;
+                    
+                    // Enable bus mastering and I/O space
+                    uint16_t cmd = pci_config_read_word(bus, slot, func, 0x04);
+                    cmd |= 0x05;
+                    pci_config_write_word(bus, slot, func, 0x04, cmd);
+                    
+                    // Hand the controller over from legacy (BIOS) support
+                    pci_config_write_word(bus, slot, func, 0xC0, 0x8F00);
+                    
+                    klog(KLOG_INFO, "USB", "UHCI controller at I/O 0x%04x", g_uhci_ctrl.io_base);
+                    return 1;
+                }
+                
+                // Single-function device - skip the other functions
+                if (func == 0 && !(pci_config_read_dword(bus, slot, 0, 0x0C) & 0x00800000)) break;
             }
         }
     }
@@ -106,8 +157,7 @@ static void uhci_reset_controller(void) {
     // Wait for halt
     int timeout = 1000;
     while (!(inw(io_base + UHCI_REG_USBSTS) & UHCI_STS_HCH) && timeout--) {
-        // Small delay
-        for (volatile int i = 0; i < 1000; i++);
+        delay_us(10);
     }
     
     // Reset the controller
@@ -116,79 +166,529 @@ static void uhci_reset_controller(void) {
     // Wait for reset to complete
     timeout = 1000;
     while ((inw(io_base + UHCI_REG_USBCMD) & UHCI_CMD_HCRESET) && timeout--) {
-        for (volatile int i = 0; i < 1000; i++);
+        delay_us(10);
     }
     
     // Clear status register
     outw(io_base + UHCI_REG_USBSTS, 0xFFFF);
 }
 
-// Check for devices on UHCI ports
-static int uhci_scan_ports(void) {
+/* ============================================
+ * TD/QH pools
+ * ============================================ */
+
+static uhci_td_t *td_alloc(void) {
+    for (int i = 0; i < UHCI_TD_POOL; i++) {
+        if (!g_uhci_ctrl.td_used[i]) {
+            g_uhci_ctrl.td_used[i] = 1;
+            uhci_td_t *td = &g_uhci_ctrl.td_pool[i];
+            td->link_ptr = UHCI_LINK_TERMINATE;
+            td->status = 0;
+            td->token = 0;
+            td->buffer = 0;
+            return td;
+        }
+    }
+    return 0;
+}
+
+static void td_free(uhci_td_t *td) {
+    g_uhci_ctrl.td_used[td - g_uhci_ctrl.td_pool] = 0;
+}
+
+static uhci_qh_t *qh_alloc(void) {
+    for (int i = 0; i < UHCI_QH_POOL; i++) {
+        if (!g_uhci_ctrl.qh_used[i]) {
+            g_uhci_ctrl.qh_used[i] = 1;
+            uhci_qh_t *qh = &g_uhci_ctrl.qh_pool[i];
+            qh->head_link_ptr = UHCI_LINK_TERMINATE;
+            qh->element_link_ptr = UHCI_LINK_TERMINATE;
+            return qh;
+        }
+    }
+    return 0;
+}
+
+/**
+ * Allocate the frame list and pools and start the schedule
+ * Every frame: interrupt QH -> control QH -> end
+ */
+static int uhci_start(void) {
     uint16_t io_base = g_uhci_ctrl.io_base;
     
-    // Check port 1
-    uint16_t port1_status = inw(io_base + UHCI_REG_PORTSC1);
-    if (port1_status & UHCI_PORT_CCS) {
-        vga_puts("USB: Device detected on port 1\n");
+    g_uhci_ctrl.frame_list = (uint32_t *)kmalloc_aligned(UHCI_FRAME_COUNT * 4, 4096);
+    g_uhci_ctrl.td_pool = (uhci_td_t *)kmalloc_aligned(UHCI_TD_POOL * sizeof(uhci_td_t), 16);
+    g_uhci_ctrl.qh_pool = (uhci_qh_t *)kmalloc_aligned(UHCI_QH_POOL * sizeof(uhci_qh_t), 16);
+    g_setup_buf = (usb_setup_packet_t *)kmalloc_aligned(sizeof(usb_setup_packet_t), 16);
+    g_ctrl_buf = (uint8_t *)kmalloc_aligned(USB_CTRL_BUF_SIZE, 16);
+    g_report_buf = (uint8_t *)kmalloc_aligned(USB_REPORT_MAX, 16);
+    if (!g_uhci_ctrl.frame_list || !g_uhci_ctrl.td_pool || !g_uhci_ctrl.qh_pool ||
+        !g_setup_buf || !g_ctrl_buf || !g_report_buf) {
+        return 0;
+    }
+    
+    for (int i = 0; i < UHCI_TD_POOL; i++) g_uhci_ctrl.td_used[i] = 0;
+    for (int i = 0; i < UHCI_QH_POOL; i++) g_uhci_ctrl.qh_used[i] = 0;
+    
+    g_uhci_ctrl.interrupt_qh = qh_alloc();
+    g_uhci_ctrl.control_qh = qh_alloc();
+    g_uhci_ctrl.interrupt_qh->head_link_ptr = (uint32_t)g_uhci_ctrl.control_qh | UHCI_LINK_QH;
+    
+    for (int i = 0; i < UHCI_FRAME_COUNT; i++) {
+        g_uhci_ctrl.frame_list[i] = (uint32_t)g_uhci_ctrl.interrupt_qh | UHCI_LINK_QH;
+    }
+    
+    outw(io_base + UHCI_REG_USBINTR, 0);    // Completions are polled
+    outw(io_base + UHCI_REG_FRNUM, 0);
+    outl(io_base + UHCI_REG_FRBASEADD, (uint32_t)g_uhci_ctrl.frame_list);
+    outb(io_base + UHCI_REG_SOFMOD, 64);
+    outw(io_base + UHCI_REG_USBSTS, 0xFFFF);
+    outw(io_base + UHCI_REG_USBCMD, UHCI_CMD_RS | UHCI_CMD_CF | UHCI_CMD_MAXP);
+    return 1;
+}
+
+/**
+ * Reset and enable a root port
+ * Returns 1 with *low_speed set if a device is attached and enabled
+ */
+static int uhci_reset_port(uint16_t port_reg, int *low_speed) {
+    uint16_t io = g_uhci_ctrl.io_base + port_reg;
+    
+    if (!(inw(io) & UHCI_PORT_CCS)) return 0;
+    
+    // Reset for 50ms (USB 2.0 7.1.7.5), then let the device recover
+    outw(io, (inw(io) & ~UHCI_PORT_RWC) | UHCI_PORT_PR);
+    delay_us(50000);
+    outw(io, inw(io) & ~(UHCI_PORT_RWC | UHCI_PORT_PR));
+    delay_us(100);
+    
+    for (int i = 0; i < 10; i++) {
+        uint16_t status = inw(io);
+        if (!(status & UHCI_PORT_CCS)) return 0;
+        if (status & UHCI_PORT_PE) {
+            outw(io, status);       // Clear CSC/PEC
+            *low_speed = (status & UHCI_PORT_LSDA) != 0;
+            delay_us(10000);        // Reset recovery
+            return 1;
+        }
+        outw(io, (status & ~UHCI_PORT_RWC) | UHCI_PORT_PE);
+        delay_us(10000);
+    }
+    return 0;
+}
+
+/* ============================================
+ * Control transfers
+ * ============================================ */
+
+static uint32_t td_actual_length(uint32_t status) {
+    return ((status & UHCI_TD_ACTLEN_MASK) + 1) & UHCI_TD_ACTLEN_MASK;
+}
+
+/**
+ * SETUP, DATA (max packet at a time), STATUS on the control QH
+ * Data goes through g_ctrl_buf. Returns bytes transferred, or -1
+ */
+static int usb_control(usb_device_t *dev, uint8_t request_type, uint8_t request,
+                       uint16_t value, uint16_t index, uint16_t length) {
+    uhci_td_t *tds[UHCI_TD_POOL];
+    int count = 0;
+    int dir_in = (request_type & 0x80) != 0;
+    uint16_t mps = dev->max_packet_size ? dev->max_packet_size : 8;
+    uint32_t ls = (dev->speed == USB_SPEED_LOW) ? UHCI_TD_LS : 0;
+    
+    if (length > USB_CTRL_BUF_SIZE) return -1;
+    if ((length + mps - 1) / mps + 2 > UHCI_TD_POOL) return -1;
+    
+    g_setup_buf->bmRequestType = request_type;
+    g_setup_buf->bRequest = request;
+    g_setup_buf->wValue = value;
+    g_setup_buf->wIndex = index;
+    g_setup_buf->wLength = length;
+    
+    // SETUP stage
+    uhci_td_t *td = td_alloc();
+    if (!td) return -1;
+    td->token = UHCI_TOKEN(UHCI_PID_SETUP, dev->address, 0, 0, sizeof(usb_setup_packet_t));
+    td->buffer = (uint32_t)g_setup_buf;
+    tds[count++] = td;
+    
+    // DATA stage
+    int toggle = 1;
+    for (uint16_t done = 0; done < length; done += mps) {
+        uint16_t chunk = (length - done < mps) ? length - done : mps;
+        td = td_alloc();
+        if (!td) break;
+        td->token = UHCI_TOKEN(dir_in ? UHCI_PID_IN : UHCI_PID_OUT, dev->address, 0, toggle, chunk);
+        td->buffer = (uint32_t)(g_ctrl_buf + done);
+        tds[count++] = td;
+        toggle ^= 1;
+    }
+    
+    // STATUS stage - opposite direction, always DATA1, zero length
+    td = td_alloc();
+    if (td) {
+        td->token = UHCI_TOKEN((dir_in && length) ? UHCI_PID_OUT : UHCI_PID_IN, dev->address, 0, 1, 0);
+        tds[count++] = td;
+    }
+    
+    int result = -1;
+    if (td && count == (length + mps - 1) / mps + 2) {
+        for (int i = 0; i < count; i++) {
+            tds[i]->link_ptr = (i + 1 < count) ? ((uint32_t)tds[i + 1] | UHCI_LINK_DEPTH) : UHCI_LINK_TERMINATE;
+            tds[i]->status = UHCI_TD_ACTIVE | UHCI_TD_CERR_3 | ls;
+        }
+        
+        __asm__ volatile("" ::: "memory");
+        g_uhci_ctrl.control_qh->element_link_ptr = (uint32_t)tds[0];
         
-        // Reset the port
-        outw(io_base + UHCI_REG_PORTSC1, port1_status | UHCI_PORT_PR);
-        for (volatile int i = 0; i < 100000; i++);  // Delay
-        outw(io_base + UHCI_REG_PORTSC1, port1_status & ~UHCI_PORT_PR);
+        // Wait up to ~500ms for the status stage
+        for (int t = 0; t < 50000; t++) {
+            volatile uint32_t *last = &tds[count - 1]->status;
+            if (!(*last & UHCI_TD_ACTIVE)) {
+                result = 0;
+                break;
+            }
+            int failed = 0;
+            for (int i = 0; i < count; i++) {
+                uint32_t st = *(volatile uint32_t *)&tds[i]->status;
+                if (!(st & UHCI_TD_ACTIVE) && (st & UHCI_TD_ERRORS)) failed = 1;
+            }
+            if (failed) break;
+            delay_us(10);
+        }
         
-        // Enable the port
-        port1_status = inw(io_base + UHCI_REG_PORTSC1);
-        outw(io_base + UHCI_REG_PORTSC1, port1_status | UHCI_PORT_PE);
+        g_uhci_ctrl.control_qh->element_link_ptr = UHCI_LINK_TERMINATE;
+        __asm__ volatile("" ::: "memory");
         
-        return 1;
+        if (result == 0) {
+            for (int i = 1; i < count - 1; i++) result += td_actual_length(tds[i]->status);
+        }
     }
     
-    // Check port 2
-    uint16_t port2_status = inw(io_base + UHCI_REG_PORTSC2);
-    if (port2_status & UHCI_PORT_CCS) {
-        vga_puts("USB: Device detected on port 2\n");
-        
-        // Reset the port
-        outw(io_base + UHCI_REG_PORTSC2, port2_status | UHCI_PORT_PR);
-        for (volatile int i = 0; i < 100000; i++);
-        outw(io_base + UHCI_REG_PORTSC2, port2_status & ~UHCI_PORT_PR);
-        
-        // Enable the port
-        port2_status = inw(io_base + UHCI_REG_PORTSC2);
-        outw(io_base + UHCI_REG_PORTSC2, port2_status | UHCI_PORT_PE);
+    for (int i = 0; i < count; i++) td_free(tds[i]);
+    return result;
+}
+
+static int usb_get_descriptor(usb_device_t *dev, uint8_t recipient, uint8_t type, uint8_t desc_index,
+                              uint16_t index, uint16_t length) {
+    return usb_control(dev, 0x80 | recipient, USB_REQ_GET_DESCRIPTOR,
+                       ((uint16_t)type << 8) | desc_index, index, length);
+}
+
+/* ============================================
+ * HID report descriptor
+ * ============================================ */
+
+static int32_t hid_item_value(const uint8_t *data, int size, int is_signed) {
+    uint32_t v = 0;
+    for (int i = 0; i < size; i++) v |= (uint32_t)data[i] << (i * 8);
+    if (is_signed && size > 0 && size < 4 && (v & (1u << (size * 8 - 1)))) {
+        v |= ~0u << (size * 8);
+    }
+    return (int32_t)v;
+}
+
+/**
+ * Find the X, Y, wheel and button fields of the first input report that
+ * has an X axis. Global items persist, local usages reset per main item.
+ */
+static int hid_parse(const uint8_t *desc, int length) {
+    uint16_t usage_page = 0;
+    int32_t logical_min = 0, logical_max = 0;
+    uint32_t report_size = 0, report_count = 0;
+    uint8_t report_id = 0;
+    uint16_t usages[16];
+    int usage_count = 0;
+    uint16_t usage_min = 0, usage_max = 0;
+    uint32_t bit_offset = 0;
+    
+    for (int i = 0; i < (int)sizeof(g_hid); i++) ((uint8_t *)&g_hid)[i] = 0;
+    
+    int pos = 0;
+    while (pos < length) {
+        uint8_t prefix = desc[pos++];
+        if (prefix == 0xFE) {                   // Long item
+            if (pos + 1 >= length) break;
+            pos += 2 + desc[pos];
+            continue;
+        }
+        int size = prefix & 3;
+        if (size == 3) size = 4;
+        int type = (prefix >> 2) & 3;
+        int tag = prefix >> 4;
+        if (pos + size > length) break;
+        const uint8_t *data = &desc[pos];
+        uint32_t uvalue = (uint32_t)hid_item_value(data, size, 0);
+        pos += size;
         
-        return 1;
+        if (type == 1) {                        // Global
+            switch (tag) {
+                case 0x0: usage_page = uvalue; break;
+                case 0x1: logical_min = hid_item_value(data, size, 1); break;
+                case 0x2: logical_max = hid_item_value(data, size, logical_min < 0); break;
+                case 0x7: report_size = uvalue; break;
+                case 0x8:
+                    // Offsets restart in each report; stop once the pointer report is done
+                    if (g_hid.x.present) return 1;
+                    report_id = uvalue;
+                    bit_offset = 0;
+                    break;
+                case 0x9: report_count = uvalue; break;
+            }
+        } else if (type == 2) {                 // Local
+            uint16_t usage = uvalue & 0xFFFF;
+            switch (tag) {
+                case 0x0: if (usage_count < 16) usages[usage_count++] = usage; break;
+                case 0x1: usage_min = usage; break;
+                case 0x2: usage_max = usage; break;
+            }
+        } else if (type == 0) {                 // Main
+            if (tag == 0x8 && !(uvalue & 0x01)) {   // Input, not constant
+                for (uint32_t n = 0; n < report_count; n++) {
+                    uint16_t usage;
+                    if (n < (uint32_t)usage_count) usage = usages[n];
+                    else if (usage_max) usage = usage_min + n <= usage_max ? usage_min + n : usage_max;
+                    else usage = usage_count ? usages[usage_count - 1] : 0;
+                    
+                    hid_field_t field = { bit_offset + n * report_size, report_size, 1,
+                                          (uvalue & 0x04) != 0, logical_min, logical_max };
+                    hid_field_t *target = 0;
+                    if (usage_page == 0x09 && usage >= 1 && usage <= 5) target = &g_hid.buttons[usage - 1];
+                    if (usage_page == 0x01 && usage == 0x30) target = &g_hid.x;
+                    if (usage_page == 0x01 && usage == 0x31) target = &g_hid.y;
+                    if (usage_page == 0x01 && usage == 0x38) target = &g_hid.wheel;
+                    if (target && !target->present) {
+                        *target = field;
+                        g_hid.report_id = report_id;
+                    }
+                }
+            }
+            // Output and Feature reports have their own layout
+            if (tag == 0x8) bit_offset += report_size * report_count;
+            usage_count = 0;
+            usage_min = usage_max = 0;
+        }
     }
+    return g_hid.x.present && g_hid.y.present;
+}
+
+static int32_t hid_field_value(const hid_field_t *f, const uint8_t *report, int length) {
+    if (!f->present || f->size == 0 || f->size > 32 || (uint32_t)(f->offset + f->size + 7) / 8 > (uint32_t)length) return 0;
     
-    return 0;
+    uint32_t v = 0;
+    for (int bit = 0; bit < f->size; bit++) {
+        uint32_t at = f->offset + bit;
+        if (report[at / 8] & (1 << (at % 8))) v |= 1u << bit;
+    }
+    if (f->logical_min < 0 && f->size < 32 && (v & (1u << (f->size - 1)))) v |= ~0u << f->size;
+    return (int32_t)v;
+}
+
+/**
+ * Scale an absolute axis onto 0..pixels-1
+ */
+static int hid_scale(const hid_field_t *f, int32_t value, int pixels) {
+    int32_t range = f->logical_max - f->logical_min;
+    if (range <= 0) return 0;
+    if (value < f->logical_min) value = f->logical_min;
+    if (value > f->logical_max) value = f->logical_max;
+    return (int)((uint32_t)(value - f->logical_min) * (uint32_t)(pixels - 1) / (uint32_t)range);
+}
+
+static void hid_decode(const uint8_t *report, int length) {
+    if (g_hid.report_id) {
+        if (length < 1 || report[0] != g_hid.report_id) return;
+        report++;
+        length--;
+    }
+    
+    uint8_t buttons = 0;
+    for (int i = 0; i < 5; i++) {
+        if (hid_field_value(&g_hid.buttons[i], report, length)) buttons |= 1 << i;
+    }
+    int32_t x = hid_field_value(&g_hid.x, report, length);
+    int32_t y = hid_field_value(&g_hid.y, report, length);
+    // HID wheel is positive away from the user; input events count towards
+    int dz = -hid_field_value(&g_hid.wheel, report, length);
+    
+    if (g_hid.x.relative) {
+        mouse_report_relative(x, y, dz, buttons);
+    } else {
+        g_last_x = hid_scale(&g_hid.x, x, bga_get_width());
+        g_last_y = hid_scale(&g_hid.y, y, bga_get_height());
+        mouse_report_absolute(g_last_x, g_last_y, dz, buttons);
+    }
+    g_last_buttons = buttons;
+}
+
+/* ============================================
+ * Enumeration
+ * ============================================ */
+
+static uint16_t read16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+/**
+ * Address, configure and start polling the first HID pointer on a port
+ */
+static int usb_enumerate(int low_speed) {
+    usb_device_t *dev = &g_tablet_device;
+    dev->address = 0;
+    dev->speed = low_speed ? USB_SPEED_LOW : USB_SPEED_FULL;
+    dev->max_packet_size = 8;
+    
+    // First 8 bytes give bMaxPacketSize0
+    if (usb_get_descriptor(dev, 0, USB_DESC_DEVICE, 0, 0, 8) < 8) return 0;
+    dev->max_packet_size = g_ctrl_buf[7];
+    
+    if (usb_control(dev, 0x00, USB_REQ_SET_ADDRESS, 1, 0, 0) < 0) return 0;
+    dev->address = 1;
+    delay_us(2000);
+    
+    if (usb_get_descriptor(dev, 0, USB_DESC_DEVICE, 0, 0, sizeof(usb_device_descriptor_t)) <
+        (int)sizeof(usb_device_descriptor_t)) return 0;
+    usb_device_descriptor_t *dd = (usb_device_descriptor_t *)g_ctrl_buf;
+    dev->vendor_id = dd->idVendor;
+    dev->product_id = dd->idProduct;
+    
+    klog(KLOG_INFO, "USB", "Device %04X:%04X", dev->vendor_id, dev->product_id);
+    
+    // Configuration, then the whole descriptor set
+    if (usb_get_descriptor(dev, 0, USB_DESC_CONFIGURATION, 0, 0, 9) < 9) return 0;
+    uint16_t total = read16(&g_ctrl_buf[2]);
+    if (total > USB_CTRL_BUF_SIZE) total = USB_CTRL_BUF_SIZE;
+    uint8_t config_value = g_ctrl_buf[5];
+    int got = usb_get_descriptor(dev, 0, USB_DESC_CONFIGURATION, 0, 0, total);
+    if (got < 9) return 0;
+    
+    int iface = -1;
+    uint16_t report_length = 0;
+    g_int_interval = 10;
+    g_tablet_endpoint = 0;
+    for (int pos = 0; pos + 2 <= got && g_ctrl_buf[pos] >= 2; pos += g_ctrl_buf[pos]) {
+        uint8_t *d = &g_ctrl_buf[pos];
+        if (d[1] == USB_DESC_INTERFACE && iface < 0 && d[5] == USB_CLASS_HID) {
+            iface = d[2];
+            dev->class = d[5];
+            dev->subclass = d[6];
+            dev->protocol = d[7];
+        } else if (d[1] == USB_DESC_HID && iface >= 0 && !report_length) {
+            report_length = read16(&d[7]);
+        } else if (d[1] == USB_DESC_ENDPOINT && iface >= 0 && !g_tablet_endpoint &&
+                   (d[2] & 0x80) && (d[3] & 0x03) == 0x03) {
+            g_tablet_endpoint = d[2] & 0x0F;
+            g_int_max_packet = read16(&d[4]) & 0x7FF;
+            g_int_interval = d[6] ? d[6] : 1;
+        }
+    }
+    if (iface < 0 || !g_tablet_endpoint || !report_length) {
+        klog(KLOG_WARN, "USB", "No HID interrupt endpoint");
+        return 0;
+    }
+    if (g_int_max_packet > USB_REPORT_MAX) g_int_max_packet = USB_REPORT_MAX;
+    
+    if (usb_control(dev, 0x00, USB_REQ_SET_CONFIGURATION, config_value, 0, 0) < 0) return 0;
+    
+    // Report only on change (a STALL here is allowed)
+    usb_control(dev, 0x21, HID_REQ_SET_IDLE, 0, iface, 0);
+    
+    if (report_length > USB_CTRL_BUF_SIZE) report_length = USB_CTRL_BUF_SIZE;
+    int desc_length = usb_get_descriptor(dev, 0x01, USB_DESC_REPORT, 0, iface, report_length);
+    if (desc_length <= 0 || !hid_parse(g_ctrl_buf, desc_length)) {
+        klog(KLOG_WARN, "USB", "HID device has no X/Y axes");
+        return 0;
+    }
+    
+    klog(KLOG_INFO, "USB", g_hid.x.relative ? "HID mouse (relative)" : "HID tablet (absolute)");
+    return 1;
+}
+
+/**
+ * Queue the interrupt-IN TD on the interrupt QH
+ */
+static void usb_arm_interrupt(void) {
+    uint32_t ls = (g_tablet_device.speed == USB_SPEED_LOW) ? UHCI_TD_LS : 0;
+    
+    g_int_td->link_ptr = UHCI_LINK_TERMINATE;
+    g_int_td->token = UHCI_TOKEN(UHCI_PID_IN, g_tablet_device.address, g_tablet_endpoint,
+                                 g_int_toggle, g_int_max_packet);
+    g_int_td->buffer = (uint32_t)g_report_buf;
+    __asm__ volatile("" ::: "memory");
+    g_int_td->status = UHCI_TD_ACTIVE | UHCI_TD_CERR_3 | ls;
+    __asm__ volatile("" ::: "memory");
+    g_uhci_ctrl.interrupt_qh->element_link_ptr = (uint32_t)g_int_td;
+}
+
+// Report decoding moves the cursor - leave it to the softirq
+static void usb_poll_work(void *ctx) {
+    (void)ctx;
+    usb_poll();
+}
+
+static void usb_poll_timer(ktimer_t *timer) {
+    softirq_raise(&g_poll_work);
+    timer_add(timer, timer->expires + g_int_interval * 1000000ULL);
 }
 
 // Initialize USB subsystem
 void usb_init(void) {
-    vga_puts("USB: Initializing...\n");
+    klog(KLOG_DEBUG, "USB", "Initializing...");
     
-    // Find UHCI controller
     if (!find_uhci_controller()) {
-        vga_puts("USB: No UHCI controller found\n");
+        klog(KLOG_INFO, "USB", "No UHCI controller found");
         return;
     }
     
-    // Reset controller
     uhci_reset_controller();
+    if (!uhci_start()) {
+        klog(KLOG_ERROR, "USB", "Out of memory for the schedule");
+        return;
+    }
     
-    // Scan for devices
-    if (uhci_scan_ports()) {
-        vga_puts("USB: Device enumeration not yet implemented\n");
-        vga_puts("USB: Assuming tablet device is present\n");
-        
-        // For now, just mark tablet as present
-        // Full enumeration would require USB transfers and descriptor parsing
-        g_tablet_found = 1;
-        g_tablet_device.address = 1;
-        g_tablet_device.vendor_id = 0x0627;  // QEMU tablet vendor ID
-        g_tablet_device.product_id = 0x0001;
+    // First HID pointer on either root port
+    static const uint16_t ports[] = { UHCI_REG_PORTSC1, UHCI_REG_PORTSC2 };
+    for (int i = 0; i < 2 && !g_tablet_found; i++) {
+        int low_speed = 0;
+        if (uhci_reset_port(ports[i], &low_speed) && usb_enumerate(low_speed)) {
+            g_tablet_found = 1;
+        }
+    }
+    if (!g_tablet_found) return;
+    
+    g_int_td = td_alloc();
+    if (!g_int_td) return;
+    g_int_toggle = 0;
+    usb_arm_interrupt();
+    g_int_running = 1;
+    
+    // The controller polls the QH every frame; look at the TD at the
+    // rate the device asked for
+    softirq_init_work(&g_poll_work, usb_poll_work, 0);
+    timer_setup(&g_poll_timer, usb_poll_timer, 0);
+    timer_add_ns(&g_poll_timer, g_int_interval * 1000000ULL);
+}
+
+/**
+ * Poll the interrupt-IN TD - a softirq raised by the poll timer every bInterval
+ * A completed TD is decoded into pointer events and re-armed with the
+ * other data toggle; NAKs leave it active, so this is a single load
+ * when nothing happened.
+ */
+void usb_poll(void) {
+    if (!g_int_running) return;
+    
+    uint32_t status = *(volatile uint32_t *)&g_int_td->status;
+    if (status & UHCI_TD_ACTIVE) return;
+    
+    if (status & UHCI_TD_ERRORS) {
+        g_int_errors++;
+    } else {
+        hid_decode(g_report_buf, td_actual_length(status));
+        g_int_toggle ^= 1;
     }
+    usb_arm_interrupt();
 }
 
 // Detect USB devices
@@ -201,14 +701,12 @@ int usb_is_tablet_present(void) {
     return g_tablet_found;
 }
 
-// Get tablet report (simplified - would need actual USB transfers)
+// Latest pointer state from the device's reports
 int usb_tablet_get_report(int32_t *x, int32_t *y, uint8_t *buttons) {
     if (!g_tablet_found) {
         return 0;
     }
     
-    // TODO: Implement actual USB interrupt transfer to read HID report
-    // For now, return last known position
     *x = g_last_x;
     *y = g_last_y;
     *buttons = g_last_buttons;
@@ -128,5 +128,6 @@ void usb_init(void);
 int usb_detect_devices(void);
 int usb_is_tablet_present(void);
 int usb_tablet_get_report(int32_t *x, int32_t *y, uint8_t *buttons);
+void usb_poll(void);
 
 #endif // USB_H
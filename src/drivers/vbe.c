@@ -4,6 +4,7 @@
  */
 
 #include <stdint.h>
+#include "../lib/font.h"
 
 /* Forward declaration */
 void vbe_emergency_text_mode(void);
@@ -22,164 +23,6 @@ static uint32_t bits_per_pixel = 0;
 static int cursor_x = 0;
 static int cursor_y = 0;
 
-/* 8x16 VGA Font (subset of printable ASCII) */
-static const uint8_t font_8x16[128][16] = {
-    /* 0x00-0x1F: Control characters - use space */
-    [0 ... 31] = {0},
-    
-    /* 0x20: Space */
-    [32] = {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-            0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
-    
-    /* 0x21: ! */
-    [33] = {0x00, 0x00, 0x18, 0x3C, 0x3C, 0x3C, 0x18, 0x18,
-            0x18, 0x00, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00},
-    
-    /* 0x22-0x2F: Basic symbols */
-    [34 ... 47] = {0},  // Placeholder
-    
-    /* 0x30-0x39: Digits 0-9 */
-    [48] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x6E, 0x76, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 0
-    [49] = {0x00, 0x00, 0x18, 0x38, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // 1
-    [50] = {0x00, 0x00, 0x3C, 0x66, 0x06, 0x0C, 0x18, 0x30,
-            0x60, 0x66, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // 2
-    [51] = {0x00, 0x00, 0x3C, 0x66, 0x06, 0x06, 0x1C, 0x06,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 3
-    [52] = {0x00, 0x00, 0x0C, 0x1C, 0x3C, 0x6C, 0x6C, 0x7E,
-            0x0C, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 4
-    [53] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x7C, 0x06, 0x06,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 5
-    [54] = {0x00, 0x00, 0x1C, 0x30, 0x60, 0x7C, 0x66, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 6
-    [55] = {0x00, 0x00, 0x7E, 0x66, 0x06, 0x0C, 0x18, 0x18,
-            0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // 7
-    [56] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3C, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // 8
-    [57] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x3E, 0x06,
-            0x06, 0x0C, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00},  // 9
-    
-    /* 0x3A-0x40: Punctuation */
-    [58] = {0x00, 0x00, 0x00, 0x00, 0x18, 0x18, 0x00, 0x00,
-            0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},  // :
-    [59 ... 64] = {0},
-    
-    /* 0x41-0x5A: Uppercase A-Z */
-    [65] = {0x00, 0x00, 0x18, 0x3C, 0x66, 0x66, 0x66, 0x7E,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // A
-    [66] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x66,
-            0x66, 0x66, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00},  // B
-    [67] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x60, 0x60, 0x60,
-            0x60, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // C
-    [68] = {0x00, 0x00, 0x78, 0x6C, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x6C, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00},  // D
-    [69] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x60, 0x7C, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // E
-    [70] = {0x00, 0x00, 0x7E, 0x60, 0x60, 0x60, 0x7C, 0x60,
-            0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00},  // F
-    [71] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x60, 0x6E, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // G
-    [72] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x7E, 0x66,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // H
-    [73] = {0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // I
-    [74] = {0x00, 0x00, 0x1E, 0x0C, 0x0C, 0x0C, 0x0C, 0x0C,
-            0x6C, 0x6C, 0x38, 0x00, 0x00, 0x00, 0x00, 0x00},  // J
-    [75] = {0x00, 0x00, 0x66, 0x66, 0x6C, 0x78, 0x70, 0x78,
-            0x6C, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // K
-    [76] = {0x00, 0x00, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // L
-    [77] = {0x00, 0x00, 0x63, 0x77, 0x7F, 0x6B, 0x63, 0x63,
-            0x63, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00},  // M
-    [78] = {0x00, 0x00, 0x66, 0x66, 0x76, 0x7E, 0x6E, 0x66,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // N
-    [79] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // O
-    [80] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x60,
-            0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00},  // P
-    [81] = {0x00, 0x00, 0x3C, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x6A, 0x6C, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00},  // Q
-    [82] = {0x00, 0x00, 0x7C, 0x66, 0x66, 0x66, 0x7C, 0x6C,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // R
-    [83] = {0x00, 0x00, 0x3C, 0x66, 0x60, 0x30, 0x18, 0x0C,
-            0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // S
-    [84] = {0x00, 0x00, 0x7E, 0x18, 0x18, 0x18, 0x18, 0x18,
-            0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // T
-    [85] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // U
-    [86] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x66, 0x66, 0x66,
-            0x66, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // V
-    [87] = {0x00, 0x00, 0x63, 0x63, 0x63, 0x63, 0x6B, 0x7F,
-            0x77, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00},  // W
-    [88] = {0x00, 0x00, 0x66, 0x66, 0x3C, 0x18, 0x18, 0x3C,
-            0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // X
-    [89] = {0x00, 0x00, 0x66, 0x66, 0x66, 0x3C, 0x18, 0x18,
-            0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // Y
-    [90] = {0x00, 0x00, 0x7E, 0x06, 0x0C, 0x18, 0x30, 0x60,
-            0x60, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // Z
-    
-    /* 0x5B-0x60: Brackets, etc */
-    [91 ... 96] = {0},
-    
-    /* 0x61-0x7A: Lowercase a-z */
-    [97] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x06, 0x3E, 0x66,
-            0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00},  // a
-    [98] = {0x00, 0x00, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66,
-            0x66, 0x66, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00},  // b
-    [99] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x60, 0x60,
-            0x60, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // c
-    [100] = {0x00, 0x00, 0x06, 0x06, 0x3E, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00},  // d
-    [101] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x7E,
-             0x60, 0x60, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // e
-    [102] = {0x00, 0x00, 0x1C, 0x36, 0x30, 0x30, 0x7C, 0x30,
-             0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00},  // f
-    [103] = {0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66,
-             0x3E, 0x06, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00},  // g
-    [104] = {0x00, 0x00, 0x60, 0x60, 0x7C, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // h
-    [105] = {0x00, 0x00, 0x18, 0x00, 0x38, 0x18, 0x18, 0x18,
-             0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // i
-    [106] = {0x00, 0x00, 0x06, 0x00, 0x06, 0x06, 0x06, 0x06,
-             0x06, 0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00},  // j
-    [107] = {0x00, 0x00, 0x60, 0x60, 0x66, 0x6C, 0x78, 0x78,
-             0x6C, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // k
-    [108] = {0x00, 0x00, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18,
-             0x18, 0x18, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // l
-    [109] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x7F, 0x7F, 0x6B,
-             0x63, 0x63, 0x63, 0x00, 0x00, 0x00, 0x00, 0x00},  // m
-    [110] = {0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // n
-    [111] = {0x00, 0x00, 0x00, 0x00, 0x3C, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00},  // o
-    [112] = {0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x66, 0x66,
-             0x7C, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00},  // p
-    [113] = {0x00, 0x00, 0x00, 0x00, 0x3E, 0x66, 0x66, 0x66,
-             0x3E, 0x06, 0x06, 0x06, 0x00, 0x00, 0x00, 0x00},  // q
-    [114] = {0x00, 0x00, 0x00, 0x00, 0x7C, 0x66, 0x60, 0x60,
-             0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00},  // r
-    [115] = {0x00, 0x00, 0x00, 0x00, 0x3E, 0x60, 0x60, 0x3C,
-             0x06, 0x06, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00},  // s
-    [116] = {0x00, 0x00, 0x18, 0x18, 0x7E, 0x18, 0x18, 0x18,
-             0x18, 0x18, 0x0E, 0x00, 0x00, 0x00, 0x00, 0x00},  // t
-    [117] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x66, 0x66, 0x3E, 0x00, 0x00, 0x00, 0x00, 0x00},  // u
-    [118] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x66, 0x3C, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00},  // v
-    [119] = {0x00, 0x00, 0x00, 0x00, 0x63, 0x63, 0x6B, 0x6B,
-             0x7F, 0x36, 0x36, 0x00, 0x00, 0x00, 0x00, 0x00},  // w
-    [120] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x3C, 0x18,
-             0x3C, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00},  // x
-    [121] = {0x00, 0x00, 0x00, 0x00, 0x66, 0x66, 0x66, 0x66,
-             0x3E, 0x06, 0x0C, 0x78, 0x00, 0x00, 0x00, 0x00},  // y
-    [122] = {0x00, 0x00, 0x00, 0x00, 0x7E, 0x06, 0x0C, 0x18,
-             0x30, 0x60, 0x7E, 0x00, 0x00, 0x00, 0x00, 0x00},  // z
-    
-    /* 0x7B-0x7F: More symbols */
-    [123 ... 127] = {0}
-};
-
 /* External VGA functions for emergency text mode */
 extern void vga_clear(void);
 extern void vga_print(const char *s);
@@ -292,14 +135,13 @@ void vbe_draw_rect(int x, int y, int width, int height, uint32_t color) {
  * Draw a character at position (x, y) with foreground/background color
  */
 void vbe_putchar(int x, int y, char c, uint32_t fg, uint32_t bg) {
-    uint8_t uc = (uint8_t)c;
-    if (uc >= 128) uc = 0;  // Invalid character, use space
-    
-    const uint8_t *glyph = font_8x16[uc];
+    int index = font_glyph_index((uint8_t)c);
+    const uint8_t *glyph = &font_bitmap[index * FONT_HEIGHT];
+    int bearing = font_glyphs[index].bearing;
     
-    for (int row = 0; row < 16; row++) {
-        uint8_t line = glyph[row];
-        for (int col = 0; col < 8; col++) {
+    for (int row = 0; row < FONT_HEIGHT; row++) {
+        uint8_t line = glyph[row] >> bearing;  // Back to cell position
+        for (int col = 0; col < FONT_CELL_WIDTH; col++) {
             uint32_t color = (line & (0x80 >> col)) ? fg : bg;
             vbe_putpixel(x + col, y + row, color);
         }
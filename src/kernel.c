@@ -1,4 +1,6 @@
 #include <stdint.h>
+#include "managers/log/klog.h"
+#include "managers/irq/irq_manager.h"
 
 /* Multiboot header - Complete structure for module support */
 struct multiboot_module {
@@ -91,32 +93,10 @@ void vmm_free_page(void *addr);
 
 unsigned int sysman_entry_point = 0;
 
-static inline void outb(unsigned short port, unsigned char val) {
-    asm volatile("outb %0, %1" : : "a"(val), "Nd"(port));
-}
-
-static inline unsigned char inb(unsigned short port) {
-    unsigned char ret;
-    asm volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
-    return ret;
-}
-
-static void serial_print(const char *str) {
-    while (*str) {
-        while ((inb(0x3FD) & 0x20) == 0);
-        outb(0x3F8, *str++);
-    }
-}
-
-static void serial_hex(unsigned char value) {
-    char hex[] = "0123456789ABCDEF";
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[(value >> 4) & 0xF]);
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[value & 0xF]);
-}
-
 void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
+    // Serial log first - everything below may report through it
+    klog_init();
+    
     // Print startup message via VGA
     extern void vga_print(const char *str);
     vga_print("Starting MaahiOS...\n");
@@ -128,7 +108,7 @@ void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
     
     // Get framebuffer info (use hardcoded address to avoid slow PCI scan)
     uint32_t fb_addr = 0xFD000000;  // QEMU default BGA framebuffer
-    uint32_t fb_size = 1024 * 768 * 4;
+    uint32_t fb_size = 1024 * 768 * 4 * 2;  // Front + back page for page flipping
     
     // Initialize PMM
     if (!pmm_init(mbi)) {
@@ -159,7 +139,11 @@ void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
         while(1) __asm__ volatile("hlt");
     }
     
-    // Initialize IRQ manager (remaps PIC)
+    // Detect CPU features and enable SSE (used by the BGA span kernels)
+    extern void cpu_init(void);
+    cpu_init();
+    
+    // Initialize IRQ manager (remaps PIC, routes through the IOAPIC)
     extern void irq_manager_init(void);
     irq_manager_init();
     
@@ -168,14 +152,33 @@ void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
         while(1) __asm__ volatile("hlt");
     }
     
-    // Install mouse IRQ handler (IRQ12)
-    extern int idt_install_mouse_handler(void);
-    idt_install_mouse_handler();
+    // Attach the IRQ handlers (the lines stay masked until irq_enable)
+    extern int irq_register_handler(int irq_number, void (*handler)(void *ctx), void *ctx);
+    extern void pit_handler(void *ctx);
+    extern void keyboard_handler(void *ctx);
+    extern void mouse_handler(void *ctx);
+    irq_register_handler(0, pit_handler, 0);        // PIT
+    irq_register_handler(1, keyboard_handler, 0);   // PS/2 keyboard
+    irq_register_handler(12, mouse_handler, 0);     // PS/2 mouse
     
     // Initialize kernel heap
     extern void kheap_init(void);
     kheap_init();
     
+    // Calibrate the TSC and publish the monotonic clock page
+    extern void clock_init(void);
+    clock_init();
+    
+    // Program the performance counters and allow RDPMC in Ring 3
+    extern uint32_t pmc_init(void);
+    pmc_init();
+    
+#ifdef KERNEL_TRACE
+    // Trace ring headers (needs the TSC rate)
+    extern void trace_init(void);
+    trace_init();
+#endif
+    
     // Initialize process manager
     extern void process_manager_init(void);
     process_manager_init();
@@ -184,21 +187,30 @@ void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
     extern void scheduler_init(void);
     scheduler_init();
     
-    // Initialize PIT timer (1000Hz = 1ms ticks for faster scheduling)
-    extern void pit_init(unsigned int frequency);
-    pit_init(1000);
+    // Timer wheel: one-shot LAPIC timer, else PIT one-shot, else 1 kHz PIT
+    extern void timer_init(void);
+    timer_init();
     
     // Enable interrupts NOW - kernel does this ONCE
     __asm__ volatile("sti");
     
-    // NOTE: Don't enable timer IRQ yet - wait until after process creation
-    // Otherwise scheduler_tick() will fire before processes exist!
+    // Serial log output moves to the UART interrupt
+    klog_start_irq();
+    
+    // NOTE: Timers may fire from here on, but scheduler_tick() does
+    // nothing until scheduler_enable() below
     
     // Initialize BGA (switch to graphics mode)
     if (!bga_init(1024, 768, 32)) {
         while(1) __asm__ volatile("hlt");
     }
     
+#ifdef BGA_BENCHMARK
+    // Fill/blit Mpixels/s table on serial
+    extern void bga_benchmark(void);
+    bga_benchmark();
+#endif
+    
     // Draw beautiful loading screen (visible during QEMU display init)
     bga_clear(0x001020);  // Dark blue background
     
@@ -220,114 +232,76 @@ void kernel_main(unsigned int magic, struct multiboot_info *mbi) {
     bga_print_at(box_x + 120, box_y + 140, "Initializing components", 0xFF888888, 0x00001040);
     bga_print_at(box_x + 120, box_y + 180, "Please wait...", 0xFF666666, 0x00001040);
     
-    // Debug: Print to serial to see if we got here
-    extern void serial_print(const char *str);
-    serial_print("[KERNEL] Finished drawing loading screen\n");
+    // Flip the loading screen to the front
+    extern void bga_present(void);
+    bga_present();
+    
+    klog(KLOG_DEBUG, "KERNEL", "Finished drawing loading screen");
     
     // Initialize PS/2 mouse driver AFTER BGA
-    serial_print("[KERNEL] About to enable mouse IRQ\n");
     extern void irq_enable_mouse(void);
     irq_enable_mouse();
+    klog(KLOG_DEBUG, "KERNEL", "After mouse enable: pic_mask=%04x", irq_get_pic_mask());
     
-    // Check BOTH PIC masks after mouse enable
-    unsigned char m1 = inb(0x21);
-    unsigned char s1 = inb(0xA1);
-    serial_print("[KERNEL] After mouse enable: master=");
-    serial_hex(m1);
-    serial_print(" slave=");
-    serial_hex(s1);
-    serial_print("\n");
-    
-    serial_print("[KERNEL] About to call mouse_init\n");
     extern int mouse_init(void);
     mouse_init();
-    serial_print("[KERNEL] Mouse init completed\n");
+    klog(KLOG_INFO, "KERNEL", "Mouse init completed");
+    
+    // Keyboard shares the 8042 - set it up once the mouse has configured it
+    extern void keyboard_init(void);
+    keyboard_init();
+    extern void irq_enable_keyboard(void);
+    irq_enable_keyboard();
+    klog(KLOG_INFO, "KERNEL", "Keyboard init completed");
+    
+    // USB HID pointer (QEMU usb-tablet) - polled from a kernel timer
+    extern void usb_init(void);
+    usb_init();
     
     // Start Ring 3 processes
-    serial_print("[KERNEL] About to create sysman process\n");
-    serial_print("[KERNEL] Module count: ");
-    serial_hex(mbi->mods_count);
-    serial_print("\n");
+    klog(KLOG_DEBUG, "KERNEL", "Module count: %u", mbi->mods_count);
     
     if (mbi->mods_count >= 2) {
-        serial_print("[KERNEL] Loading modules...\n");
-        serial_print("[KERNEL] mods_addr: 0x");
-        serial_hex((mbi->mods_addr >> 24) & 0xFF);
-        serial_hex((mbi->mods_addr >> 16) & 0xFF);
-        serial_hex((mbi->mods_addr >> 8) & 0xFF);
-        serial_hex(mbi->mods_addr & 0xFF);
-        serial_print("\n");
-        
         struct multiboot_module *modules = (struct multiboot_module *)mbi->mods_addr;
-        serial_print("[KERNEL] Getting sysman address...\n");
         uint32_t sysman_addr = modules[0].mod_start;
-        serial_print("[KERNEL] sysman at 0x");
-        serial_hex((sysman_addr >> 24) & 0xFF);
-        serial_hex((sysman_addr >> 16) & 0xFF);
-        serial_hex((sysman_addr >> 8) & 0xFF);
-        serial_hex(sysman_addr & 0xFF);
-        serial_print("\n");
-        
-        serial_print("[KERNEL] Getting orbit address...\n");
         uint32_t orbit_addr = modules[1].mod_start;
         uint32_t orbit_end = modules[1].mod_end;
         uint32_t orbit_size = orbit_end - orbit_addr;
-        serial_print("[KERNEL] orbit at 0x");
-        serial_hex((orbit_addr >> 24) & 0xFF);
-        serial_hex((orbit_addr >> 16) & 0xFF);
-        serial_hex((orbit_addr >> 8) & 0xFF);
-        serial_hex(orbit_addr & 0xFF);
-        serial_print(" size=");
-        serial_hex((orbit_size >> 24) & 0xFF);
-        serial_hex((orbit_size >> 16) & 0xFF);
-        serial_hex((orbit_size >> 8) & 0xFF);
-        serial_hex(orbit_size & 0xFF);
-        serial_print("\n");
+        klog(KLOG_INFO, "KERNEL", "sysman at 0x%08x, orbit at 0x%08x size=0x%08x",
+             sysman_addr, orbit_addr, orbit_size);
         
         // Copy orbit to its linked address (0x00300000)
-        serial_print("[KERNEL] Copying orbit to 0x00300000...\n");
         uint8_t *src = (uint8_t *)orbit_addr;
         uint8_t *dst = (uint8_t *)0x00300000;
         for (uint32_t i = 0; i < orbit_size; i++) {
             dst[i] = src[i];
         }
-        serial_print("[KERNEL] Orbit copied\n");
+        klog(KLOG_DEBUG, "KERNEL", "Orbit copied to 0x00300000");
         
         extern unsigned int orbit_module_address;
         orbit_module_address = 0x00300000;  // Use the copied location
         
         // Disable interrupts before process creation to prevent timer from firing
-        serial_print("[KERNEL] Disabling interrupts for process creation...\n");
         __asm__ volatile("cli");
         
         // Enable scheduler (doesn't need interrupts enabled)
-        serial_print("[KERNEL] Enabling scheduler...\n");
         extern void scheduler_enable(void);
         scheduler_enable();
         
-        // Enable timer IRQ in PIC (but interrupts are disabled so it won't fire yet)
-        serial_print("[KERNEL] Enabling timer IRQ in PIC...\n");
+        // Enable timer IRQ (but interrupts are disabled so it won't fire yet)
         extern void irq_enable_timer(void);
         irq_enable_timer();
+        klog(KLOG_DEBUG, "KERNEL", "After timer enable: pic_mask=%04x", irq_get_pic_mask());
         
-        // Check BOTH PIC masks after timer enable
-        unsigned char m2 = inb(0x21);
-        unsigned char s2 = inb(0xA1);
-        serial_print("[KERNEL] After timer enable: master=");
-        serial_hex(m2);
-        serial_print(" slave=");
-        serial_hex(s2);
-        serial_print("\n");
-        
-        serial_print("[KERNEL] Calling process_create_sysman...\n");
+        klog(KLOG_INFO, "KERNEL", "Starting sysman");
         extern int process_create_sysman(unsigned int address);
-        int result = process_create_sysman(sysman_addr);
-        serial_print("[KERNEL] ERROR: process_create_sysman returned!\n");
+        process_create_sysman(sysman_addr);
+        klog(KLOG_ERROR, "KERNEL", "process_create_sysman returned!");
     } else {
-        serial_print("[KERNEL] ERROR: No modules loaded by bootloader!\n");
+        klog(KLOG_ERROR, "KERNEL", "No modules loaded by bootloader!");
     }
     
-    serial_print("[KERNEL] Entering idle loop\n");
+    klog_flush();
     while(1) {
         asm volatile("hlt");
     }
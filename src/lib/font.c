@@ -0,0 +1,27 @@
+/*
+ * Font helpers - glyph lookup and text metrics
+ */
+
+#include "font.h"
+
+int font_glyph_index(unsigned char c) {
+    if (c < FONT_FIRST_CHAR || c > FONT_LAST_CHAR) {
+        return FONT_MISSING_GLYPH;
+    }
+    return c - FONT_FIRST_CHAR;
+}
+
+int font_advance(unsigned char c, int style) {
+    if (style & FONT_STYLE_PROPORTIONAL) {
+        return font_glyphs[font_glyph_index(c)].advance;
+    }
+    return FONT_CELL_WIDTH;
+}
+
+int font_text_width(const char *str, int style) {
+    int width = 0;
+    while (*str && *str != '\n') {
+        width += font_advance((unsigned char)*str++, style);
+    }
+    return width;
+}
@@ -0,0 +1,57 @@
+/*
+ * MaahiOS Font
+ * Shared 8x16 bitmap font used by the kernel drivers and libgui.
+ * The tables in font_data.c are generated by tools/font_to_c.py from
+ * tools/font/maahi_8x16.txt.
+ */
+
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+
+#define FONT_HEIGHT         16
+#define FONT_CELL_WIDTH     8      // Monospaced cell
+#define FONT_FIRST_CHAR     0x20
+#define FONT_LAST_CHAR      0x7E
+#define FONT_GLYPH_COUNT    96     // Printable ASCII + "missing" glyph
+#define FONT_MISSING_GLYPH  95
+
+/* Text styles (bit flags) */
+#define FONT_STYLE_MONO         0x00
+#define FONT_STYLE_PROPORTIONAL 0x01   // Advance by ink width + 1 pixel
+#define FONT_STYLE_ANTIALIAS    0x02   // 4-bit alpha edges, blended
+
+/*
+ * Glyph metrics
+ * Bitmap rows (font_bitmap, 16 per glyph) are shifted so bit 7 is the
+ * first ink column; draw them at x + bearing in a monospaced cell or at
+ * x when proportional. Alpha rows are 4bpp, high nibble first.
+ */
+typedef struct {
+    uint16_t alpha;     // Offset of the glyph in font_alpha
+    uint8_t width;      // Ink width (0-8)
+    uint8_t bearing;    // Ink offset within the 8-pixel cell
+    uint8_t advance;    // Proportional advance
+} font_glyph_t;
+
+extern const font_glyph_t font_glyphs[FONT_GLYPH_COUNT];
+extern const uint8_t font_bitmap[FONT_GLYPH_COUNT * FONT_HEIGHT];
+extern const uint8_t font_alpha[];
+
+/* Glyph index for a character (unknown characters get the missing glyph) */
+int font_glyph_index(unsigned char c);
+
+/* Horizontal advance of a character in the given style */
+int font_advance(unsigned char c, int style);
+
+/* Width in pixels of a single line of text */
+int font_text_width(const char *str, int style);
+
+/* 4-bit alpha of ink column col, row row (0-15) */
+static inline int font_alpha_at(const font_glyph_t *glyph, int row, int col) {
+    uint8_t pair = font_alpha[glyph->alpha + row * ((glyph->width + 1) / 2) + col / 2];
+    return (col & 1) ? (pair & 0x0F) : (pair >> 4);
+}
+
+#endif // FONT_H
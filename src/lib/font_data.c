@@ -0,0 +1,484 @@
+/*
+ * Generated by tools/font_to_c.py from tools/font/maahi_8x16.txt
+ * Do not edit - change the font source and rebuild
+ */
+
+#include "font.h"
+
+const font_glyph_t font_glyphs[FONT_GLYPH_COUNT] = {
+    {     0, 0, 0, 4 },  // ' '
+    {     0, 4, 2, 5 },  // '!'
+    {    32, 6, 1, 7 },  // '"'
+    {    80, 8, 0, 9 },  // '#'
+    {   144, 6, 1, 7 },  // '$'
+    {   192, 6, 1, 7 },  // '%'
+    {   240, 7, 0, 8 },  // '&'
+    {   304, 3, 2, 4 },  // "'"
+    {   336, 4, 2, 5 },  // '('
+    {   368, 4, 2, 5 },  // ')'
+    {   400, 8, 0, 9 },  // '*'
+    {   464, 6, 1, 7 },  // '+'
+    {   512, 3, 2, 4 },  // ','
+    {   544, 6, 1, 7 },  // '-'
+    {   592, 2, 3, 3 },  // '.'
+    {   608, 6, 1, 7 },  // '/'
+    {   656, 6, 1, 7 },  // '0'
+    {   704, 6, 1, 7 },  // '1'
+    {   752, 6, 1, 7 },  // '2'
+    {   800, 6, 1, 7 },  // '3'
+    {   848, 6, 1, 7 },  // '4'
+    {   896, 6, 1, 7 },  // '5'
+    {   944, 6, 1, 7 },  // '6'
+    {   992, 6, 1, 7 },  // '7'
+    {  1040, 6, 1, 7 },  // '8'
+    {  1088, 6, 1, 7 },  // '9'
+    {  1136, 2, 3, 3 },  // ':'
+    {  1152, 3, 2, 4 },  // ';'
+    {  1184, 5, 2, 6 },  // '<'
+    {  1232, 6, 1, 7 },  // '='
+    {  1280, 5, 1, 6 },  // '>'
+    {  1328, 6, 1, 7 },  // '?'
+    {  1376, 6, 1, 7 },  // '@'
+    {  1424, 6, 1, 7 },  // 'A'
+    {  1472, 6, 1, 7 },  // 'B'
+    {  1520, 6, 1, 7 },  // 'C'
+    {  1568, 6, 1, 7 },  // 'D'
+    {  1616, 6, 1, 7 },  // 'E'
+    {  1664, 6, 1, 7 },  // 'F'
+    {  1712, 6, 1, 7 },  // 'G'
+    {  1760, 6, 1, 7 },  // 'H'
+    {  1808, 6, 1, 7 },  // 'I'
+    {  1856, 6, 1, 7 },  // 'J'
+    {  1904, 6, 1, 7 },  // 'K'
+    {  1952, 6, 1, 7 },  // 'L'
+    {  2000, 7, 1, 8 },  // 'M'
+    {  2064, 6, 1, 7 },  // 'N'
+    {  2112, 6, 1, 7 },  // 'O'
+    {  2160, 6, 1, 7 },  // 'P'
+    {  2208, 6, 1, 7 },  // 'Q'
+    {  2256, 6, 1, 7 },  // 'R'
+    {  2304, 6, 1, 7 },  // 'S'
+    {  2352, 6, 1, 7 },  // 'T'
+    {  2400, 6, 1, 7 },  // 'U'
+    {  2448, 6, 1, 7 },  // 'V'
+    {  2496, 7, 1, 8 },  // 'W'
+    {  2560, 6, 1, 7 },  // 'X'
+    {  2608, 6, 1, 7 },  // 'Y'
+    {  2656, 6, 1, 7 },  // 'Z'
+    {  2704, 4, 2, 5 },  // '['
+    {  2736, 6, 1, 7 },  // '\\'
+    {  2784, 4, 2, 5 },  // ']'
+    {  2816, 6, 1, 7 },  // '^'
+    {  2864, 8, 0, 9 },  // '_'
+    {  2928, 3, 2, 4 },  // '`'
+    {  2960, 6, 1, 7 },  // 'a'
+    {  3008, 6, 1, 7 },  // 'b'
+    {  3056, 6, 1, 7 },  // 'c'
+    {  3104, 6, 1, 7 },  // 'd'
+    {  3152, 6, 1, 7 },  // 'e'
+    {  3200, 6, 1, 7 },  // 'f'
+    {  3248, 6, 1, 7 },  // 'g'
+    {  3296, 6, 1, 7 },  // 'h'
+    {  3344, 4, 2, 5 },  // 'i'
+    {  3376, 5, 1, 6 },  // 'j'
+    {  3424, 6, 1, 7 },  // 'k'
+    {  3472, 4, 2, 5 },  // 'l'
+    {  3504, 7, 1, 8 },  // 'm'
+    {  3568, 6, 1, 7 },  // 'n'
+    {  3616, 6, 1, 7 },  // 'o'
+    {  3664, 6, 1, 7 },  // 'p'
+    {  3712, 6, 1, 7 },  // 'q'
+    {  3760, 6, 1, 7 },  // 'r'
+    {  3808, 6, 1, 7 },  // 's'
+    {  3856, 6, 1, 7 },  // 't'
+    {  3904, 6, 1, 7 },  // 'u'
+    {  3952, 6, 1, 7 },  // 'v'
+    {  4000, 7, 1, 8 },  // 'w'
+    {  4064, 6, 1, 7 },  // 'x'
+    {  4112, 6, 1, 7 },  // 'y'
+    {  4160, 6, 1, 7 },  // 'z'
+    {  4208, 6, 1, 7 },  // '{'
+    {  4256, 2, 3, 3 },  // '|'
+    {  4272, 6, 1, 7 },  // '}'
+    {  4320, 7, 0, 8 },  // '~'
+    {  4384, 6, 1, 7 },  // missing
+};
+
+const uint8_t font_bitmap[FONT_GLYPH_COUNT * FONT_HEIGHT] = {
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0xF0, 0xF0, 0xF0, 0x60, 0x60, 0x60, 0x00, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x66, 0x66, 0xFF, 0x66, 0x66, 0xFF, 0x66, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x30, 0x78, 0xFC, 0xF0, 0x70, 0x30, 0x38, 0x3C, 0xFC, 0x78, 0x30, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xC4, 0xCC, 0x18, 0x30, 0x60, 0xCC, 0x8C, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x38, 0x6C, 0x6C, 0x38, 0x76, 0xDC, 0xCC, 0xCC, 0x76, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x60, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x60, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0x60, 0x30, 0x30, 0x30, 0x30, 0x30, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x66, 0x3C, 0xFF, 0x3C, 0x66, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x30, 0x30, 0xFC, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xCC, 0xDC, 0xEC, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x70, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xCC, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0x0C, 0x18, 0x30, 0x18, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x18, 0x38, 0x78, 0xD8, 0xD8, 0xFC, 0x18, 0x18, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0xC0, 0xC0, 0xF8, 0x0C, 0x0C, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xC0, 0xC0, 0xF8, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0x0C, 0x18, 0x18, 0x30, 0x30, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x60, 0x00, 0x00, 0x60, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x18, 0x30, 0x60, 0xC0, 0x60, 0x30, 0x18, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xFC, 0x00, 0x00, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0xC0, 0x60, 0x30, 0x18, 0x30, 0x60, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0x0C, 0x18, 0x30, 0x30, 0x00, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xDC, 0xD4, 0xD4, 0xDC, 0xC0, 0xC4, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x78, 0xCC, 0xCC, 0xCC, 0xFC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0xCC, 0xCC, 0xCC, 0xF8, 0xCC, 0xCC, 0xCC, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0xD8, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xD8, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0xC0, 0xC0, 0xC0, 0xF8, 0xC0, 0xC0, 0xC0, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0xC0, 0xC0, 0xC0, 0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xC0, 0xC0, 0xDC, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xFC, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x3C, 0x18, 0x18, 0x18, 0x18, 0x18, 0xD8, 0xD8, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xD8, 0xF0, 0xE0, 0xF0, 0xD8, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC6, 0xEE, 0xFE, 0xD6, 0xC6, 0xC6, 0xC6, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xEC, 0xFC, 0xDC, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0xCC, 0xCC, 0xCC, 0xF8, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF8, 0xCC, 0xCC, 0xCC, 0xF8, 0xD8, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x78, 0xCC, 0xC0, 0x60, 0x30, 0x18, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC6, 0xC6, 0xC6, 0xD6, 0xD6, 0xFE, 0xEE, 0xC6, 0xC6, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0x78, 0x30, 0x30, 0x78, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x30, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xC0, 0xC0, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0x60, 0x60, 0x30, 0x30, 0x18, 0x18, 0x0C, 0x0C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xF0, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0x30, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x30, 0x78, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0x0C, 0x7C, 0xCC, 0xCC, 0xCC, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xF8, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0xCC, 0xC0, 0xC0, 0xC0, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0C, 0x0C, 0x7C, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0xCC, 0xCC, 0xFC, 0xC0, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x3C, 0x60, 0x60, 0xF8, 0x60, 0x60, 0x60, 0x60, 0x60, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x7C, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xD8, 0xEC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0x00, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x18, 0x00, 0x38, 0x18, 0x18, 0x18, 0x18, 0x18, 0x18, 0xD8, 0x70, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xCC, 0xD8, 0xF0, 0xE0, 0xF0, 0xD8, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xE0, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0x60, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xD8, 0xFC, 0xD6, 0xD6, 0xD6, 0xD6, 0xD6, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xD8, 0xEC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xF8, 0xCC, 0xCC, 0xCC, 0xCC, 0xF8, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x7C, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0x0C, 0x0C, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xD8, 0xEC, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x78, 0xC0, 0x78, 0x0C, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x60, 0x60, 0xF8, 0x60, 0x60, 0x60, 0x60, 0x60, 0x3C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x78, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xC6, 0xC6, 0xD6, 0xD6, 0xD6, 0xFC, 0x6C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0x78, 0x30, 0x78, 0xCC, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xCC, 0xCC, 0xCC, 0xCC, 0xCC, 0x7C, 0x0C, 0xCC, 0x78, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFC, 0x0C, 0x18, 0x30, 0x60, 0xC0, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x1C, 0x30, 0x30, 0x30, 0xE0, 0x30, 0x30, 0x30, 0x1C, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xE0, 0x30, 0x30, 0x30, 0x1C, 0x30, 0x30, 0x30, 0xE0, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x76, 0xDC, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFC, 0x84, 0x84, 0x84, 0x84, 0x84, 0x84, 0x84, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+const uint8_t font_alpha[4432] = {
+    0x00, 0x00, 0x00, 0x00, 0x4B, 0xB4, 0xBF, 0xFB, 0xFF, 0xFF, 0xBF, 0xFB, 0x4F, 0xF4, 0x0F, 0xF0,
+    0x0B, 0xB0, 0x00, 0x00, 0x0B, 0xB0, 0x0B, 0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x00, 0xFF, 0xBB, 0x00, 0xBB, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xB0, 0x0B, 0xB0,
+    0x4F, 0xF4, 0x4F, 0xF4, 0xFF, 0xFF, 0xFF, 0xFF, 0x4F, 0xF4, 0x4F, 0xF4, 0x4F, 0xF4, 0x4F, 0xF4,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x4F, 0xF4, 0x4F, 0xF4, 0x0B, 0xB0, 0x0B, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x04, 0xBB, 0x40, 0x4B, 0xFF, 0xB4, 0xBF, 0xFF, 0xFF, 0xBF, 0xFF, 0x40, 0x4B,
+    0xFF, 0x00, 0x04, 0xFF, 0x40, 0x00, 0xFF, 0xB4, 0x04, 0xFF, 0xFB, 0xFF, 0xFF, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x04, 0xBB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x4F, 0xBB, 0x04, 0xBB, 0x00,
+    0x4B, 0xB4, 0x04, 0xBB, 0x40, 0x4B, 0xB4, 0x00, 0xBB, 0x40, 0xBB, 0xF4, 0x00, 0xBB, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBF, 0xB4, 0x00, 0x0B, 0xF0, 0xFB, 0x00,
+    0x0B, 0xF0, 0xFB, 0x00, 0x00, 0xFF, 0xB0, 0x00, 0x4B, 0xFF, 0x0B, 0xF0, 0xBF, 0x0B, 0xFF, 0x40,
+    0xFF, 0x04, 0xFF, 0x00, 0xBF, 0x44, 0xBF, 0x40, 0x4B, 0xFF, 0x0B, 0xF0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0B, 0xB0, 0x4F, 0xB0, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x04, 0xBF, 0x4B, 0xB4, 0xBF, 0x40, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+    0xBF, 0x40, 0x4B, 0xB4, 0x04, 0xBF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFB, 0x40, 0x4B, 0xB4, 0x04, 0xFB, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+    0x04, 0xFB, 0x4B, 0xB4, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x0F, 0xB4, 0x4B, 0xF0, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00,
+    0x0F, 0xB4, 0x4B, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x04,
+    0xFF, 0x40, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0x40, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x0B, 0xB0, 0x4F, 0xB0, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBF, 0x00, 0x0B, 0xF4, 0x00, 0x4F, 0xB0, 0x00,
+    0xBF, 0x40, 0x04, 0xFB, 0x00, 0x0B, 0xF4, 0x00, 0x4F, 0xB0, 0x00, 0xBF, 0x40, 0x00, 0xBB, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x04, 0xFF, 0xFF,
+    0x0F, 0xFF, 0xFF, 0xF0, 0xFF, 0xFF, 0x40, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBB, 0x00, 0x0F, 0xFF, 0x00, 0x04, 0xFF, 0x00, 0x00,
+    0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x04, 0xFF, 0x40, 0xFF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xFB, 0x44, 0xFB, 0x00, 0x04, 0xFB, 0x00,
+    0x4B, 0xB4, 0x04, 0xBB, 0x40, 0x4B, 0xB4, 0x00, 0xBF, 0x40, 0x00, 0xFF, 0x44, 0xBB, 0xBF, 0xFF,
+    0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xFB, 0x44, 0xFB, 0x00, 0x04, 0xFB, 0x00,
+    0x4B, 0xB4, 0x00, 0xFF, 0x00, 0x00, 0x4B, 0xB4, 0x00, 0x04, 0xFB, 0xFB, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xB0, 0x04, 0xBF, 0xF0, 0x4B, 0xFF, 0xF0, 0xBF,
+    0x0F, 0xF0, 0xFF, 0x0F, 0xF4, 0xBF, 0xFF, 0xFF, 0x00, 0x4F, 0xF4, 0x00, 0x0F, 0xF0, 0x00, 0x0B,
+    0xB0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0xFF, 0x40, 0x00, 0xBF,
+    0xFF, 0xB4, 0x00, 0x04, 0xFB, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0xFB, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xBF, 0xFF, 0x00, 0x00, 0xFF,
+    0x40, 0x00, 0xFF, 0xFF, 0xB4, 0xFF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFB, 0x00, 0x00, 0xFB, 0x00, 0x0B, 0xF4, 0x00,
+    0x4F, 0xB0, 0x00, 0xBF, 0x40, 0x04, 0xFB, 0x00, 0x0B, 0xF4, 0x00, 0x0F, 0xF0, 0x00, 0x0B, 0xB0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xBF,
+    0x44, 0xFB, 0x0F, 0xFF, 0xF0, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xBF,
+    0x44, 0xFF, 0x4B, 0xFF, 0xFF, 0x00, 0x04, 0xFF, 0x00, 0x00, 0xFF, 0xFB, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0xBB, 0x00, 0x00, 0xBB, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xB0, 0x0B, 0xB0, 0x00, 0x00,
+    0x00, 0x00, 0x0B, 0xB0, 0x4F, 0xB0, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xF0, 0x04, 0xBB, 0x40, 0x4B,
+    0xB4, 0x00, 0xFF, 0x00, 0x00, 0x4B, 0xB4, 0x00, 0x04, 0xBB, 0x40, 0x00, 0x4B, 0xF0, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF,
+    0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFB, 0x40, 0x00, 0x4B, 0xB4, 0x00, 0x04,
+    0xBB, 0x40, 0x00, 0x0F, 0xF0, 0x04, 0xBB, 0x40, 0x4B, 0xB4, 0x00, 0xFB, 0x40, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xFB, 0x44, 0xFB, 0x00, 0x04, 0xFB, 0x00,
+    0x4B, 0xB4, 0x00, 0xBF, 0x40, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0xBB,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x40, 0xFB, 0xFF, 0x0B, 0xFF, 0xFF,
+    0x0F, 0x0F, 0xFF, 0x0F, 0x0F, 0xFF, 0x0B, 0xFB, 0xFF, 0x00, 0x00, 0xBF, 0x40, 0x4F, 0x4B, 0xFF,
+    0xF4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBB, 0x40, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF,
+    0x00, 0xFF, 0xFF, 0x44, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xB4, 0xFF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF,
+    0x44, 0xFB, 0xFF, 0xFF, 0xF0, 0xFF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF, 0x44, 0xFB, 0xBF, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xBF, 0xFF, 0x00, 0x00, 0xFF,
+    0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBF, 0x44, 0xBF, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFB, 0x40, 0xFF, 0x0B, 0xB4, 0xFF, 0x04, 0xFB, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x04, 0xFB, 0xFF, 0x0B, 0xB4, 0xBF, 0xFB,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+    0x40, 0x00, 0xFF, 0xFF, 0xF0, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x40, 0x00, 0xBF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+    0x40, 0x00, 0xFF, 0xFF, 0xF0, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xBF, 0xFF, 0x00, 0x00, 0xFF,
+    0x00, 0x00, 0xFF, 0x0F, 0xFB, 0xFF, 0x04, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF,
+    0x44, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00,
+    0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x04, 0xFF, 0x40, 0xFF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x00, 0x4F, 0xF4, 0x00, 0x0F, 0xF0, 0x00,
+    0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0xBB, 0x0F, 0xF0, 0xBF, 0x0F, 0xB0, 0x4B, 0xFB,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x04, 0xBF, 0xFF, 0x0B, 0xB4, 0xFF, 0xFB, 0x40, 0xFF,
+    0xF0, 0x00, 0xFF, 0xFB, 0x40, 0xFF, 0x0B, 0xB4, 0xFF, 0x04, 0xFB, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF,
+    0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x40, 0x00, 0xBF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x40, 0x4B, 0xB0, 0xFF, 0xB0, 0xBF, 0xF0,
+    0xFF, 0xFF, 0xFF, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0, 0xFF, 0x00, 0x0F, 0xF0, 0xFF, 0x00, 0x0F, 0xF0,
+    0xFF, 0x00, 0x0F, 0xF0, 0xFF, 0x00, 0x0F, 0xF0, 0xBB, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x40, 0xFF, 0xFF, 0xB0, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0x0B, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xB4, 0xFF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF,
+    0x44, 0xFB, 0xFF, 0xFF, 0xB4, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF, 0xF0, 0x00, 0x4B,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xB4, 0xFF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF,
+    0x44, 0xFB, 0xFF, 0xFF, 0xF4, 0xFF, 0x0B, 0xF4, 0xFF, 0x04, 0xFB, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xBF, 0xBF, 0x40, 0x00, 0x4B,
+    0xB4, 0x00, 0x04, 0xBB, 0x40, 0x00, 0x4B, 0xB4, 0x00, 0x04, 0xFB, 0xFB, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00,
+    0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x04, 0xBB,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x0B, 0xB0, 0xFF, 0x00, 0x0F, 0xF0,
+    0xFF, 0x00, 0x0F, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0, 0xFF, 0xFF, 0xFF, 0xF0,
+    0xFF, 0xB0, 0xBF, 0xF0, 0xFF, 0x40, 0x4F, 0xF0, 0xBB, 0x00, 0x0B, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xBF, 0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x04,
+    0xFF, 0x40, 0x04, 0xFF, 0x40, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B,
+    0xFF, 0xB4, 0x04, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFB, 0x00, 0x00, 0xFB, 0x00, 0x4B, 0xB4, 0x04,
+    0xBB, 0x40, 0x4B, 0xB4, 0x00, 0xBF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x40, 0x00, 0xBF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFF, 0x40, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00,
+    0xFF, 0x00, 0xFF, 0x40, 0xBF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFB, 0x40, 0x00, 0x4F, 0xB0, 0x00, 0x0B, 0xF4, 0x00, 0x04,
+    0xFB, 0x00, 0x00, 0xBF, 0x40, 0x00, 0x4F, 0xB0, 0x00, 0x0B, 0xF4, 0x00, 0x04, 0xFB, 0x00, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xFB, 0x04, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF, 0x00, 0xFF,
+    0x00, 0xFF, 0x04, 0xFF, 0xFF, 0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBB, 0x40, 0x4B, 0xFF, 0xB4, 0xFB, 0x44, 0xBF, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFB, 0x40, 0x4B, 0xF0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xFF, 0xB4, 0x00,
+    0x00, 0xFB, 0x4B, 0xFF, 0xFF, 0xBF, 0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF,
+    0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0xFF, 0x40, 0x00, 0xFF, 0xFF, 0xB4, 0xFF,
+    0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x44, 0xFB, 0xBF, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF,
+    0x44, 0xBF, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBF, 0x44, 0xBF, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x04, 0xFF, 0x4B, 0xFF, 0xFF, 0xBF,
+    0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF,
+    0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF,
+    0x44, 0xFB, 0xFF, 0x44, 0xFF, 0xFF, 0xFF, 0xFB, 0xFF, 0x40, 0x00, 0xBF, 0x44, 0xBF, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0xBF, 0xFF, 0x0B, 0xF4, 0x00, 0x4F, 0xF4, 0x00, 0xFF,
+    0xFF, 0xF0, 0x4F, 0xF4, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0B, 0xB0,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xFB, 0xBF,
+    0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF, 0xFF, 0x00, 0x04,
+    0xFF, 0xFB, 0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x0F, 0xB4, 0xFF,
+    0xF0, 0xFB, 0xFF, 0x40, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0xFF, 0xB0, 0x4F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0,
+    0x0F, 0xF0, 0x4F, 0xF4, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0F, 0xF0, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xB0, 0x00,
+    0x4F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F,
+    0xF0, 0xFB, 0x0F, 0xB0, 0x4B, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x04, 0xBF, 0xFF,
+    0x0B, 0xB4, 0xFF, 0xFB, 0x40, 0xFF, 0xF0, 0x00, 0xFF, 0xFB, 0x40, 0xFF, 0x0B, 0xB4, 0xBB, 0x04,
+    0xBF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0xFF, 0xB0, 0x4F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0, 0x0F, 0xF0,
+    0x0F, 0xF0, 0x4F, 0xF4, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xBB, 0x0B, 0xB4, 0x00, 0xFF, 0xFF, 0xFB, 0x40, 0xFF, 0x0F, 0x0F, 0xB0, 0xFF, 0x0F, 0x0F, 0xF0,
+    0xFF, 0x0F, 0x0F, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0, 0xBB, 0x0F, 0x0B, 0xB0, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x0F, 0xB4, 0xFF,
+    0xF0, 0xFB, 0xFF, 0x40, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xB4, 0xBF,
+    0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xB4, 0xFF,
+    0x44, 0xFB, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x44, 0xFB, 0xFF, 0xFF, 0xB4, 0xFF, 0x40,
+    0x00, 0xFF, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xFB, 0xBF,
+    0x44, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF, 0xFF, 0x00, 0x04,
+    0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x0F, 0xB4, 0xFF,
+    0xF0, 0xBF, 0xFF, 0x40, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBB, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0xF0, 0xFF,
+    0x00, 0x00, 0x4B, 0xFF, 0xB4, 0x00, 0x04, 0xFB, 0x00, 0x00, 0xFF, 0xFB, 0x44, 0xFB, 0x4B, 0xFF,
+    0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0B, 0xB0, 0x00, 0x4F, 0xF4, 0x00, 0xFF, 0xFF, 0xF0, 0x4F,
+    0xF4, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0B, 0xF4, 0x00, 0x04, 0xBF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF,
+    0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x04, 0xBB,
+    0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xBB, 0x00, 0x0B, 0xB0, 0xFF, 0x00, 0x0F, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0, 0xFF, 0x0F, 0x0F, 0xF0,
+    0xFF, 0x0F, 0x0F, 0xB0, 0xBF, 0xFF, 0xFF, 0x40, 0x4B, 0xB0, 0xBB, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xBF,
+    0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x00, 0xFF, 0x00, 0x4B, 0xFF, 0xB4, 0xBF, 0x44, 0xFB, 0xBB, 0x00,
+    0xBB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBB, 0x00, 0xBB, 0xFF,
+    0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xFF, 0x00, 0xFF, 0xBF, 0x44, 0xFF, 0x4B, 0xFF, 0xFF, 0x00, 0x04,
+    0xFF, 0xFB, 0x44, 0xFB, 0x4B, 0xFF, 0xB4, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFB, 0x00,
+    0x00, 0xFB, 0x00, 0x4B, 0xB4, 0x04, 0xBB, 0x40, 0x4B, 0xB4, 0x00, 0xBF, 0x00, 0x00, 0xBF, 0xFF,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4B, 0xFF, 0x00, 0xBF, 0x40, 0x00, 0xFF, 0x00, 0x04,
+    0xFB, 0x00, 0xFF, 0xF0, 0x00, 0x04, 0xFB, 0x00, 0x00, 0xFF, 0x00, 0x00, 0xBF, 0x40, 0x00, 0x4B,
+    0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0xBB, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xBB, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xB4, 0x00, 0x04, 0xFB, 0x00, 0x00, 0xFF, 0x00, 0x00,
+    0xBF, 0x40, 0x00, 0x0F, 0xFF, 0x00, 0xBF, 0x40, 0x00, 0xFF, 0x00, 0x04, 0xFB, 0x00, 0xFF, 0xB4,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x4B, 0xFB, 0x0B, 0xF0, 0xFB, 0x0B, 0xFB, 0x40, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xBF, 0xFF, 0xFB, 0xF4, 0x00, 0x4F, 0xF0, 0x00, 0x0F, 0xF0,
+    0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF0, 0x00, 0x0F, 0xF4, 0x00, 0x4F, 0xBF, 0xFF,
+    0xFB, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
@@ -5,11 +5,11 @@
  * Button and control functions
  */
 
-static GUI_Button button_pool[32];
+static GUI_Button button_pool[GUI_MAX_BUTTONS];
 static int button_count = 0;
 
 GUI_Button* gui_create_button(int x, int y, int width, int height, const char *text) {
-    if (button_count >= 32) return NULL;
+    if (button_count >= GUI_MAX_BUTTONS) return NULL;
     
     GUI_Button *btn = &button_pool[button_count++];
     btn->x = x;
@@ -19,6 +19,8 @@ GUI_Button* gui_create_button(int x, int y, int width, int height, const char *t
     btn->bg_color = GUI_COLOR_GRAY;
     btn->text_color = GUI_COLOR_BLACK;
     btn->pressed = 0;
+    btn->parent = NULL;
+    btn->next_sibling = NULL;
     
     // Copy text
     int i;
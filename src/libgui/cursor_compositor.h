@@ -1,6 +1,6 @@
 /**
  * Cursor Compositor Header
- * Layered cursor rendering with save/restore
+ * Uploads orbit's cursor sprite to the kernel compositor
  */
 
 #ifndef CURSOR_COMPOSITOR_H
@@ -8,14 +8,9 @@
 
 /**
  * Initialize cursor compositor
- * Call once at orbit startup
+ * Call once at orbit startup - the kernel then moves and redraws
+ * the cursor from the mouse IRQ, no per-frame calls needed
  */
 void orbit_cursor_init(void);
 
-/**
- * Draw cursor at position (x, y)
- * Automatically saves/restores background
- */
-void orbit_draw_cursor(int x, int y);
-
 #endif // CURSOR_COMPOSITOR_H
@@ -0,0 +1,201 @@
+#include "libgui.h"
+#include "../syscalls/user_syscalls.h"
+#include <stddef.h>
+
+/**
+ * Damage tracking and composition
+ * Changes to the window tree only record which screen areas are stale;
+ * gui_compose() repaints just those. Each damaged rectangle is handed out
+ * front to back: the top window paints the part it covers, that part is
+ * cut out, and what is left goes to the next window down and finally the
+ * desktop. Moving a window therefore repaints the desktop only where the
+ * window used to be, and nothing under the window's new position.
+ */
+
+#define GUI_DAMAGE_MAX      16      // Rects before collapsing to one
+#define GUI_REGION_MAX      32      // Visible pieces per damaged rect
+
+static GUI_Rect damage[GUI_DAMAGE_MAX];
+static int damage_count = 0;
+static void (*desktop_paint)(void) = NULL;
+
+static int rect_area(int x1, int y1, int x2, int y2) {
+    return (x2 - x1) * (y2 - y1);
+}
+
+static int rect_intersect(const GUI_Rect *a, const GUI_Rect *b, GUI_Rect *out) {
+    out->x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    out->y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    out->x2 = a->x2 < b->x2 ? a->x2 : b->x2;
+    out->y2 = a->y2 < b->y2 ? a->y2 : b->y2;
+    return out->x1 < out->x2 && out->y1 < out->y2;
+}
+
+/**
+ * r minus hole as up to 4 rectangles (bands above/below, then left/right)
+ */
+static int rect_subtract(const GUI_Rect *r, const GUI_Rect *hole, GUI_Rect *out) {
+    GUI_Rect cut;
+    if (!rect_intersect(r, hole, &cut)) {
+        out[0] = *r;
+        return 1;
+    }
+
+    int count = 0;
+    if (r->y1 < cut.y1) out[count++] = (GUI_Rect){ r->x1, r->y1, r->x2, cut.y1 };
+    if (cut.y2 < r->y2) out[count++] = (GUI_Rect){ r->x1, cut.y2, r->x2, r->y2 };
+    if (r->x1 < cut.x1) out[count++] = (GUI_Rect){ r->x1, cut.y1, cut.x1, cut.y2 };
+    if (cut.x2 < r->x2) out[count++] = (GUI_Rect){ cut.x2, cut.y1, r->x2, cut.y2 };
+    return count;
+}
+
+static GUI_Rect window_rect(const GUI_Window *win) {
+    return (GUI_Rect){ win->x, win->y, win->x + win->width, win->y + win->height };
+}
+
+/**
+ * Desktop painter - draws the whole desktop; the compositor clips it
+ */
+void gui_set_desktop_paint(void (*paint)(void)) {
+    desktop_paint = paint;
+}
+
+/**
+ * Mark a screen area for repainting
+ * Rectangles merge when the union costs no more to repaint than the parts
+ */
+void gui_invalidate(int x, int y, int width, int height) {
+    if (width <= 0 || height <= 0) return;
+    int x1 = x, y1 = y, x2 = x + width, y2 = y + height;
+
+    int i = 0;
+    while (i < damage_count) {
+        GUI_Rect *r = &damage[i];
+        if (x1 <= r->x2 && r->x1 <= x2 && y1 <= r->y2 && r->y1 <= y2 &&
+            rect_area(r->x1 < x1 ? r->x1 : x1, r->y1 < y1 ? r->y1 : y1,
+                      r->x2 > x2 ? r->x2 : x2, r->y2 > y2 ? r->y2 : y2) <=
+            rect_area(x1, y1, x2, y2) + rect_area(r->x1, r->y1, r->x2, r->y2)) {
+            if (r->x1 < x1) x1 = r->x1;
+            if (r->y1 < y1) y1 = r->y1;
+            if (r->x2 > x2) x2 = r->x2;
+            if (r->y2 > y2) y2 = r->y2;
+            damage[i] = damage[--damage_count];
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+
+    if (damage_count == GUI_DAMAGE_MAX) {
+        // List full - collapse everything into one bounding box
+        for (i = 0; i < damage_count; i++) {
+            if (damage[i].x1 < x1) x1 = damage[i].x1;
+            if (damage[i].y1 < y1) y1 = damage[i].y1;
+            if (damage[i].x2 > x2) x2 = damage[i].x2;
+            if (damage[i].y2 > y2) y2 = damage[i].y2;
+        }
+        damage_count = 0;
+    }
+
+    damage[damage_count++] = (GUI_Rect){ x1, y1, x2, y2 };
+}
+
+void gui_invalidate_window(GUI_Window *win) {
+    if (win && win->visible) gui_invalidate(win->x, win->y, win->width, win->height);
+}
+
+/**
+ * A button changed - only its own rectangle is stale
+ */
+void gui_invalidate_button(GUI_Button *btn) {
+    if (!btn) return;
+    if (btn->parent && !btn->parent->visible) return;
+    gui_invalidate(btn->x, btn->y, btn->width, btn->height);
+}
+
+static void paint_desktop(const GUI_Rect *r) {
+    if (gui_push_clip(r->x1, r->y1, r->x2 - r->x1, r->y2 - r->y1) < 0) return;
+    if (desktop_paint) {
+        desktop_paint();
+    } else {
+        gui_draw_filled_rect(r->x1, r->y1, r->x2 - r->x1, r->y2 - r->y1, GUI_DESKTOP_COLOR);
+    }
+    gui_pop_clip();
+}
+
+static void paint_window(GUI_Window *win, const GUI_Rect *r) {
+    if (gui_push_clip(r->x1, r->y1, r->x2 - r->x1, r->y2 - r->y1) < 0) return;
+    gui_paint_window(win);
+    gui_pop_clip();
+}
+
+/**
+ * Repaint one damaged rect front to back
+ * Returns the pieces painted, or -1 if the region got too fragmented
+ */
+static int compose_rect(const GUI_Rect *d) {
+    GUI_Rect region[GUI_REGION_MAX];
+    GUI_Rect next[GUI_REGION_MAX];
+    int count = 1;
+    int painted = 0;
+    region[0] = *d;
+
+    for (GUI_Window *win = gui_window_top(); win && count > 0; win = win->below) {
+        if (!win->visible) continue;
+        GUI_Rect wr = window_rect(win);
+
+        int next_count = 0;
+        for (int i = 0; i < count; i++) {
+            GUI_Rect piece;
+            if (rect_intersect(&region[i], &wr, &piece)) {
+                paint_window(win, &piece);
+                painted++;
+            }
+            if (next_count + 4 > GUI_REGION_MAX) return -1;
+            next_count += rect_subtract(&region[i], &wr, &next[next_count]);
+        }
+        for (int i = 0; i < next_count; i++) region[i] = next[i];
+        count = next_count;
+    }
+
+    // Whatever no window covers is desktop
+    for (int i = 0; i < count; i++) {
+        paint_desktop(&region[i]);
+        painted++;
+    }
+    return painted;
+}
+
+/**
+ * Painter's algorithm over one damaged rect (fallback, always correct)
+ */
+static int compose_rect_back_to_front(const GUI_Rect *d) {
+    GUI_Window *win = gui_window_top();
+    int painted = 1;
+
+    paint_desktop(d);
+    while (win && win->below) win = win->below;
+    for (; win; win = win->above) {
+        GUI_Rect piece;
+        GUI_Rect wr = window_rect(win);
+        if (win->visible && rect_intersect(d, &wr, &piece)) {
+            paint_window(win, &piece);
+            painted++;
+        }
+    }
+    return painted;
+}
+
+int gui_compose(void) {
+    int painted = 0;
+
+    for (int i = 0; i < damage_count; i++) {
+        int pieces = compose_rect(&damage[i]);
+        if (pieces < 0) pieces = compose_rect_back_to_front(&damage[i]);
+        painted += pieces;
+    }
+    damage_count = 0;
+
+    if (painted) gui_present();
+    return painted;
+}
@@ -21,3 +21,23 @@ void gui_draw_text(int x, int y, const char *text, uint32_t fg, uint32_t bg) {
 void gui_clear_screen(uint32_t color) {
     syscall_gfx_clear_color(color);
 }
+
+void gui_present(void) {
+    syscall_gfx_present();
+}
+
+void gui_draw_hline(int x, int y, int length, uint32_t color) {
+    syscall_gfx_hline(x, y, length, color);
+}
+
+void gui_draw_vline(int x, int y, int length, uint32_t color) {
+    syscall_gfx_vline(x, y, length, color);
+}
+
+int gui_push_clip(int x, int y, int width, int height) {
+    return syscall_gfx_clip_push(x, y, width, height);
+}
+
+int gui_pop_clip(void) {
+    return syscall_gfx_clip_pop();
+}
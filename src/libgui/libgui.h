@@ -21,28 +21,54 @@
 #define GUI_COLOR_TEAL          0xFF008080
 #define GUI_COLOR_NAVY          0xFF000080
 
-/* Window Structure */
-typedef struct {
+/* Screen size (the kernel sets 1024x768x32) */
+#define GUI_SCREEN_WIDTH        1024
+#define GUI_SCREEN_HEIGHT       768
+
+/* Pool sizes (no user-space heap yet) */
+#define GUI_MAX_WINDOWS         8
+#define GUI_MAX_BUTTONS         32
+
+/* Desktop colour when no desktop painter is set */
+#define GUI_DESKTOP_COLOR       0x001020
+
+struct GUI_Button;
+
+/* Window Structure
+ * Windows form a z-ordered list (below -> above); each owns a list of
+ * child buttons kept in screen coordinates. */
+typedef struct GUI_Window {
     int x, y;
     int width, height;
     char title[64];
     uint32_t bg_color;
     uint32_t title_color;
     int visible;
+    int in_use;                         // Pool slot taken
+    struct GUI_Window *below, *above;   // Z-order neighbours
+    struct GUI_Button *children;        // Buttons, drawn after the client
+    void (*paint)(struct GUI_Window *win);  // Client contents (optional)
 } GUI_Window;
 
 // Icons are now rendered via BMP files - no struct needed
 
 /* Button Structure */
-typedef struct {
+typedef struct GUI_Button {
     int x, y;
     int width, height;
     char text[32];
     uint32_t bg_color;
     uint32_t text_color;
     int pressed;
+    struct GUI_Window *parent;          // Owning window, NULL = desktop
+    struct GUI_Button *next_sibling;
 } GUI_Button;
 
+/* Screen rectangle - right/bottom exclusive */
+typedef struct {
+    int x1, y1, x2, y2;
+} GUI_Rect;
+
 // Desktop management removed - orbit draws directly
 
 /* ============================================
@@ -52,6 +78,24 @@ void gui_draw_filled_rect(int x, int y, int width, int height, uint32_t color);
 void gui_draw_rect(int x, int y, int width, int height, uint32_t color);
 void gui_draw_text(int x, int y, const char *text, uint32_t fg, uint32_t bg);
 void gui_clear_screen(uint32_t color);
+void gui_present(void);
+void gui_draw_hline(int x, int y, int length, uint32_t color);
+void gui_draw_vline(int x, int y, int length, uint32_t color);
+
+/* Styled text (text.c) - style is FONT_STYLE_* from lib/font.h
+ * Draw returns the pen x after the text; width measures one line */
+#define GUI_TEXT_UI             0x03   // Proportional + anti-aliased
+int gui_draw_text_styled(int x, int y, const char *text, uint32_t fg, uint32_t bg, int style);
+int gui_text_width(const char *text, int style);
+
+/* Sprites (sprite.c) - IDs are ICON_SPRITE_* from libraries/icons/icon_atlas.h
+ * Return 0 for an unknown ID */
+int gui_draw_sprite(int id, int x, int y);
+int gui_sprite_size(int id, int *width, int *height);
+
+/* Clip stack - pushes nest (intersect); pop after every successful push */
+int gui_push_clip(int x, int y, int width, int height);
+int gui_pop_clip(void);
 
 /* ============================================
  * Window Functions (window.c)
@@ -60,6 +104,33 @@ GUI_Window* gui_create_window(int x, int y, int width, int height, const char *t
 void gui_draw_window(GUI_Window *win);
 void gui_draw_window_title_bar(GUI_Window *win);
 void gui_free_window(GUI_Window *win);
+void gui_window_client_rect(GUI_Window *win, int *x, int *y, int *width, int *height);
+int gui_window_begin_client(GUI_Window *win);
+void gui_window_end_client(GUI_Window *win);
+
+/* Retained window tree (window.c) - z-order, hit testing and geometry
+ * changes; every change invalidates what it uncovers or covers */
+void gui_paint_window(GUI_Window *win);
+GUI_Window* gui_window_top(void);
+GUI_Window* gui_window_at(int x, int y);
+int gui_window_hit_title(GUI_Window *win, int x, int y);
+void gui_window_raise(GUI_Window *win);
+void gui_window_move(GUI_Window *win, int x, int y);
+void gui_window_set_visible(GUI_Window *win, int visible);
+void gui_window_add_button(GUI_Window *win, GUI_Button *btn);
+
+/* ============================================
+ * Damage and composition (damage.c)
+ * ============================================
+ * Invalidate marks screen areas stale; gui_compose() repaints only those,
+ * front to back: each damaged rect is split by the windows above so every
+ * pixel is painted by the one window (or the desktop) that shows there.
+ * Returns the number of pieces painted, then presents. */
+void gui_set_desktop_paint(void (*paint)(void));
+void gui_invalidate(int x, int y, int width, int height);
+void gui_invalidate_window(GUI_Window *win);
+void gui_invalidate_button(GUI_Button *btn);
+int gui_compose(void);
 
 /* ============================================
  * Button Functions (controls.c)
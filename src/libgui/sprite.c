@@ -0,0 +1,27 @@
+#include "libgui.h"
+#include "../syscalls/user_syscalls.h"
+#define ICON_ATLAS_DATA
+#include "icon_atlas.h"
+
+/**
+ * Sprites from the preconverted icon atlas
+ * The atlas is premultiplied and top-down, so drawing is a single blit
+ * of the sprite's rectangle straight out of the atlas.
+ */
+
+int gui_draw_sprite(int id, int x, int y) {
+    if (id < 0 || id >= ICON_SPRITE_COUNT) return 0;
+    
+    const icon_sprite_t *sprite = &icon_sprites[id];
+    syscall_gfx_blit_premul(x, y, sprite->width, sprite->height,
+                            &icon_atlas[sprite->y * ICON_ATLAS_WIDTH + sprite->x], ICON_ATLAS_WIDTH);
+    return 1;
+}
+
+int gui_sprite_size(int id, int *width, int *height) {
+    if (id < 0 || id >= ICON_SPRITE_COUNT) return 0;
+    
+    if (width) *width = icon_sprites[id].width;
+    if (height) *height = icon_sprites[id].height;
+    return 1;
+}
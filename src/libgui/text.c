@@ -0,0 +1,17 @@
+#include "libgui.h"
+#include "../lib/font.h"
+#include "../syscalls/user_syscalls.h"
+
+/**
+ * Styled text
+ * Proportional and anti-aliased text drawn by the kernel from the shared
+ * font; widths are measured locally from the same tables.
+ */
+
+int gui_draw_text_styled(int x, int y, const char *text, uint32_t fg, uint32_t bg, int style) {
+    return syscall_gfx_draw_text(x, y, text, fg, bg, style);
+}
+
+int gui_text_width(const char *text, int style) {
+    return font_text_width(text, style);
+}
@@ -6,13 +6,38 @@
  */
 
 // Simple memory allocation (static for now)
-static GUI_Window window_pool[8];
-static int window_count = 0;
+static GUI_Window window_pool[GUI_MAX_WINDOWS];
+
+// Z-order: bottom of the list is drawn first, top is in front
+static GUI_Window *z_bottom = NULL;
+static GUI_Window *z_top = NULL;
+
+static void z_unlink(GUI_Window *win) {
+    if (win->below) win->below->above = win->above;
+    else z_bottom = win->above;
+    if (win->above) win->above->below = win->below;
+    else z_top = win->below;
+    win->below = win->above = NULL;
+}
+
+static void z_push_top(GUI_Window *win) {
+    win->below = z_top;
+    win->above = NULL;
+    if (z_top) z_top->above = win;
+    else z_bottom = win;
+    z_top = win;
+}
 
 GUI_Window* gui_create_window(int x, int y, int width, int height, const char *title, uint32_t bg_color) {
-    if (window_count >= 8) return NULL;
+    GUI_Window *win = NULL;
+    for (int slot = 0; slot < GUI_MAX_WINDOWS; slot++) {
+        if (!window_pool[slot].in_use) {
+            win = &window_pool[slot];
+            break;
+        }
+    }
+    if (!win) return NULL;
     
-    GUI_Window *win = &window_pool[window_count++];
     win->x = x;
     win->y = y;
     win->width = width;
@@ -20,6 +45,9 @@ GUI_Window* gui_create_window(int x, int y, int width, int height, const char *t
     win->bg_color = bg_color;
     win->title_color = GUI_COLOR_NAVY;
     win->visible = 1;
+    win->in_use = 1;
+    win->children = NULL;
+    win->paint = NULL;
     
     // Copy title
     int i;
@@ -28,15 +56,23 @@ GUI_Window* gui_create_window(int x, int y, int width, int height, const char *t
     }
     win->title[i] = '\0';
     
+    // New windows open in front
+    z_push_top(win);
+    gui_invalidate_window(win);
+    
     return win;
 }
 
+/* Title bar height and border thickness */
+#define GUI_TITLE_HEIGHT    25
+#define GUI_BORDER          2
+
 void gui_draw_window_title_bar(GUI_Window *win) {
     // Draw title bar background (navy blue like Windows 98)
-    gui_draw_filled_rect(win->x, win->y, win->width, 25, 0xFF000080);
+    gui_draw_filled_rect(win->x, win->y, win->width, GUI_TITLE_HEIGHT, 0xFF000080);
     
     // Draw title text (white, transparent background)
-    gui_draw_text(win->x + 5, win->y + 5, win->title, 0xFFFFFFFF, 0);
+    gui_draw_text_styled(win->x + 5, win->y + 5, win->title, 0xFFFFFFFF, 0, GUI_TEXT_UI);
     
     // Draw close button (red X button)
     int close_btn_x = win->x + win->width - 22;
@@ -48,8 +84,11 @@ void gui_draw_window_title_bar(GUI_Window *win) {
 void gui_draw_window(GUI_Window *win) {
     if (!win || !win->visible) return;
     
+    // Nothing (e.g. a long title) may spill outside the frame
+    if (gui_push_clip(win->x, win->y, win->width, win->height) < 0) return;
+    
     // Draw window background
-    gui_draw_filled_rect(win->x, win->y + 25, win->width, win->height - 25, win->bg_color);
+    gui_draw_filled_rect(win->x, win->y + GUI_TITLE_HEIGHT, win->width, win->height - GUI_TITLE_HEIGHT, win->bg_color);
     
     // Draw title bar
     gui_draw_window_title_bar(win);
@@ -57,9 +96,139 @@ void gui_draw_window(GUI_Window *win) {
     // Draw window border (3D effect)
     gui_draw_rect(win->x, win->y, win->width, win->height, GUI_COLOR_BLACK);
     gui_draw_rect(win->x + 1, win->y + 1, win->width - 2, win->height - 2, GUI_COLOR_WHITE);
+    
+    gui_pop_clip();
+}
+
+/**
+ * Client area - inside the border, below the title bar
+ */
+void gui_window_client_rect(GUI_Window *win, int *x, int *y, int *width, int *height) {
+    *x = win->x + GUI_BORDER;
+    *y = win->y + GUI_TITLE_HEIGHT;
+    *width = win->width - 2 * GUI_BORDER;
+    *height = win->height - GUI_TITLE_HEIGHT - GUI_BORDER;
+}
+
+/**
+ * Start drawing window contents - clips everything to the client area
+ * Returns 0 if the clip stack is full (draw nothing, skip end_client)
+ */
+int gui_window_begin_client(GUI_Window *win) {
+    int x, y, width, height;
+    if (!win || !win->visible) return 0;
+    
+    gui_window_client_rect(win, &x, &y, &width, &height);
+    return gui_push_clip(x, y, width, height) >= 0;
+}
+
+void gui_window_end_client(GUI_Window *win) {
+    (void)win;
+    gui_pop_clip();
 }
 
 void gui_free_window(GUI_Window *win) {
-    // Mark as invisible (simple approach)
-    if (win) win->visible = 0;
+    if (!win || !win->in_use) return;
+    
+    // Uncover what was behind it and give the slot back
+    gui_invalidate_window(win);
+    z_unlink(win);
+    win->visible = 0;
+    win->in_use = 0;
+}
+
+/**
+ * Paint a window completely: frame, client contents, then child buttons
+ * Used by the compositor inside a clip, so only the damage is touched
+ */
+void gui_paint_window(GUI_Window *win) {
+    if (!win || !win->visible) return;
+    
+    gui_draw_window(win);
+    if (!gui_window_begin_client(win)) return;
+    if (win->paint) win->paint(win);
+    for (GUI_Button *btn = win->children; btn; btn = btn->next_sibling) {
+        gui_draw_button(btn);
+    }
+    gui_window_end_client(win);
+}
+
+/**
+ * Front-most window (the compositor walks down from here)
+ */
+GUI_Window* gui_window_top(void) {
+    return z_top;
+}
+
+/**
+ * Front-most visible window containing (x, y), NULL for the desktop
+ */
+GUI_Window* gui_window_at(int x, int y) {
+    for (GUI_Window *win = z_top; win; win = win->below) {
+        if (win->visible && x >= win->x && x < win->x + win->width &&
+            y >= win->y && y < win->y + win->height) {
+            return win;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Is (x, y) on the window's title bar (the drag handle)?
+ */
+int gui_window_hit_title(GUI_Window *win, int x, int y) {
+    return win && win->visible && x >= win->x && x < win->x + win->width &&
+           y >= win->y && y < win->y + GUI_TITLE_HEIGHT;
+}
+
+/**
+ * Bring a window to the front
+ * Only the window itself needs repainting - it now covers the others
+ */
+void gui_window_raise(GUI_Window *win) {
+    if (!win || !win->in_use || win == z_top) return;
+    
+    z_unlink(win);
+    z_push_top(win);
+    gui_invalidate_window(win);
+}
+
+/**
+ * Move a window (and its buttons) to (x, y)
+ * Damages the area it leaves and the area it enters - the desktop and
+ * other windows are repainted only where they were uncovered
+ */
+void gui_window_move(GUI_Window *win, int x, int y) {
+    if (!win || !win->in_use || (x == win->x && y == win->y)) return;
+    
+    int dx = x - win->x;
+    int dy = y - win->y;
+    
+    gui_invalidate_window(win);
+    win->x = x;
+    win->y = y;
+    for (GUI_Button *btn = win->children; btn; btn = btn->next_sibling) {
+        btn->x += dx;
+        btn->y += dy;
+    }
+    gui_invalidate_window(win);
+}
+
+void gui_window_set_visible(GUI_Window *win, int visible) {
+    if (!win || !win->in_use || win->visible == !!visible) return;
+    
+    win->visible = !!visible;
+    gui_invalidate(win->x, win->y, win->width, win->height);
+}
+
+/**
+ * Make btn a child of win; btn keeps its screen position
+ */
+void gui_window_add_button(GUI_Window *win, GUI_Button *btn) {
+    if (!win || !btn || btn->parent) return;
+    
+    btn->parent = win;
+    btn->next_sibling = win->children;
+    win->children = btn;
+    gui_invalidate_button(btn);
 }
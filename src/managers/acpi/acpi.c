@@ -0,0 +1,166 @@
+/**
+ * MaahiOS ACPI tables
+ * Only what interrupt routing needs: locate the RSDP, find a table by
+ * signature and decode the MADT (LAPICs, IOAPICs, ISA overrides).
+ */
+
+#include "acpi.h"
+
+extern void paging_map_mmio_region(uint32_t phys_start, uint32_t size);
+
+/* Everything below this is identity mapped by paging_init */
+#define ACPI_IDENTITY_END       0x08000000
+
+#define BDA_EBDA_SEGMENT        0x40E
+#define BIOS_AREA_START         0x000E0000
+#define BIOS_AREA_END           0x00100000
+
+typedef struct {
+    char signature[8];          // "RSD PTR "
+    uint8_t checksum;
+    char oem_id[6];
+    uint8_t revision;           // 0 = ACPI 1.0, 2 = 2.0+ (XSDT fields valid)
+    uint32_t rsdt_address;
+    uint32_t length;
+    uint64_t xsdt_address;
+    uint8_t extended_checksum;
+    uint8_t reserved[3];
+} __attribute__((packed)) acpi_rsdp_t;
+
+typedef struct {
+    acpi_sdt_header_t header;
+    uint32_t lapic_address;
+    uint32_t flags;
+} __attribute__((packed)) acpi_madt_t;
+
+static const acpi_rsdp_t *rsdp = 0;
+
+static int acpi_checksum(const void *data, uint32_t length) {
+    const uint8_t *p = (const uint8_t *)data;
+    uint8_t sum = 0;
+    for (uint32_t i = 0; i < length; i++) sum += p[i];
+    return sum == 0;
+}
+
+static int sig_equal(const char *a, const char *b, int length) {
+    for (int i = 0; i < length; i++) {
+        if (a[i] != b[i]) return 0;
+    }
+    return 1;
+}
+
+/**
+ * Tables live in reserved RAM near the top of memory - map them if that
+ * is past the identity mapping
+ */
+static void acpi_map(uint32_t address, uint32_t length) {
+    if (address + length > ACPI_IDENTITY_END) {
+        paging_map_mmio_region(address, length + (address & 0xFFF));
+    }
+}
+
+/**
+ * Read a 16-bit word from low physical memory
+ * The asm hides the constant address from GCC, which would otherwise
+ * treat it as a pointer into a zero-sized object (-Warray-bounds)
+ */
+static uint16_t peek16(uint32_t address) {
+    const volatile uint16_t *p = (const volatile uint16_t *)address;
+    __asm__("" : "+r"(p));
+    return *p;
+}
+
+static const acpi_rsdp_t *acpi_scan(uint32_t start, uint32_t end) {
+    for (uint32_t addr = start; addr + sizeof(acpi_rsdp_t) <= end; addr += 16) {
+        const acpi_rsdp_t *candidate = (const acpi_rsdp_t *)addr;
+        if (sig_equal(candidate->signature, "RSD PTR ", 8) && acpi_checksum(candidate, 20)) {
+            return candidate;
+        }
+    }
+    return 0;
+}
+
+static const acpi_rsdp_t *acpi_find_rsdp(void) {
+    if (rsdp) return rsdp;
+
+    // First KB of the EBDA, then the BIOS read-only area
+    uint32_t ebda = (uint32_t)peek16(BDA_EBDA_SEGMENT) << 4;
+    if (ebda >= 0x80000 && ebda < 0xA0000) rsdp = acpi_scan(ebda, ebda + 1024);
+    if (!rsdp) rsdp = acpi_scan(BIOS_AREA_START, BIOS_AREA_END);
+    return rsdp;
+}
+
+static const acpi_sdt_header_t *acpi_table_at(uint32_t address) {
+    if (!address) return 0;
+    acpi_map(address, sizeof(acpi_sdt_header_t));
+    const acpi_sdt_header_t *header = (const acpi_sdt_header_t *)address;
+    acpi_map(address, header->length);
+    if (!acpi_checksum(header, header->length)) return 0;
+    return header;
+}
+
+const acpi_sdt_header_t *acpi_find_table(const char *signature) {
+    const acpi_rsdp_t *root = acpi_find_rsdp();
+    if (!root) return 0;
+
+    // XSDT entries are 64-bit; use it only when it is reachable in 32 bits
+    int wide = root->revision >= 2 && root->xsdt_address && !(root->xsdt_address >> 32);
+    const acpi_sdt_header_t *sdt = acpi_table_at(wide ? (uint32_t)root->xsdt_address : root->rsdt_address);
+    if (!sdt) return 0;
+
+    int entry_size = wide ? 8 : 4;
+    int count = (sdt->length - sizeof(acpi_sdt_header_t)) / entry_size;
+    const uint8_t *entries = (const uint8_t *)sdt + sizeof(acpi_sdt_header_t);
+
+    for (int i = 0; i < count; i++) {
+        const uint32_t *entry = (const uint32_t *)(entries + i * entry_size);
+        if (wide && entry[1]) continue;     // Above 4GB
+        const acpi_sdt_header_t *table = acpi_table_at(entry[0]);
+        if (table && sig_equal(table->signature, signature, 4)) return table;
+    }
+    return 0;
+}
+
+int acpi_parse_madt(acpi_madt_info_t *info) {
+    const acpi_madt_t *madt = (const acpi_madt_t *)acpi_find_table("APIC");
+    if (!madt) return 0;
+
+    info->lapic_address = madt->lapic_address;
+    info->flags = madt->flags;
+    info->cpu_count = 0;
+    info->ioapic_count = 0;
+    for (int irq = 0; irq < ACPI_ISA_IRQS; irq++) {
+        info->isa_gsi[irq] = irq;
+        info->isa_flags[irq] = 0;
+    }
+
+    const uint8_t *p = (const uint8_t *)madt + sizeof(acpi_madt_t);
+    const uint8_t *end = (const uint8_t *)madt + madt->header.length;
+    while (p + 2 <= end && p[1] >= 2 && p + p[1] <= end) {
+        switch (p[0]) {
+            case MADT_LOCAL_APIC:
+                // p[2] = processor id, p[3] = APIC id, flags bit 0 = enabled
+                if ((p[4] & 1) && info->cpu_count < ACPI_MAX_CPUS) {
+                    info->cpu_apic_id[info->cpu_count++] = p[3];
+                }
+                break;
+            case MADT_IO_APIC:
+                if (info->ioapic_count < ACPI_MAX_IOAPICS) {
+                    acpi_ioapic_t *io = &info->ioapic[info->ioapic_count++];
+                    io->id = p[2];
+                    io->address = *(const uint32_t *)(p + 4);
+                    io->gsi_base = *(const uint32_t *)(p + 8);
+                }
+                break;
+            case MADT_INT_OVERRIDE:
+                // p[2] = bus (0 = ISA), p[3] = source IRQ
+                if (p[2] == 0 && p[3] < ACPI_ISA_IRQS) {
+                    info->isa_gsi[p[3]] = *(const uint32_t *)(p + 4);
+                    info->isa_flags[p[3]] = *(const uint16_t *)(p + 8);
+                }
+                break;
+        }
+        p += p[1];
+    }
+    return 1;
+}
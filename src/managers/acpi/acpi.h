@@ -0,0 +1,75 @@
+#ifndef ACPI_H
+#define ACPI_H
+
+#include <stdint.h>
+
+/**
+ * ACPI table lookup
+ * Finds the RSDP in the EBDA or the BIOS area, walks the RSDT (or the
+ * XSDT when it is below 4GB) and parses the MADT for interrupt routing.
+ */
+
+#define ACPI_MAX_IOAPICS        4
+#define ACPI_MAX_CPUS           16
+#define ACPI_ISA_IRQS           16
+
+/* MADT entry types */
+#define MADT_LOCAL_APIC         0
+#define MADT_IO_APIC            1
+#define MADT_INT_OVERRIDE       2
+
+/* MPS INTI flags (interrupt source overrides) */
+#define MPS_POLARITY_MASK       0x3
+#define MPS_POLARITY_HIGH       0x1
+#define MPS_POLARITY_LOW        0x3
+#define MPS_TRIGGER_MASK        0xC
+#define MPS_TRIGGER_EDGE        0x4
+#define MPS_TRIGGER_LEVEL       0xC
+
+/* MADT flags */
+#define MADT_PCAT_COMPAT        0x1     // Dual 8259s are present
+
+typedef struct {
+    char signature[4];
+    uint32_t length;
+    uint8_t revision;
+    uint8_t checksum;
+    char oem_id[6];
+    char oem_table_id[8];
+    uint32_t oem_revision;
+    uint32_t creator_id;
+    uint32_t creator_revision;
+} __attribute__((packed)) acpi_sdt_header_t;
+
+typedef struct {
+    uint8_t id;
+    uint32_t address;
+    uint32_t gsi_base;
+} acpi_ioapic_t;
+
+/*
+ * Interrupt routing from the MADT
+ * ISA IRQs without an override map to the same GSI, edge / active high.
+ */
+typedef struct {
+    uint32_t lapic_address;
+    uint32_t flags;
+    int cpu_count;
+    uint8_t cpu_apic_id[ACPI_MAX_CPUS];
+    int ioapic_count;
+    acpi_ioapic_t ioapic[ACPI_MAX_IOAPICS];
+    uint32_t isa_gsi[ACPI_ISA_IRQS];
+    uint16_t isa_flags[ACPI_ISA_IRQS];
+} acpi_madt_info_t;
+
+/**
+ * Table by signature ("APIC", "FACP", ...), 0 if absent or corrupt
+ */
+const acpi_sdt_header_t *acpi_find_table(const char *signature);
+
+/**
+ * Fill info from the MADT; returns 0 if there is no MADT
+ */
+int acpi_parse_madt(acpi_madt_info_t *info);
+
+#endif // ACPI_H
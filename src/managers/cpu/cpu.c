@@ -0,0 +1,128 @@
+#include "cpu.h"
+
+/* Port I/O */
+static inline void outb(unsigned short port, unsigned char val) {
+    __asm__ volatile("outb %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline unsigned char inb(unsigned short port) {
+    unsigned char ret;
+    __asm__ volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+/* PIT channel 2 (speaker gate) used for calibration */
+#define PIT_FREQUENCY       1193182
+#define PIT_CHANNEL2        0x42
+#define PIT_COMMAND         0x43
+#define PIT_GATE_PORT       0x61
+#define CALIBRATE_MS        10
+
+/* Detected features */
+static uint32_t cpuid_edx = 0;
+static int sse_enabled = 0;
+static uint32_t tsc_khz = 0;
+
+/* FXSAVE area - 512 bytes, must be 16-byte aligned */
+static uint8_t fpu_save_area[512] __attribute__((aligned(16)));
+static int fpu_depth = 0;
+
+static void cpuid(uint32_t leaf, uint32_t *eax, uint32_t *ebx, uint32_t *ecx, uint32_t *edx) {
+    __asm__ volatile("cpuid"
+                     : "=a"(*eax), "=b"(*ebx), "=c"(*ecx), "=d"(*edx)
+                     : "a"(leaf), "c"(0));
+}
+
+/**
+ * Detect features and switch on SSE
+ */
+void cpu_init(void) {
+    uint32_t eax, ebx, ecx, edx;
+    
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    if (eax >= 1) {
+        cpuid(1, &eax, &ebx, &ecx, &edx);
+        cpuid_edx = edx;
+    }
+    
+    // SSE needs FXSR for context save and OS support flags in CR4
+    if ((cpuid_edx & CPUID_EDX_FXSR) && (cpuid_edx & CPUID_EDX_SSE)) {
+        uint32_t cr0, cr4;
+        
+        __asm__ volatile("mov %%cr0, %0" : "=r"(cr0));
+        cr0 &= ~CR0_EM;     // FPU present, no emulation
+        cr0 |= CR0_MP;
+        __asm__ volatile("mov %0, %%cr0" : : "r"(cr0));
+        
+        __asm__ volatile("mov %%cr4, %0" : "=r"(cr4));
+        cr4 |= CR4_OSFXSR | CR4_OSXMMEXCPT;
+        __asm__ volatile("mov %0, %%cr4" : : "r"(cr4));
+        
+        __asm__ volatile("fninit");
+        sse_enabled = 1;
+    }
+}
+
+int cpu_has_sse2(void) {
+    return sse_enabled && (cpuid_edx & CPUID_EDX_SSE2);
+}
+
+int cpu_has_tsc(void) {
+    return (cpuid_edx & CPUID_EDX_TSC) != 0;
+}
+
+int cpu_has_apic(void) {
+    return (cpuid_edx & (CPUID_EDX_APIC | CPUID_EDX_MSR)) == (CPUID_EDX_APIC | CPUID_EDX_MSR);
+}
+
+/**
+ * Save FPU/SSE state before the kernel touches XMM registers
+ */
+void kernel_fpu_begin(void) {
+    if (!sse_enabled) return;
+    if (fpu_depth++ == 0) {
+        __asm__ volatile("fxsave %0" : "=m"(fpu_save_area));
+    }
+}
+
+/**
+ * Restore the state saved by kernel_fpu_begin
+ */
+void kernel_fpu_end(void) {
+    if (!sse_enabled) return;
+    if (--fpu_depth == 0) {
+        __asm__ volatile("fxrstor %0" : : "m"(fpu_save_area));
+    }
+}
+
+int kernel_fpu_active(void) {
+    return fpu_depth != 0;
+}
+
+/**
+ * Count TSC cycles across a PIT channel 2 one-shot
+ */
+uint32_t cpu_calibrate_tsc(void) {
+    if (!cpu_has_tsc()) return 0;
+    
+    uint32_t count = PIT_FREQUENCY / (1000 / CALIBRATE_MS);
+    
+    // Gate on, speaker off
+    outb(PIT_GATE_PORT, (inb(PIT_GATE_PORT) & ~0x02) | 0x01);
+    
+    // Channel 2, lobyte/hibyte, mode 0 (interrupt on terminal count)
+    outb(PIT_COMMAND, 0xB0);
+    outb(PIT_CHANNEL2, count & 0xFF);
+    outb(PIT_CHANNEL2, (count >> 8) & 0xFF);
+    
+    uint64_t start = cpu_rdtsc();
+    while ((inb(PIT_GATE_PORT) & 0x20) == 0);  // OUT2 goes high at zero
+    uint64_t end = cpu_rdtsc();
+    
+    tsc_khz = (uint32_t)(end - start) / CALIBRATE_MS;
+    return tsc_khz;
+}
+
+uint32_t cpu_tsc_khz(void) {
+    return tsc_khz;
+}
@@ -0,0 +1,96 @@
+#ifndef CPU_H
+#define CPU_H
+
+#include <stdint.h>
+
+/* CPUID leaf 1 EDX feature bits */
+#define CPUID_EDX_TSC       (1 << 4)
+#define CPUID_EDX_MSR       (1 << 5)
+#define CPUID_EDX_APIC      (1 << 9)
+#define CPUID_EDX_FXSR      (1 << 24)
+#define CPUID_EDX_SSE       (1 << 25)
+#define CPUID_EDX_SSE2      (1 << 26)
+
+/* EFLAGS bits */
+#define EFLAGS_IF           (1 << 9)
+
+/* Control register bits */
+#define CR0_MP              (1 << 1)
+#define CR0_EM              (1 << 2)
+#define CR4_PCE             (1 << 8)     // RDPMC allowed in Ring 3
+#define CR4_OSFXSR          (1 << 9)
+#define CR4_OSXMMEXCPT      (1 << 10)
+
+/**
+ * Detect CPU features and enable SSE (CR4.OSFXSR/OSXMMEXCPT)
+ * Must run before any SSE instruction is executed
+ */
+void cpu_init(void);
+
+/**
+ * Feature queries (valid after cpu_init)
+ */
+int cpu_has_sse2(void);
+int cpu_has_tsc(void);
+int cpu_has_apic(void);
+
+/**
+ * Bracket kernel SSE use
+ * Saves and restores the FPU/SSE state with FXSAVE/FXRSTOR so user
+ * state is never clobbered. Calls may nest; IRQ handlers and softirqs
+ * must not use SSE. There is one save area, so a section must end on
+ * the path that began it: the scheduler never switches away while one
+ * is open (kernel_fpu_active).
+ */
+void kernel_fpu_begin(void);
+void kernel_fpu_end(void);
+int kernel_fpu_active(void);
+
+/**
+ * Disable interrupts; irq_restore turns them back on only if they were
+ * on, so the pair nests
+ */
+static inline uint32_t irq_save(void) {
+    uint32_t flags;
+    __asm__ volatile("pushfl; popl %0; cli" : "=r"(flags) : : "memory");
+    return flags;
+}
+
+static inline void irq_restore(uint32_t flags) {
+    if (flags & EFLAGS_IF) __asm__ volatile("sti" : : : "memory");
+}
+
+/**
+ * Read the time stamp counter
+ */
+static inline uint64_t cpu_rdtsc(void) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+/**
+ * Model-specific registers (check CPUID_EDX_MSR first)
+ */
+static inline uint64_t cpu_rdmsr(uint32_t msr) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdmsr" : "=a"(lo), "=d"(hi) : "c"(msr));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void cpu_wrmsr(uint32_t msr, uint64_t value) {
+    __asm__ volatile("wrmsr" : : "c"(msr), "a"((uint32_t)value), "d"((uint32_t)(value >> 32)));
+}
+
+/**
+ * Measure the TSC rate against PIT channel 2 (10ms gate)
+ * Returns kHz, 0 if there is no TSC
+ */
+uint32_t cpu_calibrate_tsc(void);
+
+/**
+ * Last calibrated TSC rate in kHz (0 until cpu_calibrate_tsc runs)
+ */
+uint32_t cpu_tsc_khz(void);
+
+#endif // CPU_H
@@ -1,3 +1,6 @@
+#include "../trace/trace.h"
+#include "../process/process_manager.h"
+
 /* External functions */
 extern void vga_print(const char *s);
 extern void vga_clear(void);
@@ -193,6 +196,11 @@ static void handle_kernel_exception(unsigned int exception_num, unsigned int err
     vga_print_at(2, 20, "The system has been halted to prevent data corruption.");
     vga_print_at(2, 21, "Please reboot your system.");
     
+#ifdef KERNEL_TRACE
+    /* The events leading up to the crash, for tools/trace_decode.py */
+    trace_dump();
+#endif
+    
     /* Halt system */
     while(1) {
         __asm__ volatile("cli; hlt");
@@ -221,6 +229,14 @@ void exception_handler(unsigned int exception_num, unsigned int error_code) {
         : "=r"(eip), "=r"(cs)
     );
     
+    if (exception_num == 14) {
+        unsigned int fault_addr;
+        __asm__ volatile("mov %%cr2, %0" : "=r"(fault_addr));
+        TRACE_PAGE_FAULT(fault_addr, error_code, eip);
+        process_account_page_fault();
+        (void)fault_addr;
+    }
+    
     /* Check CS lowest 2 bits for privilege level */
     if (cs & 0x3) {
         /* Ring 3 - user mode exception */
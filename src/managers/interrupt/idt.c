@@ -69,7 +69,6 @@ extern void exception_stub_17(void);
 extern void exception_stub_18(void);
 extern void exception_stub_19(void);
 extern void syscall_int(void);
-extern void irq0_stub(void);  /* Timer IRQ */
 
 int idt_install_exception_handlers(void) {
     /* Type: 0x8F = Present, Ring 0, Trap Gate (allows nested exceptions, doesn't disable interrupts) */
@@ -104,21 +103,18 @@ int idt_install_exception_handlers(void) {
      */
     idt_set_entry(128, (unsigned int)syscall_int, 0x08, 0xEE);
     
-    /* Set up IRQ 0 (PIT timer) handler - IRQ 0 is remapped to INT 32 */
-    /* Type: 0x8E = Present (1), DPL=0 (kernel only), Interrupt Gate */
-    idt_set_entry(32, (unsigned int)irq0_stub, 0x08, 0x8E);
-    
     /* IRQ 15 (ATA) handler removed - now using AHCI */
     
     return 1;  /* Success */
 }
 
-extern void irq12_stub(void);  /* Mouse IRQ */
+extern void lapic_timer_stub(void);      /* LAPIC one-shot timer */
+extern void lapic_spurious_stub(void);   /* LAPIC spurious vector */
 
-int idt_install_mouse_handler(void) {
-    /* Set up IRQ 12 (PS/2 Mouse) handler - IRQ 12 is remapped to INT 44 (32 + 12) */
+int idt_install_lapic_handlers(void) {
+    /* LAPIC vectors sit above the remapped PICs (0x20-0x2F) */
     /* Type: 0x8E = Present (1), DPL=0 (kernel), 32-bit Interrupt Gate */
-    /* Hardware IRQs MUST use DPL=0 - they can interrupt any privilege level */
-    idt_set_entry(44, (unsigned int)irq12_stub, 0x08, 0x8E);
+    idt_set_entry(0x30, (unsigned int)lapic_timer_stub, 0x08, 0x8E);
+    idt_set_entry(0xFF, (unsigned int)lapic_spurious_stub, 0x08, 0x8E);
     return 1;  /* Success */
 }
@@ -20,16 +20,16 @@
 .globl exception_stub_18
 .globl exception_stub_19
 .globl syscall_int
-.globl irq0_stub
-.globl irq12_stub
+.globl irq_stub_table
+.globl lapic_timer_stub
+.globl lapic_spurious_stub
 /* .globl ata_irq_handler - removed (using AHCI now) */
 
 /* Extern C handler functions */
 .extern exception_handler
 .extern syscall_dispatcher
-.extern pit_handler
 .extern ata_irq_c_handler
-.extern mouse_handler
+.extern irq_dispatch
 
 /* Exception stub for exceptions WITHOUT error code (e.g., exception 0 - divide by zero) */
 .macro exception_no_error_code exception_num
@@ -179,47 +179,85 @@ syscall_int:
     iret
 
 /* ============================================================ */
-/* IRQ 0 HANDLER - PIT Timer (with preemptive multitasking) */
+/* ISA IRQ 0-15 - one stub per line, one shared entry path */
 /* ============================================================ */
+/* IRQ stub: push the line number for irq_dispatch */
+.macro irq_stub irq_num
 .align 4
-irq0_stub:
+irq_stub_\irq_num:
+    push $\irq_num
+    jmp irq_common
+.endm
+
+/* Common path for all IRQs - handler, EOI and deferred work are in C */
+.align 4
+irq_common:
     /* Save all general purpose registers (part of context) */
     pusha
     
-    /* Call simple PIT handler (no context switching yet) */
-    call pit_handler
-    
-    /* Send EOI to PIC (End of Interrupt) */
-    movb $0x20, %al
-    outb %al, $0x20
+    /* Stack: [ESP] = edi, ..., [ESP+28] = eax, [ESP+32] = irq_num, */
+    /* [ESP+36] = CPU frame (EIP, CS, EFLAGS) */
+    /* irq_dispatch may switch to a process and never come back here */
+    lea 36(%esp), %eax
+    pushl %eax
+    pushl 36(%esp)
+    call irq_dispatch
+    addl $8, %esp
     
-    /* Restore registers */
+    /* Restore registers and drop the IRQ number */
     popa
+    add $4, %esp
     
     /* Return from interrupt */
     iret
 
-/* IRQ 14 handler removed - now using AHCI instead of IDE */
+/* Define IRQ stubs */
+irq_stub 0      /* PIT */
+irq_stub 1      /* PS/2 keyboard */
+irq_stub 2      /* Cascade (never raised) */
+irq_stub 3      /* COM2 */
+irq_stub 4      /* COM1 */
+irq_stub 5
+irq_stub 6      /* Floppy */
+irq_stub 7      /* LPT1 / PIC spurious */
+irq_stub 8      /* RTC */
+irq_stub 9
+irq_stub 10
+irq_stub 11
+irq_stub 12     /* PS/2 mouse */
+irq_stub 13     /* FPU */
+irq_stub 14     /* Primary ATA */
+irq_stub 15     /* Secondary ATA / PIC spurious */
+
+/* Stub address by IRQ line, installed by irq_manager_init */
+.align 4
+irq_stub_table:
+    .long irq_stub_0, irq_stub_1, irq_stub_2, irq_stub_3
+    .long irq_stub_4, irq_stub_5, irq_stub_6, irq_stub_7
+    .long irq_stub_8, irq_stub_9, irq_stub_10, irq_stub_11
+    .long irq_stub_12, irq_stub_13, irq_stub_14, irq_stub_15
 
 /* ============================================================ */
-/* IRQ 12 HANDLER - PS/2 Mouse */
+/* LAPIC TIMER - one-shot timer wheel event (vector 0x30) */
 /* ============================================================ */
 .align 4
-irq12_stub:
-    /* Save all general purpose registers */
+lapic_timer_stub:
     pusha
     
-    /* Call mouse handler */
-    call mouse_handler
-    
-    /* Send EOI to slave PIC (IRQ 12 is on slave PIC) */
-    movb $0x20, %al
-    outb %al, $0xA0     /* Slave PIC */
-    outb %al, $0x20     /* Master PIC */
+    /* EOI, timer wheel, deferred work (see irq_dispatch) */
+    lea 32(%esp), %eax          /* CPU frame */
+    pushl %eax
+    call lapic_timer_handler
+    addl $4, %esp
     
-    /* Restore registers */
     popa
-    
-    /* Return from interrupt */
     iret
 
+/* ============================================================ */
+/* LAPIC SPURIOUS (vector 0xFF) - no EOI for spurious vectors */
+/* ============================================================ */
+.align 4
+lapic_spurious_stub:
+    iret
+
+
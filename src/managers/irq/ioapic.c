@@ -0,0 +1,89 @@
+/**
+ * MaahiOS I/O APIC driver
+ * Routes GSIs to LAPIC vectors. The IRQ manager points the ISA IRQs at
+ * the vectors the PIC used (0x20 + irq), so the IDT does not change.
+ */
+
+#include "ioapic.h"
+
+extern void paging_map_mmio_region(uint32_t phys_start, uint32_t size);
+
+typedef struct {
+    volatile uint32_t *base;
+    uint32_t gsi_base;
+    uint32_t inputs;
+} ioapic_t;
+
+static ioapic_t ioapics[ACPI_MAX_IOAPICS];
+static int ioapic_count = 0;
+
+static uint32_t ioapic_read(const ioapic_t *io, uint32_t reg) {
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    return io->base[IOAPIC_WINDOW / 4];
+}
+
+static void ioapic_write(const ioapic_t *io, uint32_t reg, uint32_t value) {
+    io->base[IOAPIC_REGSEL / 4] = reg;
+    io->base[IOAPIC_WINDOW / 4] = value;
+}
+
+/**
+ * IOAPIC and input number serving a GSI
+ */
+static ioapic_t *ioapic_for(uint32_t gsi, uint32_t *input) {
+    for (int i = 0; i < ioapic_count; i++) {
+        ioapic_t *io = &ioapics[i];
+        if (gsi >= io->gsi_base && gsi < io->gsi_base + io->inputs) {
+            *input = gsi - io->gsi_base;
+            return io;
+        }
+    }
+    return 0;
+}
+
+int ioapic_init(const acpi_madt_info_t *madt) {
+    ioapic_count = 0;
+    for (int i = 0; i < madt->ioapic_count; i++) {
+        ioapic_t *io = &ioapics[ioapic_count];
+        paging_map_mmio_region(madt->ioapic[i].address, 4096);
+        io->base = (volatile uint32_t *)madt->ioapic[i].address;
+        io->gsi_base = madt->ioapic[i].gsi_base;
+        io->inputs = ((ioapic_read(io, IOAPIC_REG_VERSION) >> 16) & 0xFF) + 1;
+
+        for (uint32_t input = 0; input < io->inputs; input++) {
+            ioapic_write(io, IOAPIC_REG_REDTBL + input * 2, IOAPIC_MASKED);
+            ioapic_write(io, IOAPIC_REG_REDTBL + input * 2 + 1, 0);
+        }
+        ioapic_count++;
+    }
+    return ioapic_count;
+}
+
+int ioapic_route(uint32_t gsi, uint8_t vector, uint16_t flags, uint8_t apic_id) {
+    uint32_t input;
+    ioapic_t *io = ioapic_for(gsi, &input);
+    if (!io) return 0;
+
+    // Fixed delivery, physical destination
+    uint32_t low = vector | IOAPIC_MASKED;
+    if ((flags & MPS_POLARITY_MASK) == MPS_POLARITY_LOW) low |= IOAPIC_POLARITY_LOW;
+    if ((flags & MPS_TRIGGER_MASK) == MPS_TRIGGER_LEVEL) low |= IOAPIC_TRIGGER_LEVEL;
+
+    ioapic_write(io, IOAPIC_REG_REDTBL + input * 2 + 1, (uint32_t)apic_id << 24);
+    ioapic_write(io, IOAPIC_REG_REDTBL + input * 2, low);
+    return 1;
+}
+
+void ioapic_set_masked(uint32_t gsi, int masked) {
+    uint32_t input;
+    ioapic_t *io = ioapic_for(gsi, &input);
+    if (!io) return;
+
+    uint32_t low = ioapic_read(io, IOAPIC_REG_REDTBL + input * 2);
+    if (masked) {
+        low |= IOAPIC_MASKED;
+    } else {
+        low &= ~IOAPIC_MASKED;
+    }
+    ioapic_write(io, IOAPIC_REG_REDTBL + input * 2, low);
+}
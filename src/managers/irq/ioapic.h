@@ -0,0 +1,40 @@
+#ifndef IOAPIC_H
+#define IOAPIC_H
+
+#include <stdint.h>
+#include "../acpi/acpi.h"
+
+/**
+ * I/O APIC
+ * Each input (GSI) has a 64-bit redirection entry naming the vector,
+ * trigger mode, polarity and destination LAPIC. Entries start masked.
+ */
+
+/* Indirect register access */
+#define IOAPIC_REGSEL           0x00
+#define IOAPIC_WINDOW           0x10
+
+#define IOAPIC_REG_ID           0x00
+#define IOAPIC_REG_VERSION      0x01
+#define IOAPIC_REG_REDTBL       0x10    // + 2 * input (low), + 1 (high)
+
+/* Redirection entry (low word) */
+#define IOAPIC_POLARITY_LOW     (1 << 13)
+#define IOAPIC_TRIGGER_LEVEL    (1 << 15)
+#define IOAPIC_MASKED           (1 << 16)
+
+/**
+ * Map every IOAPIC from the MADT and mask all inputs
+ * Returns the number of IOAPICs usable
+ */
+int ioapic_init(const acpi_madt_info_t *madt);
+
+/**
+ * Point a GSI at vector on the LAPIC with apic_id (left masked)
+ * flags are MPS INTI flags from the MADT (0 = ISA default: edge, high)
+ */
+int ioapic_route(uint32_t gsi, uint8_t vector, uint16_t flags, uint8_t apic_id);
+
+void ioapic_set_masked(uint32_t gsi, int masked);
+
+#endif // IOAPIC_H
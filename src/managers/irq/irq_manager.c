@@ -1,8 +1,19 @@
 /**
  * IRQ Manager - Centralized interrupt request management
+ * The ISA IRQs go through the IOAPIC when the MADT describes one, and
+ * through the 8259 PICs otherwise. Both deliver IRQ n on vector 0x20 + n.
  */
 
 #include "irq_manager.h"
+#include "lapic.h"
+#include "ioapic.h"
+#include "softirq.h"
+#include "../acpi/acpi.h"
+#include "../cpu/cpu.h"
+#include "../log/klog.h"
+#include "../trace/trace.h"
+#include "../process/process_manager.h"
+#include "../scheduler/scheduler.h"
 
 /* Port I/O functions */
 static inline void outb(unsigned short port, unsigned char val) {
@@ -27,6 +38,8 @@ static inline void io_wait(void) {
 #define PIC2_COMMAND 0xA0
 #define PIC2_DATA    0xA1
 
+#define PIC_READ_ISR 0x0B
+
 /**
  * Remap PIC to avoid conflicts with CPU exceptions
  * IRQ 0-7 → INT 0x20-0x27
@@ -62,133 +75,270 @@ static void pic_remap(void) {
     outb(PIC2_DATA, 0xFF);
 }
 
+/* Delivery path for the ISA IRQs */
+static int irq_mode = IRQ_MODE_PIC;
+static acpi_madt_info_t madt;
+
+/* Registered handlers, called from irq_dispatch */
+typedef struct {
+    irq_handler_t handler;
+    void *ctx;
+} irq_desc_t;
+
+static irq_desc_t irq_table[IRQ_LINES];
+
+/* Counters and handler timings (SYSCALL_IRQ_STATS); timings need a TSC */
+static irq_stats_t stats;
+static int have_tsc = 0;
+static const irq_frame_t *current_frame = 0;     // Innermost interrupt being handled
+
+/* PIC mask bits, kept in RAM so enable/disable never read them back */
+static uint16_t pic_mask = 0xFFFF;
+
+static void pic_write_mask(void) {
+    outb(PIC1_DATA, pic_mask & 0xFF);
+    outb(PIC2_DATA, pic_mask >> 8);
+}
+
+/**
+ * Route the ISA IRQs through the IOAPIC (all masked, same vectors)
+ * Returns 0 if there is no LAPIC, MADT or IOAPIC - the PICs stay in charge
+ */
+static int irq_apic_init(void) {
+    if (!lapic_init()) return 0;
+    if (!acpi_parse_madt(&madt) || madt.ioapic_count == 0) {
+        klog(KLOG_INFO, "IRQ", "No IOAPIC in the MADT - using the 8259 PICs");
+        return 0;
+    }
+    if (!ioapic_init(&madt)) return 0;
+
+    uint8_t apic_id = lapic_get_id();
+    for (int irq = 0; irq < IRQ_LINES; irq++) {
+        ioapic_route(madt.isa_gsi[irq], IRQ_VECTOR_BASE + irq, madt.isa_flags[irq], apic_id);
+    }
+
+    // IMCR (only on boards that have one): take the PICs off the CPU pin
+    outb(0x22, 0x70);
+    outb(0x23, 0x01);
+
+    klog(KLOG_INFO, "IRQ", "ISA IRQs routed through the IOAPIC");
+    return 1;
+}
+
 /**
  * Initialize IRQ manager
+ * The PICs are remapped and fully masked either way, so a stray 8259
+ * interrupt cannot land on an exception vector
  */
 void irq_manager_init(void) {
+    extern void idt_set_entry(int index, unsigned int handler, unsigned short selector, unsigned char type);
+    extern uint32_t irq_stub_table[IRQ_LINES];
+
     pic_remap();
-    // pic_remap already masks all IRQs - no need to do it again
-}
+    pic_mask = 0xFFFF;
+    irq_mode = irq_apic_init() ? IRQ_MODE_APIC : IRQ_MODE_PIC;
+    have_tsc = cpu_has_tsc();
 
-// Simple serial output for debugging
-static void serial_print(const char *str) {
-    while (*str) {
-        while ((inb(0x3FD) & 0x20) == 0);
-        outb(0x3F8, *str++);
+    // Every line gets its stub up front; handlers come and go in irq_table
+    /* 0x8E = Present, DPL=0, 32-bit interrupt gate */
+    for (int irq = 0; irq < IRQ_LINES; irq++) {
+        irq_table[irq].handler = 0;
+        irq_table[irq].ctx = 0;
+        idt_set_entry(IRQ_VECTOR_BASE + irq, irq_stub_table[irq], 0x08, 0x8E);
     }
 }
 
-static void serial_hex(unsigned char value) {
-    char hex[] = "0123456789ABCDEF";
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[(value >> 4) & 0xF]);
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[value & 0xF]);
+int irq_get_mode(void) {
+    return irq_mode;
 }
 
 /**
  * Enable specific IRQ line (0-15)
  */
 void irq_enable(int irq_number) {
-    unsigned short port;
-    unsigned char mask;
-    int original_irq = irq_number;
-    
-    serial_print("\n[IRQ_ENABLE] IRQ ");
-    serial_hex(original_irq);
+    if (irq_number < 0 || irq_number >= IRQ_LINES) return;
     
-    if (irq_number < 8) {
-        // Master PIC (IRQ 0-7)
-        port = PIC1_DATA;
-        serial_print(" -> MASTER\n");
-    } else {
-        // Slave PIC (IRQ 8-15)
-        port = PIC2_DATA;
-        irq_number -= 8;
-        serial_print(" -> SLAVE\n");
-        
-        // Also enable IRQ2 (cascade) on master - use separate variable
-        unsigned char master_mask = inb(PIC1_DATA);
-        serial_print("[IRQ2_CASCADE] Before: ");
-        serial_hex(master_mask);
-        
-        unsigned char master_before = master_mask;
-        master_mask &= ~(1 << 2);
-        
-        serial_print(" After calc: ");
-        serial_hex(master_mask);
-        
-        outb(PIC1_DATA, master_mask);
-        
-        // Verify it was written
-        unsigned char master_after = inb(PIC1_DATA);
-        serial_print(" Readback: ");
-        serial_hex(master_after);
-        serial_print("\n");
-        
-        if (master_after != master_mask) {
-            serial_print("[IRQ2_CASCADE] WRITE FAILED! Retrying...\n");
-            // Write failed! Try again
-            outb(PIC1_DATA, master_mask);
-            io_wait();
-            outb(PIC1_DATA, master_mask);
-        }
+    if (irq_mode == IRQ_MODE_APIC) {
+        ioapic_set_masked(madt.isa_gsi[irq_number], 0);
+        return;
     }
     
-    // Clear the mask bit for this IRQ
-    unsigned char before = inb(port);
-    serial_print("[IRQ_MASK] Before: ");
-    serial_hex(before);
-    serial_print(" IRQ_BIT: ");
-    serial_hex(irq_number);
-    
-    mask = before;
-    // IMPORTANT: Cast to unsigned char FIRST to get correct 8-bit mask
-    unsigned char bit_mask = (unsigned char)~((unsigned char)(1 << irq_number));
-    serial_print(" ~(1<<n): ");
-    serial_hex(bit_mask);
-    
-    mask &= bit_mask;
-    
-    serial_print(" After calc: ");
-    serial_hex(mask);
-    
-    outb(port, mask);
-    
-    // Verify it was written
-    unsigned char after = inb(port);
-    serial_print(" Readback: ");
-    serial_hex(after);
-    serial_print("\n");
-    
-    if (after != mask) {
-        serial_print("[IRQ_MASK] WRITE FAILED! Retrying...\n");
-        // Write failed! Try multiple times with delays
-        for (int i = 0; i < 5; i++) {
-            outb(port, mask);
-            io_wait();
-        }
-    }
+    // Slave lines also need the cascade (IRQ2) open on the master
+    pic_mask &= ~(1 << irq_number);
+    if (irq_number >= 8) pic_mask &= ~(1 << 2);
+    pic_write_mask();
 }
 
 /**
  * Disable specific IRQ line (0-15)
  */
 void irq_disable(int irq_number) {
-    unsigned short port;
-    unsigned char mask;
+    if (irq_number < 0 || irq_number >= IRQ_LINES) return;
+    
+    if (irq_mode == IRQ_MODE_APIC) {
+        ioapic_set_masked(madt.isa_gsi[irq_number], 1);
+        return;
+    }
+    
+    pic_mask |= 1 << irq_number;
+    pic_write_mask();
+}
+
+/**
+ * End of interrupt - the one place that acknowledges an IRQ
+ * LAPIC: one MMIO write. PIC: the slave too for IRQ 8-15.
+ */
+void irq_eoi(int irq_number) {
+    if (irq_mode == IRQ_MODE_APIC) {
+        lapic_eoi();
+        return;
+    }
+    
+    if (irq_number >= 8) outb(PIC2_COMMAND, 0x20);
+    outb(PIC1_COMMAND, 0x20);
+}
+
+/**
+ * Attach a handler to an IRQ line
+ * Returns 0 if the line is out of range or another handler owns it
+ */
+int irq_register_handler(int irq_number, irq_handler_t handler, void *ctx) {
+    if (irq_number < 0 || irq_number >= IRQ_LINES || !handler) return 0;
+    
+    irq_desc_t *desc = &irq_table[irq_number];
+    if (desc->handler && desc->handler != handler) return 0;
+    
+    uint32_t flags = irq_save();
+    desc->ctx = ctx;
+    desc->handler = handler;
+    irq_restore(flags);
+    return 1;
+}
+
+void irq_unregister_handler(int irq_number) {
+    if (irq_number < 0 || irq_number >= IRQ_LINES) return;
+    
+    uint32_t flags = irq_save();
+    irq_table[irq_number].handler = 0;
+    irq_table[irq_number].ctx = 0;
+    irq_restore(flags);
+}
+
+/**
+ * 8259 only: is the line really in service? A glitch on IRQ 7 or 15
+ * arrives with its ISR bit clear and must not be acknowledged
+ */
+static int pic_in_service(int irq_number) {
+    if (irq_number >= 8) {
+        outb(PIC2_COMMAND, PIC_READ_ISR);
+        return inb(PIC2_COMMAND) & (1 << (irq_number - 8));
+    }
+    outb(PIC1_COMMAND, PIC_READ_ISR);
+    return inb(PIC1_COMMAND) & (1 << irq_number);
+}
+
+/**
+ * Interrupt exit: deferred work with interrupts on, then a process
+ * switch if the slice ran out and the interrupt came from ring 3 (that
+ * never returns, so it goes last)
+ */
+void irq_exit(int from_user) {
+    // Nested inside a drain - the outer irq_exit finishes both
+    if (!softirq_run()) return;
+    scheduler_tick(from_user);
+}
+
+/**
+ * Handler timing - TSC at entry, 0 without one
+ */
+uint64_t irq_timestamp(void) {
+    return have_tsc ? cpu_rdtsc() : 0;
+}
+
+/**
+ * Account one interrupt on a stats slot, timed from irq_timestamp()
+ * Bucket n of the histogram holds runs of [2^n, 2^(n+1)) cycles
+ */
+void irq_record(int slot, uint64_t start) {
+    irq_line_stats_t *line = &stats.line[slot];
+    line->count++;
+    if (!have_tsc) return;
+    
+    uint64_t elapsed = cpu_rdtsc() - start;
+    uint32_t cycles = (elapsed >> 32) ? 0xFFFFFFFF : (uint32_t)elapsed;
+    int bucket = 0;
+    if (cycles) __asm__("bsrl %1, %0" : "=r"(bucket) : "rm"(cycles));
+    
+    line->hist[bucket]++;
+    line->total_cycles += cycles;
+    if (cycles > line->max_cycles) line->max_cycles = cycles;
+}
+
+/**
+ * Snapshot the counters for SYSCALL_IRQ_STATS, optionally clearing them
+ */
+void irq_get_stats(irq_stats_t *out, int reset) {
+    extern uint64_t clock_monotonic_ns(void);
+    extern uint32_t timer_get_max_late_ns(int reset);
+    
+    uint32_t flags = irq_save();
+    stats.mode = irq_mode;
+    stats.tsc_khz = have_tsc ? cpu_tsc_khz() : 0;
+    stats.timer_late_max_ns = timer_get_max_late_ns(reset);
+    stats.timestamp_ns = clock_monotonic_ns();
+    *out = stats;
+    if (reset) {
+        uint8_t *p = (uint8_t *)&stats;
+        for (uint32_t i = 0; i < sizeof(stats); i++) p[i] = 0;
+    }
+    irq_restore(flags);
+}
+
+const irq_frame_t *irq_get_frame(void) {
+    return current_frame;
+}
+
+const irq_frame_t *irq_set_frame(const irq_frame_t *frame) {
+    const irq_frame_t *prev = current_frame;
+    current_frame = frame;
+    return prev;
+}
+
+/**
+ * Common C entry for IRQ 0-15 (from irq_common in interrupt_stubs.s)
+ */
+void irq_dispatch(int irq_number, const irq_frame_t *frame) {
+    irq_desc_t *desc = &irq_table[irq_number];
+    uint64_t start = irq_timestamp();
+    
+    if (irq_mode == IRQ_MODE_PIC && (irq_number == 7 || irq_number == 15) &&
+        !pic_in_service(irq_number)) {
+        // The master still saw a real cascade interrupt for a slave glitch
+        if (irq_number == 15) outb(PIC1_COMMAND, 0x20);
+        stats.spurious++;
+        return;
+    }
     
-    if (irq_number < 8) {
-        port = PIC1_DATA;
+    // EOI before the handler - IF stays 0 until iret, so nothing nests yet,
+    // and a handler that ends in a process switch cannot lose it
+    irq_eoi(irq_number);
+    
+    const irq_frame_t *prev_frame = irq_set_frame(frame);
+    int from_user = frame->cs & 3;
+    if (from_user) process_account_mode(PROCESS_MODE_KERNEL);
+    TRACE_IRQ_ENTER(irq_number);
+    if (desc->handler) {
+        desc->handler(desc->ctx);
     } else {
-        port = PIC2_DATA;
-        irq_number -= 8;
+        stats.unhandled++;
     }
     
-    // Set the mask bit for this IRQ
-    mask = inb(port);
-    mask |= (1 << irq_number);
-    outb(port, mask);
+    // Recorded before irq_exit, which may switch to a process for good
+    TRACE_IRQ_EXIT(irq_number);
+    irq_set_frame(prev_frame);
+    irq_record(irq_number, start);
+    irq_exit(from_user);
+    if (from_user) process_account_mode(PROCESS_MODE_USER);
 }
 
 /**
@@ -198,6 +348,13 @@ void irq_enable_timer(void) {
     irq_enable(0);
 }
 
+/**
+ * Enable keyboard IRQ (IRQ 1)
+ */
+void irq_enable_keyboard(void) {
+    irq_enable(1);
+}
+
 /**
  * Enable mouse IRQ (IRQ 12)
  */
@@ -207,7 +364,7 @@ void irq_enable_mouse(void) {
 
 /**
  * Get PIC mask status for debugging
- * Returns: (slave_mask << 8) | master_mask
+ * Returns: (slave_mask << 8) | master_mask (0xFFFF when the IOAPIC routes)
  */
 unsigned int irq_get_pic_mask(void) {
     unsigned char master = inb(PIC1_DATA);
@@ -1,15 +1,71 @@
 #ifndef IRQ_MANAGER_H
 #define IRQ_MANAGER_H
 
+#include <stdint.h>
+
 /**
  * IRQ Manager - Centralized interrupt request management
- * Handles PIC configuration and IRQ enable/disable
+ * Routes the ISA IRQs through the IOAPIC (or the 8259 PICs) and owns
+ * enable/disable and EOI
+ */
+
+/* ISA IRQ n is delivered on vector IRQ_VECTOR_BASE + n in both modes */
+#define IRQ_LINES           16
+#define IRQ_VECTOR_BASE     0x20
+
+#define IRQ_MODE_PIC        0
+#define IRQ_MODE_APIC       1
+
+/*
+ * IRQ handler - runs with interrupts off after the EOI
+ * Keep it to the device registers and hand the rest to a softirq
+ * (softirq.h), which runs at interrupt exit with interrupts on
+ */
+typedef void (*irq_handler_t)(void *ctx);
+
+/* What the CPU pushed on interrupt entry */
+typedef struct {
+    uint32_t eip;
+    uint32_t cs;
+    uint32_t eflags;
+} irq_frame_t;
+
+/*
+ * Interrupt statistics (SYSCALL_IRQ_STATS) - shared with user space
+ * One slot per ISA line plus one for the LAPIC timer vector. Durations
+ * are TSC cycles from the common entry to the end of the handler
+ * (softirqs not included); divide by tsc_khz for ms. Rates come from
+ * two snapshots: delta count / delta timestamp_ns.
  */
+#define IRQ_STATS_LAPIC_TIMER   IRQ_LINES
+#define IRQ_STATS_SLOTS         (IRQ_LINES + 1)
+#define IRQ_HIST_BUCKETS        32
+#define IRQ_STATS_RESET         1       // Clear the counters after reading
+
+typedef struct {
+    uint32_t count;
+    uint32_t max_cycles;                // Longest handler run
+    uint64_t total_cycles;
+    uint32_t hist[IRQ_HIST_BUCKETS];    // Bucket n: [2^n, 2^(n+1)) cycles
+} irq_line_stats_t;
+
+typedef struct {
+    uint64_t timestamp_ns;              // Monotonic time of the snapshot
+    uint32_t tsc_khz;                   // 0 without a TSC (no timings)
+    uint32_t mode;                      // IRQ_MODE_PIC or IRQ_MODE_APIC
+    uint32_t spurious;                  // 8259 IRQ 7/15 with nothing in service
+    uint32_t unhandled;                 // Lines raised with no handler
+    uint32_t timer_late_max_ns;         // Worst timer interrupt past its deadline
+    irq_line_stats_t line[IRQ_STATS_SLOTS];
+} irq_stats_t;
 
 /**
- * Initialize IRQ manager and remap PIC
+ * Initialize IRQ manager: remap and mask the PICs, switch to the IOAPIC
+ * if the MADT has one and install the stubs for all lines (after paging,
+ * idt_init and cpu_init)
  */
 void irq_manager_init(void);
+int irq_get_mode(void);
 
 /**
  * Enable specific IRQ line
@@ -21,11 +77,51 @@ void irq_enable(int irq_number);
  */
 void irq_disable(int irq_number);
 
+/**
+ * Acknowledge an IRQ (LAPIC EOI, or PIC EOI to the slave too for 8-15)
+ */
+void irq_eoi(int irq_number);
+
+/**
+ * Attach a handler to an IRQ line (0 if out of range or already taken)
+ * The line still has to be unmasked with irq_enable
+ */
+int irq_register_handler(int irq_number, irq_handler_t handler, void *ctx);
+void irq_unregister_handler(int irq_number);
+
+/**
+ * Interrupt exit - drains softirqs, then lets the scheduler switch
+ * (only away from ring 3: from_user = frame->cs & 3)
+ * Called by irq_dispatch and by the LAPIC timer handler
+ */
+void irq_exit(int from_user);
+
+/**
+ * Frame of the interrupt being handled (0 outside one) - where the CPU
+ * was when it was interrupted. irq_set_frame returns the previous frame
+ * so nested entries can restore it.
+ */
+const irq_frame_t *irq_get_frame(void);
+const irq_frame_t *irq_set_frame(const irq_frame_t *frame);
+
+/**
+ * Statistics: irq_timestamp() at entry, irq_record() once the handler
+ * is done (the common entry does both for IRQ 0-15)
+ */
+uint64_t irq_timestamp(void);
+void irq_record(int slot, uint64_t start);
+void irq_get_stats(irq_stats_t *out, int reset);
+
 /**
  * Enable timer IRQ (IRQ 0)
  */
 void irq_enable_timer(void);
 
+/**
+ * Enable keyboard IRQ (IRQ 1)
+ */
+void irq_enable_keyboard(void);
+
 /**
  * Enable mouse IRQ (IRQ 12)
  */
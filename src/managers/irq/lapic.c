@@ -0,0 +1,141 @@
+/**
+ * Local APIC
+ * Enabled by the IRQ manager for IOAPIC delivery (MMIO EOI) and by the
+ * timer wheel for its one-shot timer. The timer counter runs at the bus clock / 16. It is measured once against
+ * the TSC clock and then programmed in one-shot mode to the next timer
+ * deadline, so an idle system takes no periodic interrupts.
+ */
+
+#include "lapic.h"
+#include "irq_manager.h"
+#include "../cpu/cpu.h"
+#include "../timer/clock.h"
+#include "../log/klog.h"
+#include "../trace/trace.h"
+#include "../process/process_manager.h"
+
+#define LAPIC_CALIBRATE_NS      10000000    // 10ms
+
+static volatile uint32_t *lapic_base = 0;
+static uint32_t timer_khz = 0;
+static uint32_t timer_mult = 0;             // Counts per ns << 32
+
+static inline uint32_t lapic_read(uint32_t reg) {
+    return lapic_base[reg / 4];
+}
+
+static inline void lapic_write(uint32_t reg, uint32_t value) {
+    lapic_base[reg / 4] = value;
+}
+
+/**
+ * Map and software-enable the LAPIC (idempotent)
+ */
+int lapic_init(void) {
+    if (lapic_base) return 1;
+    if (!cpu_has_apic()) {
+        klog(KLOG_INFO, "LAPIC", "Not present");
+        return 0;
+    }
+
+    uint64_t base_msr = cpu_rdmsr(LAPIC_BASE_MSR);
+    uint32_t phys = (uint32_t)base_msr & 0xFFFFF000;
+    cpu_wrmsr(LAPIC_BASE_MSR, base_msr | LAPIC_BASE_ENABLE);
+
+    extern void paging_map_mmio_region(uint32_t phys_start, uint32_t size);
+    paging_map_mmio_region(phys, 4096);
+    lapic_base = (volatile uint32_t *)phys;
+
+    extern int idt_install_lapic_handlers(void);
+    idt_install_lapic_handlers();
+
+    // Software enable; accept every priority
+    lapic_write(LAPIC_REG_SPURIOUS, LAPIC_SPURIOUS_ENABLE | LAPIC_SPURIOUS_VECTOR);
+    lapic_write(LAPIC_REG_TPR, 0);
+    lapic_write(LAPIC_REG_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_VECTOR);
+    return 1;
+}
+
+uint8_t lapic_get_id(void) {
+    return lapic_base ? (uint8_t)(lapic_read(LAPIC_REG_ID) >> 24) : 0;
+}
+
+int lapic_timer_init(void) {
+    if (!lapic_init()) return 0;
+
+    // The calibration reference is the TSC clock
+    const clock_page_t *clock = clock_get_page();
+    if (!clock || !clock->mult) {
+        klog(KLOG_WARN, "LAPIC", "No TSC to calibrate against");
+        return 0;
+    }
+
+    // Count down from the top for 10ms, masked
+    lapic_write(LAPIC_REG_TIMER_DIVIDE, LAPIC_TIMER_DIVIDE_16);
+    lapic_write(LAPIC_REG_LVT_TIMER, LAPIC_LVT_MASKED | LAPIC_TIMER_VECTOR);
+    uint64_t start = clock_monotonic_ns();
+    lapic_write(LAPIC_REG_TIMER_INIT, 0xFFFFFFFF);
+    while (clock_monotonic_ns() - start < LAPIC_CALIBRATE_NS) {
+        __asm__ volatile("pause");
+    }
+    uint32_t elapsed = 0xFFFFFFFF - lapic_read(LAPIC_REG_TIMER_CURRENT);
+    lapic_write(LAPIC_REG_TIMER_INIT, 0);
+
+    timer_khz = elapsed / (LAPIC_CALIBRATE_NS / 1000000);
+    if (timer_khz == 0 || timer_khz >= 1000000) {
+        klog(KLOG_WARN, "LAPIC", "Timer calibration failed");
+        timer_khz = 0;
+        return 0;
+    }
+
+    // counts = (ns * mult) >> 32, mult = kHz * 2^32 / 1e6 (64/32 divl)
+    uint32_t rem;
+    __asm__("divl %4" : "=a"(timer_mult), "=d"(rem)
+            : "a"(0), "d"(timer_khz), "rm"(1000000));
+
+    // One-shot mode, unmasked; nothing fires until a count is written
+    lapic_write(LAPIC_REG_LVT_TIMER, LAPIC_TIMER_VECTOR);
+    klog(KLOG_INFO, "LAPIC", "One-shot timer ready (%u kHz)", lapic_timer_khz());
+    return 1;
+}
+
+int lapic_available(void) {
+    return lapic_base != 0;
+}
+
+uint32_t lapic_timer_khz(void) {
+    return timer_khz;
+}
+
+void lapic_timer_oneshot(uint32_t delay_ns) {
+    uint32_t count = (uint32_t)(((uint64_t)delay_ns * timer_mult) >> 32);
+    if (count == 0) count = 1;
+    lapic_write(LAPIC_REG_TIMER_INIT, count);
+}
+
+void lapic_timer_stop(void) {
+    if (lapic_base) lapic_write(LAPIC_REG_TIMER_INIT, 0);
+}
+
+void lapic_eoi(void) {
+    lapic_write(LAPIC_REG_EOI, 0);
+}
+
+/**
+ * Timer vector handler (lapic_timer_stub)
+ */
+void lapic_timer_handler(const irq_frame_t *frame) {
+    extern void timer_interrupt(void);
+    uint64_t start = irq_timestamp();
+    lapic_eoi();
+    const irq_frame_t *prev_frame = irq_set_frame(frame);
+    int from_user = frame->cs & 3;
+    if (from_user) process_account_mode(PROCESS_MODE_KERNEL);
+    TRACE_IRQ_ENTER(IRQ_STATS_LAPIC_TIMER);
+    timer_interrupt();
+    TRACE_IRQ_EXIT(IRQ_STATS_LAPIC_TIMER);
+    irq_set_frame(prev_frame);
+    irq_record(IRQ_STATS_LAPIC_TIMER, start);
+    irq_exit(from_user);
+    if (from_user) process_account_mode(PROCESS_MODE_USER);
+}
@@ -0,0 +1,57 @@
+#ifndef LAPIC_H
+#define LAPIC_H
+
+#include <stdint.h>
+
+/**
+ * Local APIC
+ * Receives the ISA IRQs from the IOAPIC (EOI is one MMIO write) and
+ * runs the one-shot timer for the timer wheel. Without an IOAPIC the
+ * 8259 PICs still deliver through LINT0 in virtual wire mode.
+ */
+
+/* IA32_APIC_BASE MSR */
+#define LAPIC_BASE_MSR          0x1B
+#define LAPIC_BASE_ENABLE       (1 << 11)
+
+/* Register offsets */
+#define LAPIC_REG_ID            0x020
+#define LAPIC_REG_TPR           0x080
+#define LAPIC_REG_EOI           0x0B0
+#define LAPIC_REG_SPURIOUS      0x0F0
+#define LAPIC_REG_LVT_TIMER     0x320
+#define LAPIC_REG_TIMER_INIT    0x380
+#define LAPIC_REG_TIMER_CURRENT 0x390
+#define LAPIC_REG_TIMER_DIVIDE  0x3E0
+
+#define LAPIC_SPURIOUS_ENABLE   (1 << 8)
+#define LAPIC_LVT_MASKED        (1 << 16)
+#define LAPIC_TIMER_DIVIDE_16   0x3
+
+/* Vectors (above the remapped PIC range 0x20-0x2F) */
+#define LAPIC_TIMER_VECTOR      0x30
+#define LAPIC_SPURIOUS_VECTOR   0xFF
+
+/**
+ * Map and enable the LAPIC; returns 0 if the CPU has none
+ */
+int lapic_init(void);
+int lapic_available(void);
+uint8_t lapic_get_id(void);
+
+/**
+ * Calibrate the timer against the TSC clock
+ * Returns 1 if the timer is usable, 0 otherwise (no APIC, or no TSC)
+ */
+int lapic_timer_init(void);
+
+/**
+ * Fire LAPIC_TIMER_VECTOR once after delay_ns (clamped to the counter)
+ */
+void lapic_timer_oneshot(uint32_t delay_ns);
+void lapic_timer_stop(void);
+uint32_t lapic_timer_khz(void);
+
+void lapic_eoi(void);
+
+#endif // LAPIC_H
@@ -0,0 +1,55 @@
+/**
+ * MaahiOS deferred interrupt work
+ * A FIFO of work items drained by irq_exit. Only one drain runs at a
+ * time: an IRQ that arrives during the drain queues its work and leaves
+ * it to the running loop, so the kernel stack nests at most one level.
+ */
+
+#include "softirq.h"
+#include "../cpu/cpu.h"
+
+static softirq_work_t *queue_head = 0;
+static softirq_work_t **queue_tail = &queue_head;
+static int running = 0;
+
+void softirq_init_work(softirq_work_t *work, void (*fn)(void *ctx), void *ctx) {
+    work->next = 0;
+    work->fn = fn;
+    work->ctx = ctx;
+    work->queued = 0;
+}
+
+int softirq_raise(softirq_work_t *work) {
+    unsigned int flags = irq_save();
+    int raised = !work->queued;
+
+    if (raised) {
+        work->queued = 1;
+        work->next = 0;
+        *queue_tail = work;
+        queue_tail = &work->next;
+    }
+    irq_restore(flags);
+    return raised;
+}
+
+int softirq_run(void) {
+    if (running) return 0;
+    running = 1;
+
+    while (queue_head) {
+        softirq_work_t *work = queue_head;
+        queue_head = work->next;
+        if (!queue_head) queue_tail = &queue_head;
+
+        // Cleared first, so the handler may raise it again for more work
+        work->queued = 0;
+
+        __asm__ volatile("sti" : : : "memory");
+        work->fn(work->ctx);
+        __asm__ volatile("cli" : : : "memory");
+    }
+
+    running = 0;
+    return 1;
+}
@@ -0,0 +1,37 @@
+#ifndef SOFTIRQ_H
+#define SOFTIRQ_H
+
+/**
+ * Deferred interrupt work (bottom halves)
+ * An IRQ handler raises a work item and returns; the queue is drained on
+ * the way out of the interrupt with interrupts enabled, so the handler
+ * itself only touches the device. Raising an already queued item does
+ * nothing - it runs once with whatever state has piled up.
+ */
+
+typedef struct softirq_work {
+    struct softirq_work *next;
+    void (*fn)(void *ctx);
+    void *ctx;
+    volatile int queued;
+} softirq_work_t;
+
+/* Static initializer, for work that may be raised before any init code */
+#define SOFTIRQ_WORK_INIT(fn, ctx)  { 0, (fn), (ctx), 0 }
+
+void softirq_init_work(softirq_work_t *work, void (*fn)(void *ctx), void *ctx);
+
+/**
+ * Queue work to run at interrupt exit (any context)
+ * Returns 0 if it was already queued
+ */
+int softirq_raise(softirq_work_t *work);
+
+/**
+ * Run queued work with interrupts enabled; call with interrupts off
+ * Returns 0 without running anything when it interrupted an earlier
+ * drain - that outer loop picks the new work up
+ */
+int softirq_run(void);
+
+#endif // SOFTIRQ_H
@@ -0,0 +1,300 @@
+/**
+ * MaahiOS kernel log
+ *
+ * Ring layout: each record is a 16-bit length header followed by the
+ * text, padded to an even size so a header never wraps. Producers claim
+ * space by advancing ring_head with a compare-and-swap, copy the text
+ * and publish the record by storing its header last. A record still
+ * being written reads as length 0 and stops the consumer until its
+ * producer finishes - an interrupt that logs in the middle of another
+ * message claims space after it and never waits for it.
+ *
+ * The consumer (UART interrupt or klog_flush, always with interrupts
+ * off) zeroes every byte it sends, so free space always reads as
+ * "not published yet".
+ */
+
+#include "klog.h"
+#include "../irq/irq_manager.h"
+#include "../cpu/cpu.h"
+#include <stdarg.h>
+
+/* COM1 */
+#define UART_BASE       0x3F8
+#define UART_DATA       (UART_BASE + 0)
+#define UART_IER        (UART_BASE + 1)     // DLAB=1: divisor high
+#define UART_IIR        (UART_BASE + 2)     // Write: FIFO control
+#define UART_LCR        (UART_BASE + 3)
+#define UART_MCR        (UART_BASE + 4)
+#define UART_LSR        (UART_BASE + 5)
+
+#define UART_IRQ        4
+#define UART_FIFO_SIZE  16
+#define LSR_THRE        0x20                // Transmit holding register empty
+#define IER_THRE        0x02
+#define MCR_OUT2        0x08                // Gates the UART interrupt onto the ISA line
+
+#define RING_MASK       (KLOG_RING_SIZE - 1)
+
+static volatile uint8_t ring[KLOG_RING_SIZE] __attribute__((aligned(2)));
+static volatile uint32_t ring_head = 0;     // Producers: next free byte
+static uint32_t ring_tail = 0;              // Consumer: start of the oldest record
+static uint32_t tx_pos = 0;                 // Consumer: bytes of that record already sent
+
+static int level = KLOG_DEFAULT_LEVEL;
+static int irq_driven = 0;
+static volatile uint32_t dropped = 0;
+
+static inline void outb(uint16_t port, uint8_t val) {
+    __asm__ volatile("outb %0, %1" : : "a"(val), "Nd"(port));
+}
+
+static inline uint8_t inb(uint16_t port) {
+    uint8_t ret;
+    __asm__ volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
+    return ret;
+}
+
+/**
+ * Consumer: move up to max bytes into the UART; returns bytes sent
+ * Interrupts must be off
+ */
+static int ring_drain(int max) {
+    int sent = 0;
+
+    while (sent < max && ring_tail != ring_head) {
+        volatile uint16_t *header = (volatile uint16_t *)&ring[ring_tail & RING_MASK];
+        uint32_t length = *header;
+        if (length == 0) break;     // Claimed but not published yet
+
+        while (sent < max && tx_pos < length) {
+            uint32_t at = (ring_tail + 2 + tx_pos) & RING_MASK;
+            outb(UART_DATA, ring[at]);
+            ring[at] = 0;
+            tx_pos++;
+            sent++;
+        }
+        if (tx_pos < length) break;
+
+        *header = 0;
+        __atomic_store_n(&ring_tail, ring_tail + ((2 + length + 1) & ~1u), __ATOMIC_RELEASE);
+        tx_pos = 0;
+    }
+    return sent;
+}
+
+/**
+ * Fill the transmit FIFO if it is empty - the THRE interrupt takes over
+ * from there
+ */
+static void klog_kick(void) {
+    uint32_t flags = irq_save();
+    if (inb(UART_LSR) & LSR_THRE) ring_drain(UART_FIFO_SIZE);
+    irq_restore(flags);
+}
+
+/**
+ * IRQ4 - the FIFO ran empty
+ */
+static void klog_uart_irq(void *ctx) {
+    (void)ctx;
+    (void)inb(UART_IIR);    // Reading IIR acknowledges THRE
+    if (inb(UART_LSR) & LSR_THRE) ring_drain(UART_FIFO_SIZE);
+}
+
+/**
+ * Producer: claim, copy and publish one record (lock-free)
+ */
+static void ring_write(const char *text, uint32_t length) {
+    uint32_t need = (2 + length + 1) & ~1u;
+    uint32_t start;
+
+    do {
+        start = ring_head;
+        if (start + need - __atomic_load_n(&ring_tail, __ATOMIC_ACQUIRE) > KLOG_RING_SIZE) {
+            __atomic_fetch_add(&dropped, 1, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&ring_head, &start, start + need, 0,
+                                          __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    for (uint32_t i = 0; i < length; i++) {
+        ring[(start + 2 + i) & RING_MASK] = text[i];
+    }
+    __atomic_store_n((volatile uint16_t *)&ring[start & RING_MASK], (uint16_t)length, __ATOMIC_RELEASE);
+}
+
+/* ---- Formatting ---- */
+
+typedef struct {
+    char *buf;
+    int pos;
+    int size;
+} line_t;
+
+static void put_char(line_t *line, char c) {
+    if (line->pos < line->size) line->buf[line->pos++] = c;
+}
+
+static void put_padded(line_t *line, const char *s, int length, int width, int left, char pad) {
+    if (!left) for (int i = length; i < width; i++) put_char(line, pad);
+    for (int i = 0; i < length; i++) put_char(line, s[i]);
+    if (left) for (int i = length; i < width; i++) put_char(line, ' ');
+}
+
+static void put_number(line_t *line, uint32_t value, int base, int upper, int negative,
+                       int width, int left, char pad) {
+    const char *digits = upper ? "0123456789ABCDEF" : "0123456789abcdef";
+    char tmp[12];
+    int n = 0;
+
+    do {
+        tmp[n++] = digits[value % base];
+        value /= base;
+    } while (value);
+    if (negative) {
+        if (pad == '0') {
+            put_char(line, '-');    // Sign before the zeros
+            width--;
+        } else {
+            tmp[n++] = '-';
+        }
+    }
+
+    char out[12];
+    for (int i = 0; i < n; i++) out[i] = tmp[n - 1 - i];
+    put_padded(line, out, n, width, left, pad);
+}
+
+static void format(line_t *line, const char *fmt, va_list args) {
+    for (; *fmt; fmt++) {
+        if (*fmt != '%') {
+            put_char(line, *fmt);
+            continue;
+        }
+        fmt++;
+
+        int left = 0, width = 0;
+        char pad = ' ';
+        if (*fmt == '-') { left = 1; fmt++; }
+        if (*fmt == '0') { pad = '0'; fmt++; }
+        while (*fmt >= '0' && *fmt <= '9') width = width * 10 + (*fmt++ - '0');
+
+        switch (*fmt) {
+            case 's': {
+                const char *s = va_arg(args, const char *);
+                if (!s) s = "(null)";
+                int length = 0;
+                while (s[length]) length++;
+                put_padded(line, s, length, width, left, ' ');
+                break;
+            }
+            case 'c': {
+                char c = (char)va_arg(args, int);
+                put_padded(line, &c, 1, width, left, ' ');
+                break;
+            }
+            case 'd':
+            case 'i': {
+                int v = va_arg(args, int);
+                put_number(line, v < 0 ? -(uint32_t)v : (uint32_t)v, 10, 0, v < 0, width, left, pad);
+                break;
+            }
+            case 'u':
+                put_number(line, va_arg(args, uint32_t), 10, 0, 0, width, left, pad);
+                break;
+            case 'x':
+            case 'X':
+                put_number(line, va_arg(args, uint32_t), 16, *fmt == 'X', 0, width, left, pad);
+                break;
+            case 'p':
+                put_char(line, '0');
+                put_char(line, 'x');
+                put_number(line, (uint32_t)va_arg(args, void *), 16, 0, 0, 8, 0, '0');
+                break;
+            case '%':
+                put_char(line, '%');
+                break;
+            case '\0':
+                return;
+            default:
+                put_char(line, '%');
+                put_char(line, *fmt);
+                break;
+        }
+    }
+}
+
+/* ---- Interface ---- */
+
+void klog_init(void) {
+    outb(UART_IER, 0x00);           // No interrupts yet
+    outb(UART_LCR, 0x80);           // DLAB
+    outb(UART_DATA, 0x01);          // Divisor 1 = 115200 baud
+    outb(UART_IER, 0x00);
+    outb(UART_LCR, 0x03);           // 8N1
+    outb(UART_IIR, 0xC7);           // FIFOs on and cleared, 14-byte RX threshold
+    outb(UART_MCR, 0x03);           // DTR, RTS
+}
+
+void klog_start_irq(void) {
+    if (!irq_register_handler(UART_IRQ, klog_uart_irq, 0)) return;
+
+    uint32_t flags = irq_save();
+    irq_driven = 1;
+    outb(UART_MCR, 0x03 | MCR_OUT2);
+    outb(UART_IER, IER_THRE);
+    irq_enable(UART_IRQ);
+    irq_restore(flags);
+
+    klog_kick();
+}
+
+void klog(int msg_level, const char *tag, const char *fmt, ...) {
+    if (msg_level > level) return;
+
+    static const char *prefixes[] = { "ERROR: ", "WARN: ", "", "" };
+    char buf[KLOG_LINE_MAX];
+    line_t line = { buf, 0, KLOG_LINE_MAX - 1 };    // Room for the newline
+
+    put_char(&line, '[');
+    while (*tag) put_char(&line, *tag++);
+    put_char(&line, ']');
+    put_char(&line, ' ');
+    for (const char *p = prefixes[msg_level & 3]; *p; p++) put_char(&line, *p);
+
+    va_list args;
+    va_start(args, fmt);
+    format(&line, fmt, args);
+    va_end(args);
+
+    if (line.pos == 0 || buf[line.pos - 1] != '\n') buf[line.pos++] = '\n';
+    ring_write(buf, line.pos);
+
+    if (irq_driven) {
+        klog_kick();
+    } else {
+        klog_flush();
+    }
+}
+
+void klog_set_level(int new_level) {
+    if (new_level >= KLOG_ERROR && new_level <= KLOG_DEBUG) level = new_level;
+}
+
+int klog_get_level(void) {
+    return level;
+}
+
+void klog_flush(void) {
+    uint32_t flags = irq_save();
+    while (ring_tail != ring_head) {
+        while (!(inb(UART_LSR) & LSR_THRE));
+        if (ring_drain(UART_FIFO_SIZE) == 0) break;     // Unpublished record - its producer was interrupted
+    }
+    irq_restore(flags);
+}
+
+uint32_t klog_get_dropped(void) {
+    return dropped;
+}
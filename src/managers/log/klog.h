@@ -0,0 +1,56 @@
+#ifndef KLOG_H
+#define KLOG_H
+
+#include <stdint.h>
+
+/**
+ * Kernel log
+ * Messages are formatted into a lock-free ring and sent to COM1 by the
+ * UART's transmit-empty interrupt (IRQ4), so a log call costs a format
+ * and a copy instead of a busy-wait per byte. Any context may log,
+ * including interrupt handlers. Until klog_start_irq() the ring is
+ * drained synchronously, so early boot messages are never held back.
+ */
+
+/* Levels - messages above the current level are discarded */
+#define KLOG_ERROR              0
+#define KLOG_WARN               1
+#define KLOG_INFO               2
+#define KLOG_DEBUG              3
+
+#define KLOG_DEFAULT_LEVEL      KLOG_INFO
+
+#define KLOG_RING_SIZE          16384   // Bytes, power of two
+#define KLOG_LINE_MAX           256     // Longer messages are cut
+
+/**
+ * Set up the UART (115200 8N1, FIFOs on) - first thing at boot
+ */
+void klog_init(void);
+
+/**
+ * Switch to interrupt-driven output once IRQ4 can be routed
+ */
+void klog_start_irq(void);
+
+/**
+ * One line: "[tag] message". A trailing newline is added if missing.
+ * Formats: %s %c %d %u %x %X %p, with an optional '-' or '0' flag and
+ * a width (%08x, %-12s).
+ */
+void klog(int level, const char *tag, const char *fmt, ...) __attribute__((format(printf, 3, 4)));
+
+void klog_set_level(int level);
+int klog_get_level(void);
+
+/**
+ * Send everything queued, busy-waiting on the UART (panics, reboots)
+ */
+void klog_flush(void);
+
+/**
+ * Messages lost because the ring was full
+ */
+uint32_t klog_get_dropped(void);
+
+#endif // KLOG_H
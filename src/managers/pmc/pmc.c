@@ -0,0 +1,165 @@
+/**
+ * MaahiOS performance counters
+ * Only the architectural events of CPUID leaf 0xA are used, so the same
+ * encodings work on every Intel core and on KVM's virtual PMU. The leaf
+ * also says which of them the CPU can count; missing ones are left
+ * unprogrammed. A hypervisor can advertise a PMU whose counters never
+ * move, so pmc_init checks that instructions retired actually counts
+ * before it hands the counters to anyone.
+ */
+
+#include "pmc.h"
+#include "../cpu/cpu.h"
+#include "../log/klog.h"
+
+#define CPUID_LEAF_PERFMON      0x0A
+
+/* Architectural MSRs */
+#define MSR_PMC0                0x0C1
+#define MSR_PERFEVTSEL0         0x186
+#define MSR_PERF_GLOBAL_CTRL    0x38F       // Perfmon v2+: per-counter enable
+
+/* IA32_PERFEVTSELx */
+#define EVTSEL_USR              (1 << 16)
+#define EVTSEL_OS               (1 << 17)
+#define EVTSEL_EN               (1 << 22)
+
+#define SELFTEST_LOOPS          1000
+
+typedef struct {
+    uint8_t event;
+    uint8_t umask;
+    uint8_t unavailable_bit;                // Leaf 0xA EBX: set = not supported
+    const char *name;
+} pmc_event_t;
+
+static const pmc_event_t events[PMC_EVENTS] = {
+    [PMC_EVENT_INSTRUCTIONS]  = { 0xC0, 0x00, 1, "instructions" },
+    [PMC_EVENT_LLC_MISSES]    = { 0x2E, 0x41, 4, "llc-misses" },
+    [PMC_EVENT_BRANCH_MISSES] = { 0xC5, 0x00, 6, "branch-misses" },
+    [PMC_EVENT_CYCLES]        = { 0x3C, 0x00, 0, "cycles" },
+};
+
+static pmc_info_t info;
+
+static void cpuid(uint32_t leaf, uint32_t *eax, uint32_t *ebx, uint32_t *ecx, uint32_t *edx) {
+    __asm__ volatile("cpuid"
+                     : "=a"(*eax), "=b"(*ebx), "=c"(*ecx), "=d"(*edx)
+                     : "a"(leaf), "c"(0));
+}
+
+static void set_cr4_pce(int on) {
+    uint32_t cr4;
+    __asm__ volatile("mov %%cr4, %0" : "=r"(cr4));
+    if (on) {
+        cr4 |= CR4_PCE;
+    } else {
+        cr4 &= ~CR4_PCE;
+    }
+    __asm__ volatile("mov %0, %%cr4" : : "r"(cr4));
+}
+
+/**
+ * Stop every counter we programmed
+ */
+static void pmc_disable(void) {
+    for (int e = 0; e < PMC_EVENTS; e++) {
+        if (info.events & (1u << e)) cpu_wrmsr(MSR_PERFEVTSEL0 + e, 0);
+    }
+    info.events = 0;
+    set_cr4_pce(0);
+}
+
+uint32_t pmc_init(void) {
+    uint32_t eax, ebx, ecx, edx;
+
+    info.version = 0;
+    info.counters = 0;
+    info.width = 0;
+    info.events = 0;
+    info.tsc_khz = cpu_tsc_khz();
+
+    cpuid(0, &eax, &ebx, &ecx, &edx);
+    uint32_t max_leaf = eax;
+    if (max_leaf >= 1) cpuid(1, &eax, &ebx, &ecx, &edx);
+    if (max_leaf < CPUID_LEAF_PERFMON || !(edx & CPUID_EDX_MSR)) {
+        klog(KLOG_INFO, "PMC", "No architectural PMU - benchmarks report TSC cycles only");
+        return 0;
+    }
+
+    // EAX: version [7:0], counters [15:8], width [23:16], EBX length [31:24]
+    cpuid(CPUID_LEAF_PERFMON, &eax, &ebx, &ecx, &edx);
+    info.version = eax & 0xFF;
+    info.counters = (eax >> 8) & 0xFF;
+    info.width = (eax >> 16) & 0xFF;
+    uint32_t known = (eax >> 24) & 0xFF;
+    if (info.version == 0 || info.counters == 0 || info.width == 0) {
+        info.version = 0;
+        info.counters = 0;
+        info.width = 0;
+        klog(KLOG_INFO, "PMC", "No architectural PMU - benchmarks report TSC cycles only");
+        return 0;
+    }
+
+    for (uint32_t e = 0; e < PMC_EVENTS && e < info.counters; e++) {
+        if (events[e].unavailable_bit >= known || (ebx & (1u << events[e].unavailable_bit))) continue;
+        cpu_wrmsr(MSR_PERFEVTSEL0 + e, 0);
+        cpu_wrmsr(MSR_PMC0 + e, 0);
+        cpu_wrmsr(MSR_PERFEVTSEL0 + e,
+                  events[e].event | ((uint32_t)events[e].umask << 8) | EVTSEL_USR | EVTSEL_OS | EVTSEL_EN);
+        info.events |= 1u << e;
+    }
+    if (info.version >= 2 && info.events) {
+        cpu_wrmsr(MSR_PERF_GLOBAL_CTRL, cpu_rdmsr(MSR_PERF_GLOBAL_CTRL) | info.events);
+    }
+
+    // A PMU that never counts is worse than none: benchmarks would print zeros
+    if (info.events & (1u << PMC_EVENT_INSTRUCTIONS)) {
+        uint64_t before = pmc_read(PMC_EVENT_INSTRUCTIONS);
+        for (volatile int i = 0; i < SELFTEST_LOOPS; i++);
+        if (pmc_read(PMC_EVENT_INSTRUCTIONS) - before < SELFTEST_LOOPS) {
+            pmc_disable();
+            klog(KLOG_WARN, "PMC", "Perfmon v%u advertised but counters do not move - disabled",
+                 info.version);
+            return 0;
+        }
+    }
+    if (!info.events) {
+        klog(KLOG_INFO, "PMC", "Perfmon v%u without any usable event", info.version);
+        return 0;
+    }
+
+    set_cr4_pce(1);
+
+    char names[64];
+    int n = 0;
+    for (int e = 0; e < PMC_EVENTS; e++) {
+        if (!(info.events & (1u << e))) continue;
+        for (const char *s = events[e].name; *s && n < (int)sizeof(names) - 2; s++) names[n++] = *s;
+        names[n++] = ' ';
+    }
+    names[n ? n - 1 : 0] = '\0';
+    klog(KLOG_INFO, "PMC", "Perfmon v%u, %u counters x %u bits: %s (RDPMC enabled for Ring 3)",
+         info.version, info.counters, info.width, names);
+    return info.events;
+}
+
+void pmc_get_info(pmc_info_t *out) {
+    *out = info;
+}
+
+uint32_t pmc_region_per(const pmc_region_t *region, int event, uint32_t units, uint32_t scale) {
+    if (units == 0) return 0;
+    uint64_t count = event == PMC_EVENTS ? region->cycles : region->count[event];
+
+    // count * scale as 96 bits, then two 32-bit divides
+    uint64_t lo = (uint64_t)(uint32_t)count * scale;
+    uint64_t hi = (count >> 32) * scale + (lo >> 32);
+    if ((hi >> 32) >= units) return 0xFFFFFFFF;
+
+    uint32_t q_hi, q_lo, r;
+    __asm__("divl %4" : "=a"(q_hi), "=d"(r) : "a"((uint32_t)hi), "d"((uint32_t)(hi >> 32)), "rm"(units));
+    if (q_hi) return 0xFFFFFFFF;
+    __asm__("divl %4" : "=a"(q_lo), "=d"(r) : "a"((uint32_t)lo), "d"(r), "rm"(units));
+    return q_lo;
+}
@@ -0,0 +1,106 @@
+#ifndef PMC_H
+#define PMC_H
+
+#include <stdint.h>
+
+/**
+ * Performance counters
+ * On CPUs with Intel architectural performance monitoring (CPUID leaf
+ * 0xA - including KVM's virtual PMU) the kernel programs one
+ * general-purpose counter per PMC_EVENT_* at boot, counting in both
+ * rings, and sets CR4.PCE so Ring 3 can read them with RDPMC. Counter
+ * N always holds event N, and the counters run freely and are shared by
+ * every process, so a measurement is the difference of two reads taken
+ * on either side of the region (pmc_region_t below).
+ *
+ * Without a usable PMU (QEMU TCG, AMD, pmu=off) no event is counting,
+ * RDPMC stays disabled for Ring 3 and regions record TSC cycles only.
+ */
+
+/* Events, also the counter each one is programmed on */
+#define PMC_EVENT_INSTRUCTIONS  0       // Instructions retired
+#define PMC_EVENT_LLC_MISSES    1       // Last-level cache misses
+#define PMC_EVENT_BRANCH_MISSES 2       // Mispredicted branches retired
+#define PMC_EVENT_CYCLES        3       // Unhalted core cycles
+#define PMC_EVENTS              4
+
+typedef struct {
+    uint32_t version;                   // Architectural perfmon version, 0 = none
+    uint32_t counters;                  // General-purpose counters on the CPU
+    uint32_t width;                     // Counter width in bits
+    uint32_t events;                    // Bit (1 << PMC_EVENT_*) per event counting
+    uint32_t tsc_khz;
+} pmc_info_t;
+
+/*
+ * Benchmark region - accumulates TSC cycles and counter deltas over
+ * any number of start/stop pairs
+ */
+typedef struct {
+    uint32_t events;                    // Copied from pmc_info_t by pmc_region_init
+    uint32_t runs;
+    uint64_t mask;                      // Counter width mask, for wrap-around
+    uint64_t cycles;                    // TSC
+    uint64_t count[PMC_EVENTS];
+    uint64_t start_tsc;
+    uint64_t start[PMC_EVENTS];
+} pmc_region_t;
+
+/**
+ * Read a counter (Ring 0, or Ring 3 when its event is in pmc_info_t)
+ */
+static inline uint64_t pmc_read(uint32_t counter) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdpmc" : "=a"(lo), "=d"(hi) : "c"(counter));
+    return ((uint64_t)hi << 32) | lo;
+}
+
+static inline void pmc_region_init(pmc_region_t *region, const pmc_info_t *info) {
+    region->events = 0;
+    region->runs = 0;
+    region->mask = 0;
+    region->cycles = 0;
+    for (int e = 0; e < PMC_EVENTS; e++) region->count[e] = 0;
+    if (!info || !info->width) return;
+    region->events = info->events;
+    region->mask = info->width >= 64 ? ~0ULL : (1ULL << info->width) - 1;
+}
+
+static inline void pmc_region_start(pmc_region_t *region) {
+    for (int e = 0; e < PMC_EVENTS; e++) {
+        if (region->events & (1u << e)) region->start[e] = pmc_read(e);
+    }
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    region->start_tsc = ((uint64_t)hi << 32) | lo;
+}
+
+static inline void pmc_region_stop(pmc_region_t *region) {
+    uint32_t lo, hi;
+    __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+    region->cycles += (((uint64_t)hi << 32) | lo) - region->start_tsc;
+    for (int e = 0; e < PMC_EVENTS; e++) {
+        if (region->events & (1u << e)) {
+            region->count[e] += (pmc_read(e) - region->start[e]) & region->mask;
+        }
+    }
+    region->runs++;
+}
+
+/* Kernel side */
+
+/**
+ * Detect the PMU, program the counters and enable RDPMC for Ring 3
+ * Needs cpu_init and the TSC calibration; returns the events counting
+ */
+uint32_t pmc_init(void);
+
+void pmc_get_info(pmc_info_t *info);
+
+/**
+ * count[event] * scale / units, saturating; cycles for PMC_EVENTS
+ * (kernel has no 64-bit divide, so benchmarks report through this)
+ */
+uint32_t pmc_region_per(const pmc_region_t *region, int event, uint32_t units, uint32_t scale);
+
+#endif // PMC_H
@@ -4,6 +4,9 @@
  */
 
 #include "process_manager.h"
+#include "../log/klog.h"
+#include "../cpu/cpu.h"
+#include "../scheduler/scheduler.h"
 
 /* External functions */
 extern void* kmalloc(uint32_t size);
@@ -25,6 +28,43 @@ static uint32_t next_stack_top = USER_STACK_BASE;
 #define KERNEL_INT_STACK_SIZE 0x00004000  /* 16KB per process */
 static uint32_t next_kernel_stack_top = KERNEL_INT_STACK_BASE;
 
+/* CPU accounting - cycles since acct_stamp belong to the current process in acct_mode */
+static int have_tsc = 0;
+static int acct_mode = PROCESS_MODE_IDLE;
+static uint64_t acct_stamp = 0;
+static uint64_t idle_cycles = 0;
+
+/**
+ * Zero a new PCB's accounting (kmalloc memory is not cleared)
+ */
+static void process_init_accounting(process_t *pcb) {
+    pcb->user_cycles = 0;
+    pcb->kernel_cycles = 0;
+    pcb->syscalls = 0;
+    pcb->page_faults = 0;
+    pcb->switches = 0;
+    timer_setup(&pcb->wake_timer, 0, 0);
+}
+
+/**
+ * Charge the cycles since the last stamp (interrupts off)
+ */
+static void account_charge(void) {
+    if (!have_tsc) return;
+    uint64_t now = cpu_rdtsc();
+    uint64_t elapsed = now - acct_stamp;
+    acct_stamp = now;
+    
+    process_t *pcb = process_get_by_pid(scheduler_get_current_pid());
+    if (!pcb || acct_mode == PROCESS_MODE_IDLE) {
+        idle_cycles += elapsed;
+    } else if (acct_mode == PROCESS_MODE_USER) {
+        pcb->user_cycles += elapsed;
+    } else {
+        pcb->kernel_cycles += elapsed;
+    }
+}
+
 /**
  * Initialize process manager
  */
@@ -34,48 +74,29 @@ void process_manager_init(void) {
         process_table[i] = 0;
     }
     next_pid = 1;
-}
-
-/* Serial debug helper */
-static void serial_print(const char *str) {
-    while (*str) {
-        while ((*(volatile unsigned char*)0x3FD & 0x20) == 0);
-        *(volatile unsigned char*)0x3F8 = *str++;
-    }
-}
-
-static void serial_hex32(uint32_t value) {
-    char hex[] = "0123456789ABCDEF";
-    for (int i = 28; i >= 0; i -= 4) {
-        while ((*(volatile unsigned char*)0x3FD & 0x20) == 0);
-        *(volatile unsigned char*)0x3F8 = hex[(value >> i) & 0xF];
-    }
+    
+    have_tsc = cpu_has_tsc();
+    acct_mode = PROCESS_MODE_IDLE;
+    acct_stamp = have_tsc ? cpu_rdtsc() : 0;
+    idle_cycles = 0;
 }
 
 /**
  * Create sysman process (PID 1) and start it immediately
  */
 int process_create_sysman(uint32_t sysman_address) {
-    // ULTRA EARLY debug - before ANYTHING else
-    *(volatile unsigned char*)0x3F8 = 'X';
-    *(volatile unsigned char*)0x3F8 = '\n';
-    
-    serial_print("[PROCESS] Entered process_create_sysman\n");
-    serial_print("[PROCESS] Creating sysman at 0x");
-    serial_hex32(sysman_address);
-    serial_print("\n");
+    klog(KLOG_INFO, "PROCESS", "Creating sysman at 0x%08x", sysman_address);
     
-    serial_print("[PROCESS] About to call kmalloc...\n");
     process_t *pcb = (process_t *)kmalloc(sizeof(process_t));
-    serial_print("[PROCESS] kmalloc returned\n");
     if (!pcb) {
-        serial_print("[PROCESS] ERROR: kmalloc failed!\n");
+        klog(KLOG_ERROR, "PROCESS", "kmalloc failed!");
         return -1;
     }
     
     pcb->pid = next_pid++;
     pcb->entry_point = sysman_address;
     pcb->state = PROCESS_STATE_RUNNING;
+    process_init_accounting(pcb);
     
     /* Allocate unique user stack */
     uint32_t stack_top = next_stack_top;
@@ -85,29 +106,27 @@ int process_create_sysman(uint32_t sysman_address) {
     uint32_t kernel_stack_top = next_kernel_stack_top;
     next_kernel_stack_top += KERNEL_INT_STACK_SIZE;
     
-    serial_print("[PROCESS] User stack: 0x");
-    serial_hex32(stack_top);
-    serial_print(" Kernel stack: 0x");
-    serial_hex32(kernel_stack_top);
-    serial_print("\n");
+    klog(KLOG_DEBUG, "PROCESS", "User stack: 0x%08x Kernel stack: 0x%08x", stack_top, kernel_stack_top);
     
     process_table[pcb->pid - 1] = pcb;
     
+    /* Sysman starts here rather than from the scheduler's queue */
+    process_account_switch(pcb->pid);
+    scheduler_set_current_pid(pcb->pid);
+    
     /* CRITICAL: Set TSS.esp0 to this process's kernel interrupt stack */
     extern void gdt_set_kernel_stack(unsigned int esp0_value);
-    serial_print("[PROCESS] Setting TSS kernel stack\n");
     gdt_set_kernel_stack(kernel_stack_top);
     
     /* Enable interrupts before jumping to Ring 3 */
-    serial_print("[PROCESS] Enabling interrupts\n");
     __asm__ volatile("sti");
     
     /* Jump to Ring 3 - NEVER RETURNS */
-    serial_print("[PROCESS] Jumping to Ring 3...\n");
+    klog(KLOG_DEBUG, "PROCESS", "Jumping to Ring 3...");
     extern void ring3_switch_with_stack(uint32_t entry_point, uint32_t stack_top);
     ring3_switch_with_stack(pcb->entry_point, stack_top);
     
-    serial_print("[PROCESS] ERROR: Returned from ring3_switch!\n");
+    klog(KLOG_ERROR, "PROCESS", "Returned from ring3_switch!");
     return pcb->pid;
 }
 
@@ -129,6 +148,7 @@ int process_create(uint32_t entry_point) {
     pcb->pid = next_pid++;
     pcb->entry_point = entry_point;
     pcb->state = PROCESS_STATE_READY;  /* Mark as READY, not RUNNING */
+    process_init_accounting(pcb);
     
     /* Allocate unique user stack */
     uint32_t stack_top = next_stack_top;
@@ -176,4 +196,77 @@ int process_manager_get_count(void) {
     return count;
 }
 
+int process_account_mode(int mode) {
+    uint32_t flags = irq_save();
+    account_charge();
+    int prev = acct_mode;
+    acct_mode = mode;
+    irq_restore(flags);
+    return prev;
+}
+
+void process_account_syscall(void) {
+    uint32_t flags = irq_save();
+    account_charge();
+    acct_mode = PROCESS_MODE_KERNEL;
+    process_t *pcb = process_get_by_pid(scheduler_get_current_pid());
+    if (pcb) pcb->syscalls++;
+    irq_restore(flags);
+}
+
+void process_account_page_fault(void) {
+    process_t *pcb = process_get_by_pid(scheduler_get_current_pid());
+    if (pcb) pcb->page_faults++;
+}
+
+/**
+ * Called before the scheduler changes the current pid: the time up to
+ * the switch goes to the process being left
+ */
+void process_account_switch(int pid) {
+    uint32_t flags = irq_save();
+    account_charge();
+    acct_mode = PROCESS_MODE_USER;
+    process_t *prev = process_get_by_pid(scheduler_get_current_pid());
+    process_t *pcb = process_get_by_pid(pid);
+    if (prev && prev != pcb) prev->state = PROCESS_STATE_READY;
+    if (pcb) {
+        pcb->switches++;
+        pcb->state = PROCESS_STATE_RUNNING;
+    }
+    irq_restore(flags);
+}
 
+int process_get_stats(proc_stats_t *out, int max) {
+    int count = 0;
+    if (!out || max <= 0) return 0;
+    
+    uint32_t flags = irq_save();
+    account_charge();   // Bring the running process up to date
+    
+    proc_stats_t *idle = &out[count++];
+    idle->pid = 0;
+    idle->state = PROCESS_STATE_RUNNING;
+    idle->user_cycles = 0;
+    idle->kernel_cycles = idle_cycles;
+    idle->syscalls = 0;
+    idle->page_faults = 0;
+    idle->switches = 0;
+    idle->entry_point = 0;
+    
+    for (int i = 0; i < MAX_PROCESSES && count < max; i++) {
+        process_t *pcb = process_table[i];
+        if (!pcb) continue;
+        proc_stats_t *rec = &out[count++];
+        rec->pid = pcb->pid;
+        rec->state = pcb->state;
+        rec->user_cycles = pcb->user_cycles;
+        rec->kernel_cycles = pcb->kernel_cycles;
+        rec->syscalls = pcb->syscalls;
+        rec->page_faults = pcb->page_faults;
+        rec->switches = pcb->switches;
+        rec->entry_point = pcb->entry_point;
+    }
+    irq_restore(flags);
+    return count;
+}
@@ -2,11 +2,17 @@
 #define PROCESS_MANAGER_H
 
 #include <stdint.h>
+#include "../timer/timer.h"
 
 /* Process states */
 #define PROCESS_STATE_READY    1
 #define PROCESS_STATE_RUNNING  2
 
+/* CPU accounting modes (process_account_mode) */
+#define PROCESS_MODE_USER      0
+#define PROCESS_MODE_KERNEL    1
+#define PROCESS_MODE_IDLE      2    /* hlt waiting for an interrupt */
+
 /* Process Control Block (PCB) */
 typedef struct {
     int pid;
@@ -14,8 +20,30 @@ typedef struct {
     uint32_t state;
     uint32_t user_stack_top;    /* User stack pointer */
     uint32_t kernel_stack_top;  /* Kernel interrupt stack pointer */
+    
+    /* Accounting - TSC cycles, zero without a TSC */
+    uint64_t user_cycles;
+    uint64_t kernel_cycles;     /* Syscalls and interrupts taken in ring 3 */
+    uint32_t syscalls;
+    uint32_t page_faults;
+    uint32_t switches;          /* Times the scheduler switched to it */
+
+    /* timer_sleep_ns - stays valid if the slice ends mid-sleep */
+    ktimer_t wake_timer;
 } process_t;
 
+/* One SYSCALL_PROC_STATS record */
+typedef struct {
+    int32_t pid;                /* 0 = idle, and time before the first process */
+    uint32_t state;
+    uint64_t user_cycles;
+    uint64_t kernel_cycles;
+    uint32_t syscalls;
+    uint32_t page_faults;
+    uint32_t switches;
+    uint32_t entry_point;
+} proc_stats_t;
+
 /**
  * Initialize process manager
  */
@@ -43,4 +71,29 @@ process_t* process_get_by_pid(int pid);
  */
 int process_manager_get_count(void);
 
+/**
+ * CPU accounting: cycles since the last call are charged to the current
+ * process in the old mode. Returns the old mode so nested paths (an
+ * interrupt taken in ring 3, a hlt inside a syscall) can restore it.
+ */
+int process_account_mode(int mode);
+
+/**
+ * Syscall entry: count it and switch to kernel mode
+ * (the dispatcher switches back to user mode on return)
+ */
+void process_account_syscall(void);
+void process_account_page_fault(void);
+
+/**
+ * The scheduler is about to run pid in ring 3
+ */
+void process_account_switch(int pid);
+
+/**
+ * Copy up to max records: idle first, then every process by pid
+ * Returns the number of records written
+ */
+int process_get_stats(proc_stats_t *out, int max);
+
 #endif // PROCESS_MANAGER_H
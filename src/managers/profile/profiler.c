@@ -0,0 +1,101 @@
+/**
+ * MaahiOS sampling profiler
+ * The sample timer is an ordinary wheel timer that re-arms itself, so
+ * its callback runs inside the timer interrupt and irq_get_frame() is
+ * the code that interrupt landed on - kernel or user, including code
+ * running with interrupts enabled inside a syscall. Code that runs with
+ * IF=0 is never sampled; its time shows up at the next sti.
+ */
+
+#include "profiler.h"
+#include "../irq/irq_manager.h"
+#include "../timer/timer.h"
+#include "../timer/clock.h"
+#include "../scheduler/scheduler.h"
+#include "../process/process_manager.h"
+#include "../cpu/cpu.h"
+
+#define SAMPLE_MASK     (PROFILE_MAX_SAMPLES - 1)
+
+static profile_sample_t *samples = 0;
+static uint32_t head = 0;       // Written by the timer
+static uint32_t tail = 0;       // Read by profile_read
+static uint32_t dropped = 0;
+static uint32_t rate_hz = 0;
+static uint64_t period_ns = 0;
+static ktimer_t sample_timer;
+
+static void profile_sample(ktimer_t *timer) {
+    // Keep the grid: the next deadline follows the last, not this
+    // interrupt - unless sampling fell a whole period behind
+    uint64_t next = timer->expires + period_ns;
+    uint64_t now = clock_monotonic_ns();
+    if (next <= now) next = now + period_ns;
+    timer_add(timer, next);
+
+    const irq_frame_t *frame = irq_get_frame();
+    if (!frame) return;
+    if (head - tail >= PROFILE_MAX_SAMPLES) {
+        dropped++;
+        return;
+    }
+
+    profile_sample_t *s = &samples[head & SAMPLE_MASK];
+    s->eip = frame->eip;
+    s->ring = frame->cs & 3;
+    s->pid = (int16_t)scheduler_get_current_pid();
+    head++;
+}
+
+int profile_start(uint32_t hz) {
+    extern void *kmalloc(uint32_t size);
+
+    if (!samples) {
+        samples = (profile_sample_t *)kmalloc(PROFILE_MAX_SAMPLES * sizeof(profile_sample_t));
+        if (!samples) return -1;
+        timer_setup(&sample_timer, profile_sample, 0);
+    }
+    if (hz == 0) hz = PROFILE_DEFAULT_HZ;
+    if (hz > PROFILE_MAX_HZ) hz = PROFILE_MAX_HZ;
+
+    uint32_t flags = irq_save();
+    timer_del(&sample_timer);
+    head = tail = 0;
+    dropped = 0;
+    rate_hz = hz;
+    period_ns = 1000000000u / hz;
+    timer_add_ns(&sample_timer, period_ns);
+    irq_restore(flags);
+    return 0;
+}
+
+void profile_stop(void) {
+    uint32_t flags = irq_save();
+    if (samples) timer_del(&sample_timer);
+    rate_hz = 0;
+    irq_restore(flags);
+}
+
+int profile_read(profile_sample_t *out, int max, profile_info_t *info) {
+    extern unsigned int orbit_module_address;
+    int count = 0;
+
+    uint32_t flags = irq_save();
+    if (out) {
+        while (count < max && tail != head) {
+            out[count++] = samples[tail & SAMPLE_MASK];
+            tail++;
+        }
+    }
+    if (info) {
+        process_t *sysman = process_get_by_pid(1);     // PID 1 is always sysman
+
+        info->hz = rate_hz;
+        info->pending = head - tail;
+        info->dropped = dropped;
+        info->sysman_base = sysman ? sysman->entry_point : 0;
+        info->orbit_base = orbit_module_address;
+    }
+    irq_restore(flags);
+    return count;
+}
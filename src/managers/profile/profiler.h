@@ -0,0 +1,46 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <stdint.h>
+
+/**
+ * Sampling profiler
+ * While running, a periodic kernel timer records where each of its
+ * interrupts landed (EIP and ring) into a sample ring. User code starts,
+ * stops and drains it with SYSCALL_PROFILE_*; tools/profile_report.py
+ * turns the samples into a flat profile against the kernel, sysman and
+ * orbit symbol tables.
+ */
+
+#define PROFILE_DEFAULT_HZ      1000
+#define PROFILE_MAX_HZ          10000
+#define PROFILE_MAX_SAMPLES     4096    // Power of two; oldest kept, newest dropped when full
+
+typedef struct {
+    uint32_t eip;
+    uint16_t ring;                      // CS & 3 of the interrupted code
+    int16_t pid;                        // Running process (-1 = kernel before the first)
+} profile_sample_t;
+
+typedef struct {
+    uint32_t hz;                        // 0 = stopped
+    uint32_t pending;                   // Samples waiting to be read
+    uint32_t dropped;                   // Lost because the ring was full
+    uint32_t sysman_base;               // sysman runs in place, linked at 0
+    uint32_t orbit_base;
+} profile_info_t;
+
+/**
+ * Start sampling at hz (0 = PROFILE_DEFAULT_HZ), discarding old samples
+ * Returns 0, or -1 if the sample ring cannot be allocated
+ */
+int profile_start(uint32_t hz);
+void profile_stop(void);
+
+/**
+ * Move up to max samples into out, oldest first; info may be 0
+ * Returns the number of samples copied
+ */
+int profile_read(profile_sample_t *out, int max, profile_info_t *info);
+
+#endif // PROFILER_H
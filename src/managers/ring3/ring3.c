@@ -1,31 +1,10 @@
-/* Serial debug */
-static inline unsigned char inb(unsigned short port) {
-    unsigned char ret;
-    asm volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
-    return ret;
-}
-
-static inline void outb(unsigned short port, unsigned char val) {
-    asm volatile("outb %0, %1" : : "a"(val), "Nd"(port));
-}
-
-static void serial_putc(char c) {
-    while (!(inb(0x3F8 + 5) & 0x20));
-    outb(0x3F8, c);
-}
-
-static void serial_print(const char *str) {
-    while (*str) {
-        if (*str == '\n') serial_putc('\r');
-        serial_putc(*str++);
-    }
-}
+#include "../log/klog.h"
 
 /* Switch to Ring 3 with specified entry point and stack - NEVER RETURNS */
 void ring3_switch_with_stack(unsigned int entry_point, unsigned int stack_top) __attribute__((noreturn));
 
 void ring3_switch_with_stack(unsigned int entry_point, unsigned int stack_top) {
-    serial_print("\n[RING3_SWITCH] Switching to Ring 3 now!\n");
+    klog(KLOG_DEBUG, "RING3_SWITCH", "Switching to Ring 3 now!");
     
     __asm__ __volatile__(
         /* Keep DS/ES/FS/GS as kernel segments (0x10) during transition */
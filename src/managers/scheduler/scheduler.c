@@ -4,6 +4,10 @@
  */
 
 #include "scheduler.h"
+#include "../timer/timer.h"
+#include "../trace/trace.h"
+#include "../process/process_manager.h"
+#include "../cpu/cpu.h"
 
 /* External VBE functions */
 extern void vbe_print(const char *str, uint32_t fg, uint32_t bg);
@@ -19,6 +23,10 @@ static int current_pid = -1;
 /* Flag to enable/disable scheduling */
 static int scheduling_enabled = 0;
 
+/* Time slice - an ordinary timer that only runs while something is waiting */
+static ktimer_t slice_timer;
+static volatile int need_resched = 0;
+
 /* Process queue for starting new processes */
 #define MAX_QUEUED_PROCESSES 16
 typedef struct {
@@ -36,9 +44,16 @@ static int queue_count = 0;
 /**
  * Initialize the scheduler
  */
+static void slice_expired(ktimer_t *timer) {
+    (void)timer;
+    need_resched = 1;
+}
+
 void scheduler_init(void) {
     current_pid = -1;
     scheduling_enabled = 0;
+    need_resched = 0;
+    timer_setup(&slice_timer, slice_expired, 0);
     vbe_print("[SCHEDULER] Initialized\n", 0xFF00FF00, 0xFF001020);
 }
 
@@ -49,14 +64,21 @@ int scheduler_get_current_pid(void) {
     return current_pid;
 }
 
+void scheduler_set_current_pid(int pid) {
+    TRACE_CONTEXT_SWITCH(current_pid, pid, 0);
+    current_pid = pid;
+}
+
 /**
- * Called by timer interrupt - switches between processes
- * Starts queued processes on first tick after they're added
+ * Start the next queued process if the slice has expired
+ * Abandons the caller's kernel stack - see scheduler_tick
  */
-void scheduler_tick(void) {
-    if (!scheduling_enabled) {
+static void scheduler_switch(void) {
+    if (!scheduling_enabled || !need_resched || kernel_fpu_active()) {
         return;
     }
+    uint32_t flags = irq_save();
+    need_resched = 0;
     
     /* Check if there's a queued process to start */
     if (queue_count > 0) {
@@ -70,8 +92,15 @@ void scheduler_tick(void) {
         queue_head = (queue_head + 1) % MAX_QUEUED_PROCESSES;
         queue_count--;
         
+        TRACE_CONTEXT_SWITCH(current_pid, proc->pid, proc->entry_point);
+        process_account_switch(proc->pid);
         current_pid = proc->pid;
         
+        /* Only slice the new process if someone else is waiting */
+        if (queue_count > 0) {
+            timer_add_ns(&slice_timer, SCHED_SLICE_NS);
+        }
+        
         /* Jump to the new process in Ring 3 - DOES NOT RETURN */
         extern void ring3_switch_with_stack(uint32_t entry_point, uint32_t stack_top);
         ring3_switch_with_stack(proc->entry_point, proc->user_stack);
@@ -79,6 +108,30 @@ void scheduler_tick(void) {
     
     /* If no queued processes, continue running current process */
     /* TODO: Implement context switching between running processes */
+    irq_restore(flags);
+}
+
+/**
+ * Called at the end of every interrupt
+ * Kernel code interrupted in the middle of a syscall may hold a sprite
+ * or FPU section open, or a lock-free queue half updated; switching away
+ * would strand it, so need_resched stays set until ring 3 or a
+ * preemption point.
+ */
+void scheduler_tick(int from_user) {
+    if (from_user) scheduler_switch();
+}
+
+void scheduler_preempt_point(void) {
+    scheduler_switch();
+}
+
+/**
+ * Give up the rest of the slice (SYSCALL_YIELD)
+ */
+void scheduler_yield(void) {
+    need_resched = 1;
+    scheduler_switch();
 }
 
 /**
@@ -86,6 +139,9 @@ void scheduler_tick(void) {
  */
 void scheduler_enable() {
     scheduling_enabled = 1;
+    if (queue_count > 0 && !timer_pending(&slice_timer)) {
+        timer_add_ns(&slice_timer, SCHED_SLICE_NS);
+    }
     vbe_print("[SCHEDULER] Enabled\n", 0xFF00FF00, 0xFF001020);
 }
 
@@ -99,7 +155,7 @@ void scheduler_disable() {
 
 /**
  * Add a new process to the ready queue
- * It will be started on the next scheduler tick
+ * It will be started when the current slice expires
  */
 void scheduler_add_process(int pid, uint32_t entry_point, uint32_t user_stack, uint32_t kernel_stack) {
     if (queue_count >= MAX_QUEUED_PROCESSES) {
@@ -113,4 +169,8 @@ void scheduler_add_process(int pid, uint32_t entry_point, uint32_t user_stack, u
     
     queue_tail = (queue_tail + 1) % MAX_QUEUED_PROCESSES;
     queue_count++;
+    
+    if (scheduling_enabled && !timer_pending(&slice_timer)) {
+        timer_add_ns(&slice_timer, SCHED_SLICE_NS);
+    }
 }
@@ -3,15 +3,33 @@
 
 #include <stdint.h>
 
+/* Time slice a process runs before a waiting one is started */
+#define SCHED_SLICE_NS  10000000ULL     // 10ms
+
 /**
  * Initialize the scheduler
  */
 void scheduler_init(void);
 
 /**
- * Called by timer interrupt - switches between processes
+ * Called at the end of every interrupt - switches between processes
+ * when the slice timer has expired. A switch never returns, so it only
+ * happens when the interrupt came from ring 3 (from_user); a kernel path
+ * that was interrupted keeps the CPU and the switch waits for the next
+ * preemption point.
+ */
+void scheduler_tick(int from_user);
+
+/**
+ * Switch now if the slice has expired - for kernel paths that hold no
+ * state another process could need (the end of a syscall)
+ */
+void scheduler_preempt_point(void);
+
+/**
+ * End the current slice now (SYSCALL_YIELD)
  */
-void scheduler_tick(void);
+void scheduler_yield(void);
 
 /**
  * Enable/disable scheduler
@@ -24,9 +42,15 @@ void scheduler_disable(void);
  */
 int scheduler_get_current_pid(void);
 
+/**
+ * The first process (sysman) is started by the process manager, not
+ * from the queue - record it as running
+ */
+void scheduler_set_current_pid(int pid);
+
 /**
  * Add a new process to the ready queue
- * Process will be started on next scheduler tick
+ * Process will be started when the current slice expires
  */
 void scheduler_add_process(int pid, uint32_t entry_point, uint32_t user_stack, uint32_t kernel_stack);
 
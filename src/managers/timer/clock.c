@@ -0,0 +1,92 @@
+/**
+ * MaahiOS Monotonic Clock
+ * Calibrates the TSC against PIT channel 2 once at boot and publishes
+ * the scale in a page Ring 3 can read but not write.
+ */
+
+#include "clock.h"
+#include "../cpu/cpu.h"
+#include "../memory/paging.h"
+
+extern unsigned int pit_get_ticks(void);
+extern void *kmalloc_aligned(uint32_t size, uint32_t alignment);
+extern uint32_t *kernel_page_directory;
+
+/* Below this the scale overflows 32 bits (and the TSC is useless anyway) */
+#define CLOCK_MIN_TSC_KHZ   4000
+
+static clock_page_t *page = 0;
+static clock_page_t fallback_page;      // Used until clock_init (or if allocation fails)
+
+/**
+ * Publish a new scale; readers see either the old or the new one
+ * Only clock_init may call this - the shared page is read-only after it
+ */
+static void clock_publish(uint32_t mult, uint32_t khz, uint64_t tsc_base, uint64_t ns_base) {
+    page->seq++;
+    __asm__ volatile("" ::: "memory");
+    page->mult = mult;
+    page->tsc_khz = khz;
+    page->tsc_base = tsc_base;
+    page->ns_base = ns_base;
+    __asm__ volatile("" ::: "memory");
+    page->seq++;
+}
+
+void clock_init(void) {
+    page = &fallback_page;
+
+    // Filled in while still writable: paging runs with CR0.WP set, so
+    // once the page is mapped read-only Ring 0 cannot write it either
+    clock_page_t *shared = (clock_page_t *)kmalloc_aligned(4096, 4096);
+    if (shared) {
+        shared->seq = 0;
+        shared->mult = 0;
+        page = shared;
+    }
+
+    uint32_t khz = cpu_calibrate_tsc();
+    if (khz < CLOCK_MIN_TSC_KHZ) {
+        // No usable TSC - clock_monotonic_ns uses the PIT tick
+        clock_publish(0, 0, 0, 0);
+    } else {
+        // ns per cycle = 1e6 / kHz, in CLOCK_SHIFT fixed point (64/32 divl -
+        // there is no libgcc for a 64-bit divide)
+        uint64_t scaled = 1000000ULL << CLOCK_SHIFT;
+        uint32_t mult, rem;
+        __asm__("divl %4" : "=a"(mult), "=d"(rem)
+                : "a"((uint32_t)scaled), "d"((uint32_t)(scaled >> 32)), "rm"(khz));
+        clock_publish(mult, khz, cpu_rdtsc(), (uint64_t)pit_get_ticks() * 1000000);
+    }
+
+    // Present + user, no write: the scale is final from here on
+    if (shared) {
+        paging_map_page(kernel_page_directory, (uint32_t)shared, (uint32_t)shared, PAGE_PRESENT | PAGE_USER);
+        __asm__ volatile("invlpg (%0)" : : "r"(shared) : "memory");
+    }
+}
+
+/**
+ * Nanoseconds since boot, monotonic
+ */
+uint64_t clock_monotonic_ns(void) {
+    if (page && page->mult) return clock_page_read_ns(page);
+    return (uint64_t)pit_get_ticks() * 1000000;
+}
+
+/**
+ * Milliseconds since boot, wrapping at 2^32
+ * The 64/32 divl faults if the quotient overflows, so the high word is
+ * reduced first - that only drops whole multiples of 2^32 ms.
+ */
+uint32_t clock_monotonic_ms(void) {
+    uint64_t ns = clock_monotonic_ns();
+    uint32_t ms, rem;
+    __asm__("divl %4" : "=a"(ms), "=d"(rem)
+            : "a"((uint32_t)ns), "d"((uint32_t)(ns >> 32) % 1000000), "rm"(1000000));
+    return ms;
+}
+
+const clock_page_t *clock_get_page(void) {
+    return page;
+}
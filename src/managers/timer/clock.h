@@ -0,0 +1,73 @@
+#ifndef CLOCK_H
+#define CLOCK_H
+
+#include <stdint.h>
+
+/**
+ * Monotonic clock
+ * The TSC is calibrated against the PIT at boot and scaled to
+ * nanoseconds. The scale is published in a page Ring 3 can read but not
+ * write (SYSCALL_CLOCK_PAGE returns its address), so user code gets
+ * nanosecond time without a syscall. Without a TSC the clock falls back
+ * to the 1 kHz PIT tick.
+ */
+
+/* Clock IDs (SYSCALL_CLOCK_GETTIME) */
+#define CLOCK_MONOTONIC         1
+
+/* ns = ns_base + ((tsc - tsc_base) * mult) >> CLOCK_SHIFT */
+#define CLOCK_SHIFT             24
+
+/*
+ * Shared time page - written by the kernel under a sequence count
+ * Readers retry while seq is odd or changed across the read.
+ */
+typedef struct {
+    volatile uint32_t seq;
+    uint32_t mult;              // ns per TSC cycle << CLOCK_SHIFT, 0 = no TSC (use the syscall)
+    uint32_t tsc_khz;
+    uint32_t reserved;
+    uint64_t tsc_base;
+    uint64_t ns_base;
+} clock_page_t;
+
+/**
+ * (delta * mult) >> CLOCK_SHIFT without overflowing for large deltas
+ */
+static inline uint64_t clock_scale(uint64_t delta, uint32_t mult) {
+    uint64_t lo = ((uint64_t)(uint32_t)delta * mult) >> CLOCK_SHIFT;
+    uint64_t hi = ((uint64_t)(uint32_t)(delta >> 32) * mult) << (32 - CLOCK_SHIFT);
+    return lo + hi;
+}
+
+/**
+ * Read nanoseconds from the time page (Ring 0 or Ring 3)
+ * Returns 0 if the page has no TSC scale
+ */
+static inline uint64_t clock_page_read_ns(const clock_page_t *page) {
+    uint32_t seq, mult;
+    uint64_t tsc_base, ns_base, tsc;
+
+    do {
+        seq = page->seq;
+        __asm__ volatile("" ::: "memory");
+        mult = page->mult;
+        tsc_base = page->tsc_base;
+        ns_base = page->ns_base;
+        uint32_t lo, hi;
+        __asm__ volatile("rdtsc" : "=a"(lo), "=d"(hi));
+        tsc = ((uint64_t)hi << 32) | lo;
+        __asm__ volatile("" ::: "memory");
+    } while ((seq & 1) || seq != page->seq);
+
+    if (!mult) return 0;
+    return ns_base + clock_scale(tsc - tsc_base, mult);
+}
+
+/* Kernel side */
+void clock_init(void);
+uint64_t clock_monotonic_ns(void);
+uint32_t clock_monotonic_ms(void);
+const clock_page_t *clock_get_page(void);
+
+#endif // CLOCK_H
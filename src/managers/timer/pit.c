@@ -1,7 +1,6 @@
 #include "pit.h"
-
-/* External scheduler functions */
-extern void scheduler_tick(void);
+#include "clock.h"
+#include "timer.h"
 
 /* PIT frequency: 1.193182 MHz */
 #define PIT_FREQUENCY 1193182
@@ -10,18 +9,25 @@ extern void scheduler_tick(void);
 #define PIT_CHANNEL0 0x40
 #define PIT_COMMAND  0x43
 
+/* One-shot: counts = (ns * PIT_NS_MULT) >> 32, at most 16 bits (~54.9ms) */
+#define PIT_NS_MULT         5124677
+#define PIT_ONESHOT_MAX_NS  54924563
+
 /* Global tick counter */
 static volatile unsigned int pit_ticks = 0;
 
+/* Channel 0 fires every 1/frequency (else it is one-shot or stopped) */
+static int pit_periodic = 0;
+
 /**
- * PIT IRQ handler - Called from interrupt stub
- * Simple version: just ticks and calls scheduler
+ * PIT IRQ handler - Called from irq_dispatch after EOI
+ * The tick only counts in periodic mode; either way the timer wheel runs
  */
-void pit_handler(void) {
-    pit_ticks++;
+void pit_handler(void *ctx) {
+    (void)ctx;
+    if (pit_periodic) pit_ticks++;
     
-    /* Call scheduler - for now just checks if scheduling is needed */
-    scheduler_tick();
+    timer_interrupt();
 }
 
 /**
@@ -37,21 +43,46 @@ void pit_init(unsigned int frequency) {
     /* Send divisor (low byte, then high byte) */
     outb(PIT_CHANNEL0, divisor & 0xFF);
     outb(PIT_CHANNEL0, (divisor >> 8) & 0xFF);
+    
+    pit_periodic = 1;
+}
+
+/**
+ * Fire IRQ0 once after delay_ns (mode 0, interrupt on terminal count)
+ * Longer delays are cut to what 16 bits can count
+ */
+void pit_oneshot(uint32_t delay_ns) {
+    if (delay_ns > PIT_ONESHOT_MAX_NS) delay_ns = PIT_ONESHOT_MAX_NS;
+    uint32_t count = (uint32_t)(((uint64_t)delay_ns * PIT_NS_MULT) >> 32);
+    if (count == 0) count = 1;
+    
+    outb(PIT_COMMAND, 0x30);
+    outb(PIT_CHANNEL0, count & 0xFF);
+    outb(PIT_CHANNEL0, (count >> 8) & 0xFF);
+    pit_periodic = 0;
+}
+
+/**
+ * Stop channel 0 - mode 0 does not count until a count is written
+ */
+void pit_stop(void) {
+    outb(PIT_COMMAND, 0x30);
+    pit_periodic = 0;
 }
 
 /**
- * Get current tick count
+ * Milliseconds since boot
+ * Counted by the tick in periodic mode, read from the TSC clock otherwise
  */
 unsigned int pit_get_ticks() {
+    const clock_page_t *clock = clock_get_page();
+    if (!pit_periodic && clock && clock->mult) return clock_monotonic_ms();
     return pit_ticks;
 }
 
 /**
- * Simple delay function (busy-wait)
+ * Wait for ticks milliseconds (a timer wakes the CPU from hlt)
  */
 void pit_wait(unsigned int ticks) {
-    unsigned int end_tick = pit_ticks + ticks;
-    while (pit_ticks < end_tick) {
-        asm volatile("pause");
-    }
+    timer_sleep_ns((uint64_t)ticks * 1000000);
 }
@@ -1,6 +1,8 @@
 #ifndef PIT_H
 #define PIT_H
 
+#include <stdint.h>
+
 /* Port I/O functions */
 static inline void outb(unsigned short port, unsigned char val) {
     asm volatile("outb %0, %1" : : "a"(val), "Nd"(port));
@@ -19,17 +21,24 @@ static inline unsigned char inb(unsigned short port) {
 void pit_init(unsigned int frequency);
 
 /**
- * PIT IRQ handler (called from interrupt stub)
+ * One-shot IRQ0 after delay_ns (at most ~54.9ms), or stop channel 0
+ * Used by the timer wheel when there is no LAPIC timer
+ */
+void pit_oneshot(uint32_t delay_ns);
+void pit_stop(void);
+
+/**
+ * PIT IRQ handler (registered on IRQ 0, called by irq_dispatch)
  */
-void pit_handler();
+void pit_handler(void *ctx);
 
 /**
- * Get total ticks since boot
+ * Milliseconds since boot
  */
 unsigned int pit_get_ticks();
 
 /**
- * Busy-wait for specified ticks
+ * Sleep for specified milliseconds
  */
 void pit_wait(unsigned int ticks);
 
@@ -0,0 +1,356 @@
+/**
+ * MaahiOS Timer Wheel
+ * Level 0 has one slot per jiffy (2^17 ns) for the next 64 jiffies; each
+ * level above covers 64 times the span of the one below. A timer goes in
+ * the lowest level its distance fits, and when level 0 wraps the next
+ * slot of level 1 is cascaded (re-inserted) down, and so on up. Adding
+ * and removing are O(1); after an idle stretch the wheel jumps over empty
+ * slots using the per-level bitmaps.
+ *
+ * Level-0 slots are coarser than the deadlines they hold, so a slot is
+ * only run up to the current time: timers later in the same jiffy stay
+ * in it, and the hardware is programmed to the exact earliest deadline.
+ */
+
+#include "timer.h"
+#include "clock.h"
+#include "../irq/lapic.h"
+#include "../process/process_manager.h"
+#include "../scheduler/scheduler.h"
+#include "../cpu/cpu.h"
+
+extern void pit_init(unsigned int frequency);
+extern void pit_oneshot(uint32_t delay_ns);
+extern void pit_stop(void);
+extern void irq_enable_timer(void);
+
+#define TIMER_NONE          0xFFFFFFFFFFFFFFFFULL
+#define TIMER_WHEEL_SPAN    (1ULL << (TIMER_LEVEL_BITS * TIMER_LEVELS))
+
+static ktimer_t *wheel[TIMER_LEVELS][TIMER_SLOTS];
+static uint64_t wheel_pending[TIMER_LEVELS];    // Bit per non-empty slot
+static uint64_t wheel_jiffy = 0;                // Current level-0 position
+static uint32_t timer_count = 0;
+
+static int source = TIMER_SOURCE_PIT_PERIODIC;
+static uint64_t programmed = TIMER_NONE;        // Deadline the hardware is set for
+static int in_interrupt = 0;
+static uint32_t max_late_ns = 0;                // Worst event delivered past programmed
+
+static inline int ctz64(uint64_t x) {
+    uint32_t lo = (uint32_t)x;
+    if (lo) return __builtin_ctz(lo);
+    return 32 + __builtin_ctz((uint32_t)(x >> 32));
+}
+
+static inline int slot_index(uint64_t jiffy, int level) {
+    return (int)(jiffy >> (TIMER_LEVEL_BITS * level)) & (TIMER_SLOTS - 1);
+}
+
+static void slot_link(int level, int slot, ktimer_t *timer) {
+    ktimer_t **head = &wheel[level][slot];
+    timer->next = *head;
+    if (*head) (*head)->pprev = &timer->next;
+    *head = timer;
+    timer->pprev = head;
+    timer->bucket = level * TIMER_SLOTS + slot;
+    wheel_pending[level] |= 1ULL << slot;
+}
+
+static void slot_unlink(ktimer_t *timer) {
+    int level = timer->bucket / TIMER_SLOTS;
+    int slot = timer->bucket % TIMER_SLOTS;
+
+    *timer->pprev = timer->next;
+    if (timer->next) timer->next->pprev = timer->pprev;
+    timer->next = 0;
+    timer->pprev = 0;
+    if (!wheel[level][slot]) wheel_pending[level] &= ~(1ULL << slot);
+}
+
+/**
+ * Put a timer in the lowest level whose span covers its distance
+ */
+static void wheel_insert(ktimer_t *timer) {
+    uint64_t expires = timer->expires >> TIMER_JIFFY_SHIFT;
+    int level = 0;
+
+    if (expires < wheel_jiffy) {
+        expires = wheel_jiffy;          // Already due - run with the current slot
+    } else {
+        uint64_t delta = expires - wheel_jiffy;
+        if (delta >= TIMER_WHEEL_SPAN) {
+            // Beyond the wheel - park in the farthest slot, cascading re-sorts it
+            delta = TIMER_WHEEL_SPAN - 1;
+            expires = wheel_jiffy + delta;
+        }
+        while (delta >= (1ULL << (TIMER_LEVEL_BITS * (level + 1)))) level++;
+    }
+    slot_link(level, slot_index(expires, level), timer);
+}
+
+/**
+ * Level 0 wrapped: move the next slot of each level above down
+ */
+static void wheel_cascade(void) {
+    for (int level = 1; level < TIMER_LEVELS; level++) {
+        int slot = slot_index(wheel_jiffy, level);
+        ktimer_t *timer = wheel[level][slot];
+
+        wheel[level][slot] = 0;
+        wheel_pending[level] &= ~(1ULL << slot);
+        while (timer) {
+            ktimer_t *next = timer->next;
+            wheel_insert(timer);
+            timer = next;
+        }
+        if (slot) break;
+    }
+}
+
+/**
+ * First non-empty slot at or after start (wrapping), -1 if none
+ */
+static int wheel_find_slot(int level, int start) {
+    uint64_t bits = wheel_pending[level];
+    if (!bits) return -1;
+    if (start) bits = (bits >> start) | (bits << (TIMER_SLOTS - start));
+    return (start + ctz64(bits)) & (TIMER_SLOTS - 1);
+}
+
+/**
+ * Earliest deadline in the wheel
+ * The first non-empty slot of each level holds that level's earliest
+ * timers; the current slot of levels above 0 has already been cascaded.
+ */
+static uint64_t wheel_next_expiry(void) {
+    uint64_t best = TIMER_NONE;
+
+    if (!timer_count) return best;
+    for (int level = 0; level < TIMER_LEVELS; level++) {
+        int start = slot_index(wheel_jiffy, level) + (level ? 1 : 0);
+        int slot = wheel_find_slot(level, start & (TIMER_SLOTS - 1));
+        if (slot < 0) continue;
+        for (ktimer_t *timer = wheel[level][slot]; timer; timer = timer->next) {
+            if (timer->expires < best) best = timer->expires;
+        }
+    }
+    return best;
+}
+
+/**
+ * Next jiffy with work: a later non-empty level-0 slot in this round,
+ * else the wrap (level 0 still has timers for the next round), else the
+ * first cascade that brings a non-empty slot down. Every slot in between
+ * is empty, so the wheel can jump straight there after an idle stretch.
+ */
+static uint64_t wheel_next_jiffy(void) {
+    int index = slot_index(wheel_jiffy, 0);
+    if (index < TIMER_SLOTS - 1) {
+        uint64_t later = wheel_pending[0] >> (index + 1);
+        if (later) return wheel_jiffy + 1 + ctz64(later);
+    }
+    if (wheel_pending[0]) return (wheel_jiffy | (TIMER_SLOTS - 1)) + 1;
+
+    uint64_t best = TIMER_NONE;
+    for (int level = 1; level < TIMER_LEVELS; level++) {
+        int current = slot_index(wheel_jiffy, level);
+        int slot = wheel_find_slot(level, (current + 1) & (TIMER_SLOTS - 1));
+        if (slot < 0) continue;
+
+        int ahead = (slot - current) & (TIMER_SLOTS - 1);
+        if (!ahead) ahead = TIMER_SLOTS;
+        uint64_t span = 1ULL << (TIMER_LEVEL_BITS * level);
+        uint64_t at = (wheel_jiffy & ~(span - 1)) + ahead * span;
+        if (at < best) best = at;
+    }
+    return best;
+}
+
+/**
+ * Fire everything due by now and bring wheel_jiffy up to date
+ */
+static void wheel_run(uint64_t now) {
+    uint64_t now_jiffy = now >> TIMER_JIFFY_SHIFT;
+
+    while (1) {
+        if (!timer_count) {
+            if (now_jiffy > wheel_jiffy) wheel_jiffy = now_jiffy;
+            return;
+        }
+
+        // Take the slot off the wheel first so callbacks can re-arm freely
+        int index = slot_index(wheel_jiffy, 0);
+        ktimer_t *work = wheel[0][index];
+        wheel[0][index] = 0;
+        wheel_pending[0] &= ~(1ULL << index);
+        if (work) work->pprev = &work;
+
+        while (work) {
+            ktimer_t *timer = work;
+            work = timer->next;
+            if (work) work->pprev = &work;
+            timer->next = 0;
+            timer->pprev = 0;
+
+            if (timer->expires <= now) {
+                timer_count--;
+                if (timer->callback) timer->callback(timer);
+            } else {
+                slot_link(0, index, timer);     // Later in this jiffy
+            }
+        }
+
+        if (wheel_jiffy >= now_jiffy) return;
+
+        uint64_t next = wheel_next_jiffy();
+        wheel_jiffy = next < now_jiffy ? next : now_jiffy;
+        if (slot_index(wheel_jiffy, 0) == 0) wheel_cascade();
+    }
+}
+
+/**
+ * Program the event source for a deadline (TIMER_NONE = nothing pending)
+ * Sources that cannot reach the deadline fire early and are re-armed.
+ */
+static void timer_program(uint64_t deadline) {
+    programmed = deadline;
+    if (source == TIMER_SOURCE_PIT_PERIODIC) return;
+
+    if (deadline == TIMER_NONE) {
+        if (source == TIMER_SOURCE_LAPIC) lapic_timer_stop();
+        return;
+    }
+
+    uint64_t now = clock_monotonic_ns();
+    uint64_t delta = deadline > now ? deadline - now : 0;
+    if (delta < TIMER_MIN_DELTA_NS) delta = TIMER_MIN_DELTA_NS;
+    if (delta > 0xFFFFFFFF) delta = 0xFFFFFFFF;
+
+    if (source == TIMER_SOURCE_LAPIC) {
+        lapic_timer_oneshot((uint32_t)delta);
+    } else {
+        pit_oneshot((uint32_t)delta);
+    }
+}
+
+void timer_init(void) {
+    const clock_page_t *clock = clock_get_page();
+
+    wheel_jiffy = clock_monotonic_ns() >> TIMER_JIFFY_SHIFT;
+
+    if (clock && clock->mult) {
+        // Tickless: the TSC keeps time, the timer only fires on deadlines
+        pit_stop();
+        if (lapic_timer_init()) {
+            source = TIMER_SOURCE_LAPIC;
+        } else {
+            source = TIMER_SOURCE_PIT_ONESHOT;
+            irq_enable_timer();
+        }
+    } else {
+        // No clock between interrupts - the 1 kHz tick is the clock
+        source = TIMER_SOURCE_PIT_PERIODIC;
+        pit_init(1000);
+        irq_enable_timer();
+    }
+}
+
+int timer_get_source(void) {
+    return source;
+}
+
+void timer_setup(ktimer_t *timer, void (*callback)(ktimer_t *timer), void *data) {
+    timer->next = 0;
+    timer->pprev = 0;
+    timer->expires = 0;
+    timer->bucket = 0;
+    timer->callback = callback;
+    timer->data = data;
+}
+
+void timer_add(ktimer_t *timer, uint64_t expires_ns) {
+    uint32_t flags = irq_save();
+
+    if (timer->pprev) {
+        slot_unlink(timer);
+        timer_count--;
+    } else if (!timer_count) {
+        // Nothing has advanced the wheel while it was empty
+        uint64_t now_jiffy = clock_monotonic_ns() >> TIMER_JIFFY_SHIFT;
+        if (now_jiffy > wheel_jiffy) wheel_jiffy = now_jiffy;
+    }
+
+    timer->expires = expires_ns;
+    wheel_insert(timer);
+    timer_count++;
+
+    // timer_interrupt programs once the whole run is done
+    if (!in_interrupt && expires_ns < programmed) timer_program(expires_ns);
+    irq_restore(flags);
+}
+
+void timer_add_ns(ktimer_t *timer, uint64_t delay_ns) {
+    timer_add(timer, clock_monotonic_ns() + delay_ns);
+}
+
+int timer_del(ktimer_t *timer) {
+    uint32_t flags = irq_save();
+    int pending = timer->pprev != 0;
+
+    // The hardware may still fire for it - that just runs an empty wheel
+    if (pending) {
+        slot_unlink(timer);
+        timer_count--;
+    }
+    irq_restore(flags);
+    return pending;
+}
+
+void timer_interrupt(void) {
+    uint64_t now = clock_monotonic_ns();
+
+    // A periodic tick has no deadline; PIT one-shots capped at 55ms fire early
+    if (source != TIMER_SOURCE_PIT_PERIODIC && programmed != TIMER_NONE && now > programmed) {
+        uint64_t late = now - programmed;
+        if (late > max_late_ns) max_late_ns = (late >> 32) ? 0xFFFFFFFF : (uint32_t)late;
+    }
+
+    in_interrupt = 1;
+    programmed = TIMER_NONE;
+    wheel_run(now);
+    in_interrupt = 0;
+    timer_program(wheel_next_expiry());
+}
+
+uint32_t timer_get_max_late_ns(int reset) {
+    uint32_t late = max_late_ns;
+    if (reset) max_late_ns = 0;
+    return late;
+}
+
+/**
+ * The wake timer is not on the stack: the slice timer can switch away
+ * from a process inside the hlt loop, leaving its kernel stack behind
+ * with the timer still queued. Each process has its own; before the
+ * first process there is no scheduling, so one static timer will do.
+ */
+void timer_sleep_ns(uint64_t ns) {
+    static ktimer_t boot_wake;
+    uint64_t deadline = clock_monotonic_ns() + ns;
+    uint32_t flags = irq_save();
+
+    process_t *pcb = process_get_by_pid(scheduler_get_current_pid());
+    ktimer_t *wake = pcb ? &pcb->wake_timer : &boot_wake;
+    timer_del(wake);
+    timer_setup(wake, 0, 0);
+    timer_add(wake, deadline);
+    int mode = process_account_mode(PROCESS_MODE_IDLE);
+    while (clock_monotonic_ns() < deadline) {
+        // sti takes effect after hlt starts, so the wakeup cannot be missed
+        __asm__ volatile("sti; hlt; cli" ::: "memory");
+    }
+    process_account_mode(mode);
+    timer_del(wake);
+    irq_restore(flags);
+}
@@ -0,0 +1,80 @@
+#ifndef TIMER_H
+#define TIMER_H
+
+#include <stdint.h>
+
+/**
+ * Kernel timers
+ * Timers sit in a hierarchical timing wheel keyed on clock_monotonic_ns.
+ * With a TSC clock the hardware is programmed one-shot to the earliest
+ * deadline (LAPIC timer, else PIT channel 0 in mode 0), so nothing
+ * interrupts an idle system. Without a TSC the PIT stays periodic at
+ * 1 kHz and the wheel is run from each tick.
+ *
+ * Callbacks run from the timer interrupt (IF=0, after EOI) and may
+ * re-arm their own timer.
+ */
+
+/* Wheel geometry: 64 slots per level, level 0 slots are 2^17 ns (~131us) */
+#define TIMER_JIFFY_SHIFT       17
+#define TIMER_LEVEL_BITS        6
+#define TIMER_SLOTS             (1 << TIMER_LEVEL_BITS)
+#define TIMER_LEVELS            5           // 2^30 jiffies, ~39 hours
+
+/* Never program the hardware closer than this */
+#define TIMER_MIN_DELTA_NS      2000
+
+/* Event sources (timer_get_source) */
+#define TIMER_SOURCE_PIT_PERIODIC   0
+#define TIMER_SOURCE_PIT_ONESHOT    1
+#define TIMER_SOURCE_LAPIC          2
+
+typedef struct ktimer {
+    struct ktimer *next;
+    struct ktimer **pprev;      // 0 when not pending
+    uint64_t expires;           // clock_monotonic_ns deadline
+    uint32_t bucket;            // level * TIMER_SLOTS + slot while pending
+    void (*callback)(struct ktimer *timer);     // 0 = only wake the CPU
+    void *data;
+} ktimer_t;
+
+/**
+ * Pick the event source and start the wheel (after clock_init)
+ */
+void timer_init(void);
+int timer_get_source(void);
+
+void timer_setup(ktimer_t *timer, void (*callback)(ktimer_t *timer), void *data);
+
+/**
+ * Arm (or re-arm) a timer for an absolute deadline / a delay from now
+ */
+void timer_add(ktimer_t *timer, uint64_t expires_ns);
+void timer_add_ns(ktimer_t *timer, uint64_t delay_ns);
+
+/**
+ * Disarm; returns 1 if the timer was pending
+ */
+int timer_del(ktimer_t *timer);
+
+static inline int timer_pending(const ktimer_t *timer) {
+    return timer->pprev != 0;
+}
+
+/**
+ * Expire due timers and program the next event
+ * Called from the LAPIC timer and PIT handlers after EOI
+ */
+void timer_interrupt(void);
+
+/**
+ * Worst delay from a programmed deadline to its interrupt (IRQ stats)
+ */
+uint32_t timer_get_max_late_ns(int reset);
+
+/**
+ * Sleep for ns (hlt between interrupts; spins if IF=0)
+ */
+void timer_sleep_ns(uint64_t ns);
+
+#endif // TIMER_H
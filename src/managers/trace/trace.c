@@ -0,0 +1,89 @@
+/**
+ * MaahiOS kernel trace ring
+ * A record is written with interrupts off, so an interrupt that traces
+ * cannot tear a record it interrupted. Only the local CPU writes its ring.
+ */
+
+#include "trace.h"
+
+#ifdef KERNEL_TRACE
+
+#include "../cpu/cpu.h"
+#include "../log/klog.h"
+
+#define TRACE_DUMP_LINE     32      // Bytes per hex line
+
+trace_buffer_t trace_buffers[TRACE_CPUS];   // Global so QEMU's pmemsave can find it
+
+static int have_tsc = 0;
+
+void trace_init(void) {
+    have_tsc = cpu_has_tsc();
+
+    for (int cpu = 0; cpu < TRACE_CPUS; cpu++) {
+        trace_buffer_t *buf = &trace_buffers[cpu];
+        for (int i = 0; i < 8; i++) buf->magic[i] = TRACE_MAGIC[i];
+        buf->version = TRACE_VERSION;
+        buf->cpu = cpu;
+        buf->tsc_khz = cpu_tsc_khz();
+        buf->record_size = sizeof(trace_record_t);
+        buf->capacity = TRACE_RECORDS;
+    }
+}
+
+void trace_event(uint32_t event, uint32_t arg0, uint32_t arg1, uint32_t arg2) {
+    trace_buffer_t *buf = &trace_buffers[0];
+
+    uint32_t flags = irq_save();
+    trace_record_t *r = &buf->records[buf->head & (TRACE_RECORDS - 1)];
+    r->tsc = have_tsc ? cpu_rdtsc() : 0;
+    r->event = event;
+    r->arg[0] = arg0;
+    r->arg[1] = arg1;
+    r->arg[2] = arg2;
+    buf->head++;
+    irq_restore(flags);
+}
+
+/**
+ * One line of hex: "<offset> <bytes>"
+ */
+static void dump_line(uint32_t offset, const uint8_t *data, int length) {
+    static const char hex[] = "0123456789abcdef";
+    char text[TRACE_DUMP_LINE * 2 + 1];
+
+    for (int i = 0; i < length; i++) {
+        text[i * 2] = hex[data[i] >> 4];
+        text[i * 2 + 1] = hex[data[i] & 0xF];
+    }
+    text[length * 2] = 0;
+    klog(KLOG_INFO, "TRACE", "%06x %s", offset, text);
+    klog_flush();
+}
+
+/**
+ * The dump is the buffer as it sits in memory - header, then the slots
+ * in use - so the decoder reads it exactly like a pmemsave image
+ */
+void trace_dump(void) {
+    uint32_t flags = irq_save();
+    klog_flush();
+
+    for (int cpu = 0; cpu < TRACE_CPUS; cpu++) {
+        trace_buffer_t *buf = &trace_buffers[cpu];
+        uint32_t used = buf->head < TRACE_RECORDS ? buf->head : TRACE_RECORDS;
+        uint32_t size = (uint32_t)((uint8_t *)&buf->records[used] - (uint8_t *)buf);
+
+        klog(KLOG_INFO, "TRACE", "BEGIN cpu=%u records=%u", cpu, used);
+        for (uint32_t offset = 0; offset < size; offset += TRACE_DUMP_LINE) {
+            uint32_t length = size - offset < TRACE_DUMP_LINE ? size - offset : TRACE_DUMP_LINE;
+            dump_line(offset, (const uint8_t *)buf + offset, length);
+        }
+        klog(KLOG_INFO, "TRACE", "END cpu=%u", cpu);
+    }
+
+    klog_flush();
+    irq_restore(flags);
+}
+
+#endif // KERNEL_TRACE
@@ -0,0 +1,84 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+/**
+ * Binary kernel trace
+ * Fixed-size records (TSC, event id, three arguments) in a per-CPU ring
+ * that overwrites its oldest entries. Built in with -DKERNEL_TRACE
+ * (TRACE=1 ./build.sh); without it every TRACE_* macro compiles to
+ * nothing and the ring does not exist.
+ *
+ * Reading a trace: a kernel panic dumps the ring to serial as hex lines,
+ * or save it from the QEMU monitor with
+ *   pmemsave <address of trace_buffers> <size> trace.bin
+ * and convert either with tools/trace_decode.py into Chrome trace JSON.
+ */
+
+#define TRACE_MAGIC             "MAAHITRC"
+#define TRACE_VERSION           1
+#define TRACE_CPUS              1       // Only the boot CPU runs kernel code
+#define TRACE_RECORDS           2048    // Per CPU, power of two
+
+/* Event ids - tools/trace_decode.py mirrors these */
+#define TRACE_EV_SYSCALL_ENTER  1       // syscall number, arg1, pid
+#define TRACE_EV_SYSCALL_EXIT   2       // syscall number, return value, pid
+#define TRACE_EV_IRQ_ENTER      3       // IRQ (IRQ_STATS_LAPIC_TIMER = LAPIC timer)
+#define TRACE_EV_IRQ_EXIT       4       // IRQ
+#define TRACE_EV_CONTEXT_SWITCH 5       // previous pid, next pid, entry point
+#define TRACE_EV_PAGE_FAULT     6       // CR2, error code, EIP
+
+typedef struct {
+    uint64_t tsc;
+    uint32_t event;
+    uint32_t arg[3];
+} __attribute__((packed)) trace_record_t;
+
+/* Layout shared with the decoder - do not reorder */
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t cpu;
+    uint32_t tsc_khz;
+    uint32_t record_size;
+    uint32_t capacity;
+    volatile uint32_t head;             // Records ever written; slot = n % capacity
+    trace_record_t records[TRACE_RECORDS];
+} __attribute__((packed)) trace_buffer_t;
+
+#ifdef KERNEL_TRACE
+
+/**
+ * Fill in the ring headers - after clock_init so the TSC rate is known
+ */
+void trace_init(void);
+
+void trace_event(uint32_t event, uint32_t arg0, uint32_t arg1, uint32_t arg2);
+
+/**
+ * Write the ring to the kernel log as hex, oldest record first, for
+ * tools/trace_decode.py (busy-waits on the UART - panic path)
+ */
+void trace_dump(void);
+
+#define TRACE_SYSCALL_ENTER(num, arg, pid)  trace_event(TRACE_EV_SYSCALL_ENTER, (num), (arg), (pid))
+#define TRACE_SYSCALL_EXIT(num, ret, pid)   trace_event(TRACE_EV_SYSCALL_EXIT, (num), (ret), (pid))
+#define TRACE_IRQ_ENTER(irq)                trace_event(TRACE_EV_IRQ_ENTER, (irq), 0, 0)
+#define TRACE_IRQ_EXIT(irq)                 trace_event(TRACE_EV_IRQ_EXIT, (irq), 0, 0)
+#define TRACE_CONTEXT_SWITCH(prev, next, entry) \
+    trace_event(TRACE_EV_CONTEXT_SWITCH, (prev), (next), (entry))
+#define TRACE_PAGE_FAULT(addr, error, eip)  trace_event(TRACE_EV_PAGE_FAULT, (addr), (error), (eip))
+
+#else
+
+#define TRACE_SYSCALL_ENTER(num, arg, pid)  ((void)0)
+#define TRACE_SYSCALL_EXIT(num, ret, pid)   ((void)0)
+#define TRACE_IRQ_ENTER(irq)                ((void)0)
+#define TRACE_IRQ_EXIT(irq)                 ((void)0)
+#define TRACE_CONTEXT_SWITCH(prev, next, entry) ((void)0)
+#define TRACE_PAGE_FAULT(addr, error, eip)  ((void)0)
+
+#endif // KERNEL_TRACE
+
+#endif // TRACE_H
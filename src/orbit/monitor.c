@@ -0,0 +1,336 @@
+/**
+ * Orbit system monitor
+ * Orbit is the process that keeps the CPU once it starts (the scheduler
+ * cannot switch back to sysman yet), so the diagnostics live here.
+ * Each refresh keeps the previous snapshot, and rates and CPU shares
+ * are the change between the two.
+ */
+
+#include "monitor.h"
+#include "../syscalls/user_syscalls.h"
+
+#define MONITOR_X               380
+#define MONITOR_Y               60
+#define MONITOR_WIDTH           620
+#define MONITOR_HEIGHT          600
+#define MONITOR_BG              0x000000
+#define MONITOR_ROW             18
+#define MONITOR_PAD             8
+
+#define IRQ_HIST_FIRST          6               // Histogram bars from 2^6 cycles
+#define IRQ_HIST_SHOWN          22              // ... to 2^27
+#define IRQ_HIST_BAR_H          14
+
+#define PROC_VIEW_MAX           16              // Records fetched per refresh (idle + 15)
+
+/* Two snapshots: [latest] and [latest ^ 1] */
+static irq_stats_t irq_snap[2];
+static proc_stats_t proc_snap[2][PROC_VIEW_MAX];
+static int proc_count[2];
+static int latest = 0;
+static uint32_t orbit_addr = 0;
+static uint64_t next_refresh_ns = 0;
+
+// Unsigned integer to decimal
+static void uint_to_str(uint32_t num, char *buf) {
+    char temp[12];
+    int i = 0, j = 0;
+
+    do {
+        temp[i++] = '0' + (num % 10);
+        num /= 10;
+    } while (num > 0);
+
+    while (i > 0) {
+        buf[j++] = temp[--i];
+    }
+    buf[j] = '\0';
+}
+
+// 64 / 32 bit division without libgcc (quotient clamped to 32 bits)
+static uint32_t div64_32(uint64_t n, uint32_t d) {
+    if (d == 0) return 0;
+    uint32_t hi = (uint32_t)(n >> 32);
+    if (hi >= d) return 0xFFFFFFFF;
+    uint32_t q, r;
+    __asm__("divl %4" : "=a"(q), "=d"(r) : "a"((uint32_t)n), "d"(hi), "rm"(d));
+    return q;
+}
+
+static void draw_number(int x, int y, uint32_t value, uint32_t color) {
+    char buf[12];
+    uint_to_str(value, buf);
+    gui_draw_text(x, y, buf, color, 0);
+}
+
+// part / total in tenths of a percent
+static uint32_t share_x10(uint64_t part, uint64_t total) {
+    while (total >> 32) {
+        part >>= 1;
+        total >>= 1;
+    }
+    if (total == 0) return 0;
+    return div64_32(part * 1000, (uint32_t)total);
+}
+
+// Tenths as "12.3"
+static void draw_percent(int x, int y, uint32_t value_x10, uint32_t color) {
+    char buf[16];
+    uint_to_str(value_x10 / 10, buf);
+    int i = 0;
+    while (buf[i]) i++;
+    buf[i++] = '.';
+    buf[i++] = '0' + value_x10 % 10;
+    buf[i] = '\0';
+    gui_draw_text(x, y, buf, color, 0);
+}
+
+static const char *irq_slot_name(int slot) {
+    switch (slot) {
+        case 0: return "PIT";
+        case 1: return "KBD";
+        case 2: return "CASC";
+        case 3: return "COM2";
+        case 4: return "COM1";
+        case 5: return "5";
+        case 6: return "FDC";
+        case 7: return "LPT1";
+        case 8: return "RTC";
+        case 9: return "9";
+        case 10: return "10";
+        case 11: return "11";
+        case 12: return "MOUSE";
+        case 13: return "FPU";
+        case 14: return "ATA1";
+        case 15: return "ATA2";
+        case IRQ_STATS_LAPIC_TIMER: return "LAPIC";
+        default: return "?";
+    }
+}
+
+/**
+ * Interrupt diagnostics: one row per line that fired between the two
+ * snapshots - count, rate, average and worst handler time and a log2
+ * histogram of handler cycles. Returns the y below the view.
+ */
+static int monitor_draw_irqs(int x, int y, const irq_stats_t *now, const irq_stats_t *prev) {
+    uint32_t mhz = now->tsc_khz / 1000;
+    uint32_t elapsed_ms = div64_32(now->timestamp_ns - prev->timestamp_ns, 1000000);
+
+    gui_draw_text(x, y, now->mode == IRQ_MODE_APIC ? "Interrupts (IOAPIC)" : "Interrupts (8259 PIC)",
+                  0xFFFF00, 0);
+    y += MONITOR_ROW;
+    gui_draw_text(x, y, "IRQ     count   rate/s  avg us  max us  handler cycles 2^6..2^27", 0xC0C0C0, 0);
+    y += MONITOR_ROW;
+
+    for (int slot = 0; slot < IRQ_STATS_SLOTS; slot++) {
+        const irq_line_stats_t *line = &now->line[slot];
+        uint32_t delta = line->count - prev->line[slot].count;
+        if (delta == 0) continue;
+
+        gui_draw_text(x, y, irq_slot_name(slot), 0xFFFFFF, 0);
+        draw_number(x + 64, y, line->count, 0xFFFFFF);
+        draw_number(x + 128, y, elapsed_ms ? div64_32((uint64_t)delta * 1000, elapsed_ms) : 0, 0xFFFFFF);
+        if (mhz) {
+            draw_number(x + 192, y, div64_32(line->total_cycles, line->count) / mhz, 0xFFFFFF);
+            draw_number(x + 256, y, line->max_cycles / mhz, 0xFFFFFF);
+        }
+
+        // Bars scaled to the fullest bucket shown
+        uint32_t peak = 1;
+        for (int b = 0; b < IRQ_HIST_SHOWN; b++) {
+            if (line->hist[IRQ_HIST_FIRST + b] > peak) peak = line->hist[IRQ_HIST_FIRST + b];
+        }
+        for (int b = 0; b < IRQ_HIST_SHOWN; b++) {
+            uint32_t n = line->hist[IRQ_HIST_FIRST + b];
+            if (!n) continue;
+            int h = 1 + (int)div64_32((uint64_t)n * (IRQ_HIST_BAR_H - 1), peak);
+            gui_draw_filled_rect(x + 330 + b * 6, y + IRQ_HIST_BAR_H - h, 5, h, 0x00C0FF);
+        }
+
+        y += MONITOR_ROW;
+    }
+
+    y += MONITOR_ROW / 2;
+    gui_draw_text(x, y, "spurious", 0xC0C0C0, 0);
+    draw_number(x + 72, y, now->spurious, 0xFFFFFF);
+    gui_draw_text(x + 128, y, "unhandled", 0xC0C0C0, 0);
+    draw_number(x + 208, y, now->unhandled, 0xFFFFFF);
+    gui_draw_text(x + 256, y, "worst timer lateness us", 0xC0C0C0, 0);
+    draw_number(x + 448, y, now->timer_late_max_ns / 1000, 0xFFFFFF);
+    return y + MONITOR_ROW;
+}
+
+/**
+ * Same numbers for the serial log, once per refresh
+ */
+static void monitor_log_irqs(const irq_stats_t *now, const irq_stats_t *prev) {
+    char buf[12];
+
+    for (int slot = 0; slot < IRQ_STATS_SLOTS; slot++) {
+        const irq_line_stats_t *line = &now->line[slot];
+        if (line->count == prev->line[slot].count) continue;
+
+        syscall_puts("[IRQ] ");
+        syscall_puts(irq_slot_name(slot));
+        syscall_puts(" count=");
+        uint_to_str(line->count, buf);
+        syscall_puts(buf);
+        syscall_puts(" max_cycles=");
+        uint_to_str(line->max_cycles, buf);
+        syscall_puts(buf);
+        syscall_puts("\n");
+    }
+}
+
+static const char *proc_name(const proc_stats_t *proc) {
+    if (proc->pid == 0) return "idle";
+    if (proc->pid == 1) return "sysman";
+    if (proc->entry_point == orbit_addr) return "orbit";
+    return "process";
+}
+
+/**
+ * Cycles each process used between the two snapshots; returns the sum
+ */
+static uint64_t proc_deltas(uint64_t *user, uint64_t *kernel) {
+    const proc_stats_t *now = proc_snap[latest], *prev = proc_snap[latest ^ 1];
+    uint64_t total = 0;
+
+    for (int i = 0; i < proc_count[latest]; i++) {
+        user[i] = now[i].user_cycles;
+        kernel[i] = now[i].kernel_cycles;
+        for (int j = 0; j < proc_count[latest ^ 1]; j++) {
+            if (prev[j].pid != now[i].pid) continue;
+            user[i] -= prev[j].user_cycles;
+            kernel[i] -= prev[j].kernel_cycles;
+            break;
+        }
+        total += user[i] + kernel[i];
+    }
+    return total;
+}
+
+static uint32_t proc_cpu_ms(const proc_stats_t *proc) {
+    uint32_t khz = irq_snap[latest].tsc_khz;
+    return khz ? div64_32(proc->user_cycles + proc->kernel_cycles, khz) : 0;
+}
+
+/**
+ * Process table: share of the CPU between the snapshots (user and
+ * kernel), plus running totals. Idle is time spent in hlt or before
+ * the first process.
+ */
+static void monitor_draw_procs(int x, int y) {
+    uint64_t user[PROC_VIEW_MAX], kernel[PROC_VIEW_MAX];
+    uint64_t total = proc_deltas(user, kernel);
+
+    gui_draw_text(x, y, "Processes", 0xFFFF00, 0);
+    y += MONITOR_ROW;
+    gui_draw_text(x, y, "PID  NAME      CPU%   USER%  SYS%   CPU ms   syscalls  faults  switches",
+                  0xC0C0C0, 0);
+    y += MONITOR_ROW;
+
+    for (int i = 0; i < proc_count[latest]; i++) {
+        const proc_stats_t *proc = &proc_snap[latest][i];
+        uint32_t cpu = share_x10(user[i] + kernel[i], total);
+        uint32_t color = cpu >= 500 ? 0xFF8080 : 0xFFFFFF;
+
+        draw_number(x, y, proc->pid, color);
+        gui_draw_text(x + 40, y, proc_name(proc), color, 0);
+        draw_percent(x + 120, y, cpu, color);
+        draw_percent(x + 176, y, share_x10(user[i], total), color);
+        draw_percent(x + 232, y, share_x10(kernel[i], total), color);
+        draw_number(x + 288, y, proc_cpu_ms(proc), color);
+        if (proc->pid) {
+            draw_number(x + 360, y, proc->syscalls, color);
+            draw_number(x + 440, y, proc->page_faults, color);
+            draw_number(x + 504, y, proc->switches, color);
+        }
+        y += MONITOR_ROW;
+    }
+}
+
+static void monitor_log_procs(void) {
+    uint64_t user[PROC_VIEW_MAX], kernel[PROC_VIEW_MAX];
+    uint64_t total = proc_deltas(user, kernel);
+    char buf[12];
+
+    for (int i = 0; i < proc_count[latest]; i++) {
+        const proc_stats_t *proc = &proc_snap[latest][i];
+        syscall_puts("[PROC] pid=");
+        uint_to_str(proc->pid, buf);
+        syscall_puts(buf);
+        syscall_puts(" ");
+        syscall_puts(proc_name(proc));
+        syscall_puts(" cpu_permille=");
+        uint_to_str(share_x10(user[i] + kernel[i], total), buf);
+        syscall_puts(buf);
+        syscall_puts(" cpu_ms=");
+        uint_to_str(proc_cpu_ms(proc), buf);
+        syscall_puts(buf);
+        syscall_puts(" syscalls=");
+        uint_to_str(proc->syscalls, buf);
+        syscall_puts(buf);
+        syscall_puts("\n");
+    }
+}
+
+static void monitor_paint(GUI_Window *win) {
+    int x, y, width, height;
+    gui_window_client_rect(win, &x, &y, &width, &height);
+    gui_draw_filled_rect(x, y, width, height, MONITOR_BG);
+
+    x += MONITOR_PAD;
+    y += MONITOR_PAD;
+    y = monitor_draw_irqs(x, y, &irq_snap[latest], &irq_snap[latest ^ 1]);
+    monitor_draw_procs(x, y + MONITOR_ROW);
+}
+
+static void monitor_snapshot(void) {
+    latest ^= 1;
+    syscall_irq_stats(&irq_snap[latest], 0);
+    proc_count[latest] = syscall_proc_stats(proc_snap[latest], PROC_VIEW_MAX);
+    if (proc_count[latest] < 0) proc_count[latest] = 0;
+}
+
+GUI_Window *monitor_create(void) {
+    GUI_Window *win = gui_create_window(MONITOR_X, MONITOR_Y, MONITOR_WIDTH, MONITOR_HEIGHT,
+                                        "System Monitor", MONITOR_BG);
+    if (!win) return 0;
+    win->paint = monitor_paint;
+    gui_window_set_visible(win, 0);
+
+    orbit_addr = syscall_get_orbit_address();
+    proc_count[latest ^ 1] = 0;
+    monitor_snapshot();
+    return win;
+}
+
+void monitor_toggle(GUI_Window *win) {
+    if (!win) return;
+    if (win->visible) {
+        gui_window_set_visible(win, 0);
+        return;
+    }
+    gui_window_set_visible(win, 1);
+    gui_window_raise(win);
+    next_refresh_ns = 0;            // Fresh numbers straight away
+}
+
+uint32_t monitor_poll(GUI_Window *win) {
+    if (!win || !win->visible) return INPUT_WAIT_FOREVER;
+
+    uint64_t now = user_clock_monotonic_ns();
+    if (now >= next_refresh_ns) {
+        monitor_snapshot();
+        monitor_log_irqs(&irq_snap[latest], &irq_snap[latest ^ 1]);
+        monitor_log_procs();
+        gui_invalidate_window(win);
+        next_refresh_ns = now + (uint64_t)MONITOR_REFRESH_MS * 1000000;
+    }
+
+    uint64_t wait_ns = next_refresh_ns - now;
+    if (wait_ns > (uint64_t)MONITOR_REFRESH_MS * 1000000) wait_ns = (uint64_t)MONITOR_REFRESH_MS * 1000000;
+    return (uint32_t)wait_ns / 1000000 + 1;
+}
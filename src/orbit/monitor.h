@@ -0,0 +1,33 @@
+#ifndef ORBIT_MONITOR_H
+#define ORBIT_MONITOR_H
+
+#include <stdint.h>
+#include "../libgui/libgui.h"
+
+/**
+ * System monitor window
+ * Interrupt statistics and the per-process CPU table, refreshed while
+ * the window is open. The numbers also go to the serial log on every
+ * refresh.
+ */
+
+#define MONITOR_REFRESH_MS      1000
+
+/**
+ * Create the (hidden) window and take the first snapshot
+ */
+GUI_Window *monitor_create(void);
+
+/**
+ * Show the window if hidden, hide it if shown
+ */
+void monitor_toggle(GUI_Window *win);
+
+/**
+ * Take a new snapshot and repaint if the refresh interval has passed
+ * Call after every event batch; returns the ms until the next refresh
+ * (INPUT_WAIT_FOREVER while the window is hidden)
+ */
+uint32_t monitor_poll(GUI_Window *win);
+
+#endif // ORBIT_MONITOR_H
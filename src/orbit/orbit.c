@@ -1,13 +1,30 @@
 #include "../libgui/libgui.h"
 #include "../libgui/cursor_compositor.h"
 #include "../syscalls/user_syscalls.h"
-#include "../../libraries/icons/embedded_icons.h"
+#include "icon_atlas.h"
+#include "../drivers/mouse.h"
+#include "../drivers/keyboard.h"
+#include "monitor.h"
 
 /**
  * Orbit - MaahiOS Desktop Shell
  * Simple button-based interface with mouse support
  */
 
+#define ORBIT_EVENT_BATCH   32      // Input events taken per syscall
+
+/* F12 starts/stops the sampling profiler; samples go to the serial log */
+#define ORBIT_PROFILE_KEY       KEY_F12
+#define ORBIT_PROFILE_PER_LINE  16
+#define ORBIT_PROFILE_LINE_NS   20000000ULL     // ~190 bytes per line at 115200 baud
+
+/* F11 or the "Process Manager" desktop button opens the system monitor */
+#define ORBIT_MONITOR_KEY       KEY_F11
+#define ORBIT_MONITOR_BUTTON_X  20
+#define ORBIT_MONITOR_BUTTON_Y  20
+#define ORBIT_BUTTON_W          150             // gui_button size
+#define ORBIT_BUTTON_H          40
+
 // Helper function to convert integer to string
 static void int_to_str(int num, char *buf) {
     int i = 0, j = 0;
@@ -35,10 +52,101 @@ static void int_to_str(int num, char *buf) {
     buf[j] = '\0';
 }
 
+static char *append_str(char *p, const char *str) {
+    while (*str) *p++ = *str++;
+    return p;
+}
+
+static char *append_hex(char *p, uint32_t value) {
+    const char hex_chars[] = "0123456789abcdef";
+    for (int i = 0; i < 8; i++) *p++ = hex_chars[(value >> (28 - i * 4)) & 0xF];
+    return p;
+}
+
+/**
+ * Drain the profiler into the serial log for tools/profile_report.py:
+ *   [PROF] BEGIN hz=<n> dropped=<n> sysman=<hex> orbit=<hex>
+ *   [PROF] <eip>:<ring> ...
+ *   [PROF] END
+ * Lines are paced so the kernel log ring never overflows.
+ */
+static void orbit_profile_dump(void) {
+    profile_sample_t samples[ORBIT_PROFILE_PER_LINE];
+    profile_info_t info;
+    char line[8 + ORBIT_PROFILE_PER_LINE * 11 + 2];
+    char num[16];
+    char *p = line;
+    
+    syscall_profile_read(0, 0, &info);
+    p = append_str(p, "[PROF] BEGIN hz=");
+    int_to_str(info.hz, num);
+    p = append_str(p, num);
+    p = append_str(p, " dropped=");
+    int_to_str(info.dropped, num);
+    p = append_str(p, num);
+    p = append_str(p, " sysman=");
+    p = append_hex(p, info.sysman_base);
+    p = append_str(p, " orbit=");
+    p = append_hex(p, info.orbit_base);
+    *p++ = '\n';
+    *p = 0;
+    syscall_puts(line);
+    
+    int count;
+    while ((count = syscall_profile_read(samples, ORBIT_PROFILE_PER_LINE, 0)) > 0) {
+        p = append_str(line, "[PROF]");
+        for (int i = 0; i < count; i++) {
+            *p++ = ' ';
+            p = append_hex(p, samples[i].eip);
+            *p++ = ':';
+            *p++ = '0' + (samples[i].ring & 3);
+        }
+        *p++ = '\n';
+        *p = 0;
+        syscall_puts(line);
+        syscall_nanosleep(ORBIT_PROFILE_LINE_NS);
+    }
+    syscall_puts("[PROF] END\n");
+}
+
+/**
+ * Desktop background, buttons and icons (clipped by the compositor)
+ */
+static void orbit_paint_desktop(void) {
+    gui_draw_filled_rect(0, 0, GUI_SCREEN_WIDTH, GUI_SCREEN_HEIGHT, GUI_DESKTOP_COLOR);
+    
+    gui_button("Process Manager", ORBIT_MONITOR_BUTTON_X, ORBIT_MONITOR_BUTTON_Y);
+    gui_button("Disk Manager", 20, 90);
+    gui_button("File Explorer", 20, 160);
+    gui_button("Notebook", 20, 230);
+    
+    gui_draw_text(300, 40, "MaahiOS Desktop - Move your mouse!", 0xFFFF00, 0);
+    
+    // File icon from the preconverted atlas
+    gui_draw_sprite(ICON_SPRITE_FILE, 200, 165);
+}
+
+/**
+ * About window client area
+ */
+static void orbit_paint_about(GUI_Window *win) {
+    int x, y, width, height;
+    gui_window_client_rect(win, &x, &y, &width, &height);
+    gui_draw_text_styled(x + 12, y + 12, "MaahiOS v0.1", 0xFF000000, 0, GUI_TEXT_UI);
+    gui_draw_text_styled(x + 12, y + 36, "A small i686 hobby OS", 0xFF202020, 0, GUI_TEXT_UI);
+}
+
 void orbit_main_c(void) {
-    // Initialize cursor compositor
+    // Hand the cursor sprite to the kernel compositor
     orbit_cursor_init();
     
+    // Default pointer curve at 200 Hz; report what the mouse turned out to be
+    int mouse_info = syscall_mouse_config(MOUSE_ACCEL_DEFAULT_SENSITIVITY, MOUSE_ACCEL_DEFAULT_THRESHOLD,
+                                          MOUSE_ACCEL_DEFAULT_FACTOR, MOUSE_SAMPLE_RATE);
+    if (mouse_info >= 0 && (mouse_info >> 16) >= 3) {
+        syscall_puts("[ORBIT] Wheel mouse detected\n");
+    }
+    
     // Simplest possible test
     syscall_puts("[ORBIT_ENTRY] orbit_main_c started!\n");
     
@@ -75,57 +183,95 @@ void orbit_main_c(void) {
     }
     syscall_puts("\n");
     
-    // Clear screen to dark blue background
-    gui_clear_screen(0x001020);
+    // The desktop and windows are retained; the compositor repaints damage
+    gui_set_desktop_paint(orbit_paint_desktop);
     
-    // Draw buttons
-    gui_button("Process Manager", 20, 20);
-    gui_button("Disk Manager", 20, 90);
-    gui_button("File Explorer", 20, 160);
-    gui_button("Notebook", 20, 230);
-    
-    gui_draw_text(300, 40, "MaahiOS Desktop - Move your mouse!", 0xFFFF00, 0);
-    
-    // Test: Draw file icon - check if icon data is valid
-    // Read first two bytes to verify BMP signature
-    uint8_t byte0 = icon_file_bmp[0];
-    uint8_t byte1 = icon_file_bmp[1];
-    
-    if (byte0 == 0x42 && byte1 == 0x4D) {
-        syscall_puts("Icon signature OK in Ring3!\n");
-    } else {
-        syscall_puts("Icon signature INVALID in Ring3!\n");
+    GUI_Window *about = gui_create_window(600, 300, 320, 160, "About MaahiOS", GUI_COLOR_GRAY);
+    if (about) {
+        about->paint = orbit_paint_about;
+        GUI_Button *ok = gui_create_button(about->x + 120, about->y + 115, 80, 30, "OK");
+        gui_window_add_button(about, ok);
     }
     
-    syscall_draw_bmp(200, 165, (unsigned int)icon_file_bmp);
-    syscall_puts("Icon syscall complete\n");
+    GUI_Window *monitor = monitor_create();
     
-    // Main event loop - clean and silent
-    static int last_irq_count = 0;
-    static int polls_since_irq = 0;
+    gui_invalidate(0, 0, GUI_SCREEN_WIDTH, GUI_SCREEN_HEIGHT);
+    gui_compose();
+    
+    // Main event loop - sleeps in the kernel until input arrives, then
+    // handles the whole batch and repaints the damage once
+    // The kernel redraws the cursor from IRQ12 and polls the 8042 itself
+    // when the IRQ stalls
+    input_event_t events[ORBIT_EVENT_BATCH];
+    GUI_Window *dragging = 0;
+    int drag_dx = 0, drag_dy = 0;
+    int profiling = 0;
+    uint32_t wait_ms = INPUT_WAIT_FOREVER;     // Shorter while the monitor refreshes
     
     while(1) {
-        // Small delay for responsive polling
-        for (volatile int i = 0; i < 1000; i++);
-        
-        // Get current mouse position
-        int x = syscall_mouse_get_x();
-        int y = syscall_mouse_get_y();
-        int irq = syscall_mouse_get_irq_total();
+        int count = syscall_get_events(events, ORBIT_EVENT_BATCH, wait_ms);
         
-        // WORKAROUND: If IRQ12 stopped firing, manually poll 8042
-        // QEMU bug: IRQ12 stops firing randomly even though 8042 has data
-        if (irq == last_irq_count) {
-            polls_since_irq++;
-            if (polls_since_irq > 2) {
-                syscall_poll_mouse();
+        for (int i = 0; i < count; i++) {
+            input_event_t *ev = &events[i];
+            
+            switch (ev->type) {
+                case INPUT_EVENT_BUTTON_DOWN:
+                    if (ev->code == MOUSE_LEFT_BUTTON) {
+                        GUI_Window *win = gui_window_at(ev->x, ev->y);
+                        if (!win && ev->x >= ORBIT_MONITOR_BUTTON_X && ev->x < ORBIT_MONITOR_BUTTON_X + ORBIT_BUTTON_W &&
+                            ev->y >= ORBIT_MONITOR_BUTTON_Y && ev->y < ORBIT_MONITOR_BUTTON_Y + ORBIT_BUTTON_H) {
+                            monitor_toggle(monitor);
+                            break;
+                        }
+                        gui_window_raise(win);
+                        if (gui_window_hit_title(win, ev->x, ev->y)) {
+                            dragging = win;
+                            drag_dx = ev->x - win->x;
+                            drag_dy = ev->y - win->y;
+                        }
+                    }
+                    break;
+                    
+                case INPUT_EVENT_MOTION:
+                    if (dragging) {
+                        gui_window_move(dragging, ev->x - drag_dx, ev->y - drag_dy);
+                    }
+                    break;
+                    
+                case INPUT_EVENT_BUTTON_UP:
+                    if (ev->code == MOUSE_LEFT_BUTTON) dragging = 0;
+                    break;
+                    
+                case INPUT_EVENT_KEY_DOWN:
+                    // Escape closes the front-most visible window
+                    if (ev->code == KEY_ESC) {
+                        GUI_Window *front = gui_window_top();
+                        while (front && !front->visible) front = front->below;
+                        if (front) {
+                            if (dragging == front) dragging = 0;
+                            gui_window_set_visible(front, 0);
+                        }
+                    }
+                    if (ev->code == ORBIT_MONITOR_KEY) {
+                        if (dragging == monitor) dragging = 0;
+                        monitor_toggle(monitor);
+                    }
+                    if (ev->code == ORBIT_PROFILE_KEY) {
+                        if (!profiling) {
+                            profiling = syscall_profile_start(PROFILE_DEFAULT_HZ) == 0;
+                            syscall_puts(profiling ? "[ORBIT] Profiling started\n"
+                                                   : "[ORBIT] Profiler unavailable\n");
+                        } else {
+                            syscall_profile_stop();
+                            profiling = 0;
+                            orbit_profile_dump();
+                        }
+                    }
+                    break;
             }
-        } else {
-            polls_since_irq = 0;
-            last_irq_count = irq;
         }
         
-        // Update cursor position (with built-in change detection)
-        orbit_draw_cursor(x, y);
+        wait_ms = monitor_poll(monitor);
+        gui_compose();
     }
 }
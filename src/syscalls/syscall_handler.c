@@ -1,6 +1,16 @@
 #include <stdint.h>
 #include "syscall_numbers.h"
 #include "../managers/scheduler/scheduler.h"
+#include "../drivers/input.h"
+#include "../drivers/mouse.h"
+#include "../managers/timer/clock.h"
+#include "../managers/timer/timer.h"
+#include "../managers/irq/irq_manager.h"
+#include "../managers/log/klog.h"
+#include "../managers/trace/trace.h"
+#include "../managers/profile/profiler.h"
+#include "../managers/process/process_manager.h"
+#include "../managers/pmc/pmc.h"
 
 /**
  * Ring 0 Syscall Handler/Dispatcher
@@ -22,32 +32,13 @@
 uint32_t current_fg_color = 0xFFFFFFFF;  // White by default
 uint32_t current_bg_color = 0x00000000;  // Black by default
 
-/* Serial debug functions */
+/* Port I/O */
 static inline unsigned char inb(unsigned short port) {
     unsigned char ret;
     __asm__ volatile("inb %1, %0" : "=a"(ret) : "Nd"(port));
     return ret;
 }
 
-static inline void outb(unsigned short port, unsigned char val) {
-    __asm__ volatile("outb %0, %1" : : "a"(val), "Nd"(port));
-}
-
-static void serial_print(const char *str) {
-    while (*str) {
-        while ((inb(0x3FD) & 0x20) == 0);
-        outb(0x3F8, *str++);
-    }
-}
-
-static void serial_hex(unsigned char value) {
-    char hex[] = "0123456789ABCDEF";
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[(value >> 4) & 0xF]);
-    while ((inb(0x3FD) & 0x20) == 0);
-    outb(0x3F8, hex[value & 0xF]);
-}
-
 /* Forward declare process function */
 extern int current_process_id(void);
 
@@ -98,6 +89,26 @@ static void kernel_putchar(char c) {
     vga_putchar(c);
 }
 
+/**
+ * User text for the serial log, held until a newline so a line built
+ * from several puts calls stays one log line
+ */
+#define USER_LOG_LINE 200
+static char user_log_line[USER_LOG_LINE];
+static int user_log_length = 0;
+
+static void user_log(const char *str) {
+    if (!str) return;
+    for (; *str; str++) {
+        if (*str != '\n') user_log_line[user_log_length++] = *str;
+        if (*str == '\n' || user_log_length == USER_LOG_LINE - 1) {
+            user_log_line[user_log_length] = 0;
+            klog(KLOG_INFO, "USER", "%s", user_log_line);
+            user_log_length = 0;
+        }
+    }
+}
+
 /**
  * Kernel-side: puts implementation
  * Can directly access VGA buffer (Ring 0 privilege)
@@ -193,6 +204,9 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
     (void)arg3;
     (void)arg4_esi;
     
+    TRACE_SYSCALL_ENTER(syscall_num, arg1, scheduler_get_current_pid());
+    process_account_syscall();
+    
     // CRITICAL: Re-enable interrupts during syscall handling
     // INT 0x80 clears IF, but we need timer/mouse IRQs to work
     __asm__ volatile("sti");
@@ -208,12 +222,8 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
             
         case SYSCALL_PUTS:
             // arg1 = pointer to string
-            serial_print("[SYSCALL_PUTS] str=");
-            if (arg1 != 0) {
-                serial_print((const char*)arg1);
-            } else {
-                serial_print("(null)\n");
-            }
+            // Queued for the serial log, not written out here
+            user_log((const char*)arg1);
             kernel_puts((const char*)arg1);
             break;
             
@@ -390,9 +400,10 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
                 int y = (int)arg2;
                 const char *str = (const char *)arg3;
                 
-                // FORCE WHITE COLOR
-                uint32_t fg = 0xFFFFFF;  // Pure white
-                uint32_t bg = 0x000000;
+                // bg alpha 0 = transparent background
+                uint32_t *stack_ptr = (uint32_t *)user_esp;
+                uint32_t fg = stack_ptr[0];
+                uint32_t bg = stack_ptr[1];
                 
                 bga_print_at(x, y, str, fg, bg);
             }
@@ -413,19 +424,13 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
         case SYSCALL_MOUSE_GET_X:
             // Return current mouse X position
             return_value = (unsigned int)mouse_get_x();
-            serial_print("[SYSCALL_X=");
-            serial_hex((return_value >> 8) & 0xFF);
-            serial_hex(return_value & 0xFF);
-            serial_print("]\n");
+            klog(KLOG_DEBUG, "SYSCALL", "X=%04x", return_value);
             break;
             
         case SYSCALL_MOUSE_GET_Y:
             // Return current mouse Y position
             return_value = (unsigned int)mouse_get_y();
-            serial_print("[SYSCALL_Y=");
-            serial_hex((return_value >> 8) & 0xFF);
-            serial_hex(return_value & 0xFF);
-            serial_print("]\n");
+            klog(KLOG_DEBUG, "SYSCALL", "Y=%04x", return_value);
             break;
             
         case SYSCALL_MOUSE_GET_BUTTONS:
@@ -434,8 +439,8 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
             break;
             
         case SYSCALL_YIELD:
-            // Yield CPU - trigger scheduler
-            scheduler_tick();  // Trigger context switch
+            // Yield CPU - end the slice now
+            scheduler_yield();
             break;
             
         case SYSCALL_MOUSE_GET_IRQ_TOTAL:
@@ -461,28 +466,18 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
         case SYSCALL_POLL_MOUSE: {
             // Manually check 8042 for mouse data and process if available
             // This is a workaround for when IRQ12 stops firing
-            extern void mouse_handler(void);
             uint8_t status = inb(0x64);
             uint8_t slave_pic = inb(0xA1);  // Check slave PIC mask
             
             // DEBUG: Log if IRQ12 is masked on slave PIC
             static int poll_count = 0;
             if (++poll_count % 100 == 0) {  // Log every 100 polls
-                serial_print("[POLL] status=");
-                serial_hex(status);
-                serial_print(" slave_pic=");
-                serial_hex(slave_pic);
-                serial_print(" IRQ12_masked=");
-                serial_hex((slave_pic & 0x10) ? 1 : 0);
-                serial_print("\n");
+                klog(KLOG_DEBUG, "POLL", "status=%02x slave_pic=%02x IRQ12_masked=%d",
+                     status, slave_pic, (slave_pic & 0x10) ? 1 : 0);
             }
             
-            if ((status & 0x01) && (status & 0x20)) {  // Data available AND it's from mouse (bit 5 set)
-                mouse_handler();  // Call handler directly
-                return_value = 1;  // Indicate we found data
-            } else {
-                return_value = 0;  // No data available
-            }
+            extern int mouse_poll(void);
+            return_value = mouse_poll();  // 1 if mouse data was processed
             break;
         }
         
@@ -493,6 +488,181 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
             return_value = bga_get_pixel((int)arg1, (int)arg2);
             break;
             
+        case SYSCALL_SET_CURSOR_IMAGE:
+            // arg1 = ARGB pixels, arg2 = packed(w/h), arg3 = packed(hot_x/hot_y)
+            {
+                extern int bga_cursor_set_image(const uint32_t *argb, int width, int height, int hot_x, int hot_y);
+                int width = (int)(arg2 & 0xFFFF);
+                int height = (int)(arg2 >> 16);
+                int hot_x = (int)(arg3 & 0xFFFF);
+                int hot_y = (int)(arg3 >> 16);
+                return_value = bga_cursor_set_image((const uint32_t *)arg1, width, height, hot_x, hot_y);
+            }
+            break;
+            
+        case SYSCALL_GFX_PRESENT:
+            // No args - copy the dirty areas from the RAM shadow, or flip
+            // the back page to the front (bga_present)
+            {
+                extern void bga_present(void);
+                bga_present();
+            }
+            break;
+            
+        case SYSCALL_GFX_CLIP_PUSH:
+            // arg1 = x, arg2 = y, arg3 = packed(w/h)
+            {
+                extern int bga_clip_push(int x, int y, int width, int height);
+                int width = (int)(arg3 & 0xFFFF);
+                int height = (int)(arg3 >> 16);
+                return_value = bga_clip_push((int)arg1, (int)arg2, width, height);
+            }
+            break;
+            
+        case SYSCALL_GFX_CLIP_POP:
+            // No args
+            {
+                extern int bga_clip_pop(void);
+                return_value = bga_clip_pop();
+            }
+            break;
+            
+        case SYSCALL_GFX_HLINE:
+            // arg1 = x, arg2 = y, arg3 = length, arg4_esi = color
+            {
+                extern void bga_draw_hline(int x, int y, int length, uint32_t color);
+                bga_draw_hline((int)arg1, (int)arg2, (int)arg3, arg4_esi);
+            }
+            break;
+            
+        case SYSCALL_GFX_VLINE:
+            // arg1 = x, arg2 = y, arg3 = length, arg4_esi = color
+            {
+                extern void bga_draw_vline(int x, int y, int length, uint32_t color);
+                bga_draw_vline((int)arg1, (int)arg2, (int)arg3, arg4_esi);
+            }
+            break;
+            
+        case SYSCALL_GFX_DRAW_TEXT:
+            // arg1 = x, arg2 = y, arg3 = str, arg4_esi = &{fg, bg, style}
+            {
+                extern int bga_draw_text(int x, int y, const char *str, uint32_t fg, uint32_t bg, int style);
+                const uint32_t *params = (const uint32_t *)arg4_esi;
+                if (params && arg3) {
+                    return_value = bga_draw_text((int)arg1, (int)arg2, (const char *)arg3,
+                                                 params[0], params[1], (int)params[2]);
+                } else {
+                    return_value = -1;
+                }
+            }
+            break;
+            
+        case SYSCALL_GFX_BLIT_PREMUL:
+            // arg1 = src, arg2 = packed(x/y, signed), arg3 = packed(w/h), arg4_esi = stride
+            {
+                extern void bga_blend_blit_premul(int x, int y, int width, int height, const uint32_t *src, int src_stride);
+                int x = (int16_t)(arg2 & 0xFFFF);
+                int y = (int16_t)(arg2 >> 16);
+                int width = (int)(arg3 & 0xFFFF);
+                int height = (int)(arg3 >> 16);
+                bga_blend_blit_premul(x, y, width, height, (const uint32_t *)arg1, (int)arg4_esi);
+            }
+            break;
+            
+        case SYSCALL_GET_EVENTS:
+            // arg1 = input_event_t buffer, arg2 = max events, arg3 = timeout in ms
+            // Blocks (hlt) until at least one event arrives or the timeout passes
+            {
+                return_value = input_wait_events((input_event_t *)arg1, (int)arg2, arg3);
+            }
+            break;
+            
+        case SYSCALL_MOUSE_CONFIG:
+            // arg1 = sensitivity (0 = keep the curve), arg2 = packed(threshold/factor),
+            // arg3 = sample rate (0 = keep). Returns device_id << 16 | rate, -1 if the curve is invalid
+            {
+                mouse_accel_t curve;
+                curve.sensitivity = (uint16_t)arg1;
+                curve.threshold = (uint16_t)(arg2 & 0xFFFF);
+                curve.factor = (uint16_t)(arg2 >> 16);
+                if (arg1 && (arg1 > 0xFFFF || !mouse_set_accel(&curve))) {
+                    return_value = -1;
+                    break;
+                }
+                int rate = mouse_set_sample_rate((int)arg3);  // 0 is not a valid rate - no change
+                return_value = (mouse_get_device_id() << 16) | rate;
+            }
+            break;
+            
+        case SYSCALL_CLOCK_GETTIME:
+            // arg1 = clock id, arg2 = uint64_t *ns
+            if (arg1 == CLOCK_MONOTONIC && arg2) {
+                *(uint64_t *)arg2 = clock_monotonic_ns();
+                return_value = 0;
+            } else {
+                return_value = -1;
+            }
+            break;
+            
+        case SYSCALL_CLOCK_PAGE:
+            return_value = (uint32_t)clock_get_page();
+            break;
+            
+        case SYSCALL_NANOSLEEP: {
+            // arg1/arg2 = low/high words of the delay in ns
+            // A slice at a time: the scheduler only switches at a
+            // preemption point, never from inside the sleep
+            uint64_t left = ((uint64_t)arg2 << 32) | arg1;
+            while (left) {
+                uint64_t step = left < SCHED_SLICE_NS ? left : SCHED_SLICE_NS;
+                timer_sleep_ns(step);
+                left -= step;
+                scheduler_preempt_point();
+            }
+            return_value = 0;
+            break;
+        }
+            
+        case SYSCALL_IRQ_STATS:
+            // arg1 = irq_stats_t *, arg2 = IRQ_STATS_RESET to clear after reading
+            if (arg1) {
+                irq_get_stats((irq_stats_t *)arg1, arg2 & IRQ_STATS_RESET);
+                return_value = 0;
+            } else {
+                return_value = -1;
+            }
+            break;
+            
+        case SYSCALL_PROFILE_START:
+            // arg1 = samples per second
+            return_value = profile_start(arg1);
+            break;
+            
+        case SYSCALL_PROFILE_STOP:
+            profile_stop();
+            return_value = 0;
+            break;
+            
+        case SYSCALL_PROFILE_READ:
+            // arg1 = profile_sample_t *, arg2 = max samples, arg3 = profile_info_t * (may be 0)
+            return_value = profile_read((profile_sample_t *)arg1, (int)arg2, (profile_info_t *)arg3);
+            break;
+            
+        case SYSCALL_PROC_STATS:
+            // arg1 = proc_stats_t *, arg2 = max records
+            return_value = process_get_stats((proc_stats_t *)arg1, (int)arg2);
+            break;
+            
+        case SYSCALL_PMC_INFO:
+            // arg1 = pmc_info_t *
+            if (arg1) {
+                pmc_get_info((pmc_info_t *)arg1);
+                return_value = ((pmc_info_t *)arg1)->events;
+            } else {
+                return_value = -1;
+            }
+            break;
+            
         default:
             // Unknown syscall - print error
             kernel_puts("Unknown syscall: ");
@@ -501,5 +671,11 @@ unsigned int syscall_dispatcher(unsigned int syscall_num,
             break;
     }
     
+    TRACE_SYSCALL_EXIT(syscall_num, return_value, scheduler_get_current_pid());
+    
+    // Nothing is held any more - start a waiting process if the slice
+    // expired during the call
+    scheduler_preempt_point();
+    process_account_mode(PROCESS_MODE_USER);
     return return_value;
 }
@@ -49,6 +49,39 @@
 #define SYSCALL_POLL_MOUSE          35  // poll_mouse() - Manually poll 8042 for mouse data if IRQ12 stopped
 #define SYSCALL_READ_PIXEL          36  // read_pixel(x, y) - Read pixel from framebuffer for cursor compositor
 
+// Cursor syscalls
+#define SYSCALL_SET_CURSOR_IMAGE    37  // set_cursor_image(argb, w|h<<16, hot_x|hot_y<<16) - Kernel-composited cursor sprite
+#define SYSCALL_GFX_PRESENT         38  // gfx_present() - Show what was drawn since the last present
+
+// Clipping and line syscalls
+#define SYSCALL_GFX_CLIP_PUSH       39  // gfx_clip_push(x, y, w|h<<16) - Push clip rect, returns depth or -1
+#define SYSCALL_GFX_CLIP_POP        40  // gfx_clip_pop() - Pop clip rect, returns remaining depth
+#define SYSCALL_GFX_HLINE           41  // gfx_hline(x, y, length, color) - Horizontal line
+#define SYSCALL_GFX_VLINE           42  // gfx_vline(x, y, length, color) - Vertical line
+
+// Styled text
+#define SYSCALL_GFX_DRAW_TEXT       43  // gfx_draw_text(x, y, str, &{fg, bg, style}) - Returns pen x after the text, -1 on a null pointer
+
+// Sprites
+#define SYSCALL_GFX_BLIT_PREMUL     44  // gfx_blit_premul(src, x|y<<16, w|h<<16, stride) - Blend premultiplied ARGB pixels
+
+// Input events
+#define SYSCALL_GET_EVENTS          45  // get_events(buf, max, timeout_ms) - Wait for input events, returns count
+#define SYSCALL_MOUSE_CONFIG        46  // mouse_config(sensitivity, threshold|factor<<16, rate) - Tune the pointer, returns id<<16|rate
+
+// Time
+#define SYSCALL_CLOCK_GETTIME       47  // clock_gettime(clock_id, &ns) - Nanoseconds as uint64_t, returns 0 or -1
+#define SYSCALL_CLOCK_PAGE          48  // clock_page() - Address of the read-only clock_page_t
+#define SYSCALL_NANOSLEEP           49  // nanosleep(ns_lo, ns_hi) - Sleep on a kernel timer, returns 0
+
+// Diagnostics
+#define SYSCALL_IRQ_STATS           50  // irq_stats(&stats, flags) - Copy irq_stats_t (IRQ_STATS_RESET clears), returns 0 or -1
+#define SYSCALL_PROFILE_START       51  // profile_start(hz) - Start the sampling profiler (0 = default rate), returns 0 or -1
+#define SYSCALL_PROFILE_STOP        52  // profile_stop() - Stop sampling; samples stay readable
+#define SYSCALL_PROFILE_READ        53  // profile_read(samples, max, &info) - Drain samples, returns count
+#define SYSCALL_PROC_STATS          54  // proc_stats(records, max) - Per-process CPU accounting, returns count
+#define SYSCALL_PMC_INFO            55  // pmc_info(&info) - Performance counter layout for RDPMC, returns the events counting or -1
+
 // VGA Color constants (for reference)
 // Foreground/Background colors: 0-15
 // 0=Black, 1=Blue, 2=Green, 3=Cyan, 4=Red, 5=Magenta, 6=Brown, 7=Light Gray
@@ -333,3 +333,226 @@ unsigned int syscall_read_pixel(int x, int y) {
     );
     return result;
 }
+
+int syscall_set_cursor_image(const unsigned int *argb, int width, int height, int hot_x, int hot_y) {
+    int result;
+    unsigned int packed_wh = ((unsigned int)height << 16) | ((unsigned int)width & 0xFFFF);
+    unsigned int packed_hot = ((unsigned int)hot_y << 16) | ((unsigned int)hot_x & 0xFFFF);
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_SET_CURSOR_IMAGE), "b"(argb), "c"(packed_wh), "d"(packed_hot)
+        : "memory"
+    );
+    return result;
+}
+
+void syscall_gfx_present(void) {
+    asm volatile(
+        "int $0x80"
+        :
+        : "a"(SYSCALL_GFX_PRESENT)
+        : "memory"
+    );
+}
+
+int syscall_gfx_clip_push(int x, int y, int width, int height) {
+    int result;
+    unsigned int packed_wh = ((unsigned int)height << 16) | ((unsigned int)width & 0xFFFF);
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_GFX_CLIP_PUSH), "b"(x), "c"(y), "d"(packed_wh)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_gfx_clip_pop(void) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_GFX_CLIP_POP)
+        : "memory"
+    );
+    return result;
+}
+
+void syscall_gfx_hline(int x, int y, int length, unsigned int color) {
+    asm volatile(
+        "int $0x80"
+        :
+        : "a"(SYSCALL_GFX_HLINE), "b"(x), "c"(y), "d"(length), "S"(color)
+        : "memory"
+    );
+}
+
+void syscall_gfx_vline(int x, int y, int length, unsigned int color) {
+    asm volatile(
+        "int $0x80"
+        :
+        : "a"(SYSCALL_GFX_VLINE), "b"(x), "c"(y), "d"(length), "S"(color)
+        : "memory"
+    );
+}
+
+int syscall_gfx_draw_text(int x, int y, const char *str, unsigned int fg, unsigned int bg, int style) {
+    int result;
+    unsigned int params[3] = { fg, bg, (unsigned int)style };
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_GFX_DRAW_TEXT), "b"(x), "c"(y), "d"(str), "S"(params)
+        : "memory"
+    );
+    return result;
+}
+
+void syscall_gfx_blit_premul(int x, int y, int width, int height, const unsigned int *src, int stride) {
+    unsigned int packed_xy = ((unsigned int)y << 16) | ((unsigned int)x & 0xFFFF);
+    unsigned int packed_wh = ((unsigned int)height << 16) | ((unsigned int)width & 0xFFFF);
+    asm volatile(
+        "int $0x80"
+        :
+        : "a"(SYSCALL_GFX_BLIT_PREMUL), "b"(src), "c"(packed_xy), "d"(packed_wh), "S"(stride)
+        : "memory"
+    );
+}
+
+int syscall_get_events(input_event_t *buf, int max, unsigned int timeout_ms) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_GET_EVENTS), "b"(buf), "c"(max), "d"(timeout_ms)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_mouse_config(int sensitivity, int threshold, int factor, int sample_rate) {
+    int result;
+    unsigned int packed = ((unsigned int)factor << 16) | ((unsigned int)threshold & 0xFFFF);
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_MOUSE_CONFIG), "b"(sensitivity), "c"(packed), "d"(sample_rate)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_clock_gettime(int clock_id, uint64_t *ns) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_CLOCK_GETTIME), "b"(clock_id), "c"(ns)
+        : "memory"
+    );
+    return result;
+}
+
+const clock_page_t *syscall_clock_page(void) {
+    const clock_page_t *result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_CLOCK_PAGE)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_nanosleep(uint64_t ns) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_NANOSLEEP), "b"((uint32_t)ns), "c"((uint32_t)(ns >> 32))
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_irq_stats(irq_stats_t *stats, unsigned int flags) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_IRQ_STATS), "b"(stats), "c"(flags)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_profile_start(unsigned int hz) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_PROFILE_START), "b"(hz)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_profile_stop(void) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_PROFILE_STOP)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_profile_read(profile_sample_t *samples, int max, profile_info_t *info) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_PROFILE_READ), "b"(samples), "c"(max), "d"(info)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_proc_stats(proc_stats_t *records, int max) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_PROC_STATS), "b"(records), "c"(max)
+        : "memory"
+    );
+    return result;
+}
+
+int syscall_pmc_info(pmc_info_t *info) {
+    int result;
+    asm volatile(
+        "int $0x80"
+        : "=a"(result)
+        : "a"(SYSCALL_PMC_INFO), "b"(info)
+        : "memory"
+    );
+    return result;
+}
+
+/**
+ * Monotonic nanoseconds - from the clock page when the TSC is usable,
+ * otherwise through SYSCALL_CLOCK_GETTIME
+ */
+uint64_t user_clock_monotonic_ns(void) {
+    static const clock_page_t *page = 0;
+    if (!page) page = syscall_clock_page();
+
+    if (page && page->mult) return clock_page_read_ns(page);
+
+    uint64_t ns = 0;
+    syscall_clock_gettime(CLOCK_MONOTONIC, &ns);
+    return ns;
+}
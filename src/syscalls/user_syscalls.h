@@ -4,6 +4,24 @@
 /* Include syscall number definitions */
 #include "syscall_numbers.h"
 
+/* Input event layout shared with the kernel */
+#include "../drivers/input.h"
+
+/* Clock page layout and reader shared with the kernel */
+#include "../managers/timer/clock.h"
+
+/* Interrupt statistics layout shared with the kernel */
+#include "../managers/irq/irq_manager.h"
+
+/* Profiler sample layout shared with the kernel */
+#include "../managers/profile/profiler.h"
+
+/* Process accounting records shared with the kernel */
+#include "../managers/process/process_manager.h"
+
+/* Performance counter layout and benchmark regions shared with the kernel */
+#include "../managers/pmc/pmc.h"
+
 /**
  * Ring 3 Syscall Interface
  * 
@@ -115,7 +133,7 @@ void gfx_set_color(int fg, int bg);
  */
 void syscall_fill_rect(int x, int y, int width, int height, unsigned int color);
 void syscall_draw_rect(int x, int y, int width, int height, unsigned int color);
-void syscall_print_at(int x, int y, const char *str, unsigned int fg, unsigned int bg);
+void syscall_print_at(int x, int y, const char *str, unsigned int fg, unsigned int bg);  // bg alpha 0 = transparent
 void syscall_gfx_clear_color(unsigned int rgb_color);
 void syscall_draw_bmp(int x, int y, unsigned int bmp_data_addr);
 
@@ -144,4 +162,109 @@ void syscall_re_enable_mouse(void);
  */
 unsigned int syscall_read_pixel(int x, int y);
 
+/**
+ * Cursor syscalls - the kernel composites the sprite from the mouse IRQ
+ * argb: width*height pixels (max 32x32), alpha 0 = transparent
+ * Returns 1 on success, 0 if the image was rejected
+ */
+int syscall_set_cursor_image(const unsigned int *argb, int width, int height, int hot_x, int hot_y);
+
+/**
+ * Show everything drawn since the last present
+ * All drawing goes to an off-screen buffer. By default it is a RAM shadow;
+ * in page-flip mode the back page is flipped to the front. Either way only
+ * the changed areas are copied, so partial redraws are fine.
+ */
+void syscall_gfx_present(void);
+
+/**
+ * Clip stack - drawing (except clear) stays inside the top rectangle
+ * Each push is intersected with the current clip. Width/height are
+ * limited to 16 bits. Push returns the new depth or -1 when full,
+ * pop returns the remaining depth.
+ */
+int syscall_gfx_clip_push(int x, int y, int width, int height);
+int syscall_gfx_clip_pop(void);
+
+/**
+ * One-pixel horizontal/vertical lines
+ */
+void syscall_gfx_hline(int x, int y, int length, unsigned int color);
+void syscall_gfx_vline(int x, int y, int length, unsigned int color);
+
+/**
+ * Text with FONT_STYLE_* flags (proportional and/or anti-aliased)
+ * Same colour rules as syscall_print_at. Returns the pen x after the text.
+ */
+int syscall_gfx_draw_text(int x, int y, const char *str, unsigned int fg, unsigned int bg, int style);
+
+/**
+ * Blend a block of premultiplied ARGB pixels (e.g. a sprite atlas entry)
+ * x/y are packed as signed 16-bit, width/height as 16-bit; stride is in pixels
+ */
+void syscall_gfx_blit_premul(int x, int y, int width, int height, const unsigned int *src, int stride);
+
+/**
+ * Collect up to max input events (motion coalesced, button down/up)
+ * Sleeps until one arrives or timeout_ms passes; INPUT_NO_WAIT returns at
+ * once, INPUT_WAIT_FOREVER never times out. Returns the number of events.
+ */
+int syscall_get_events(input_event_t *buf, int max, unsigned int timeout_ms);
+
+/**
+ * Tune the pointer: acceleration curve (see mouse_accel_t in
+ * drivers/mouse.h, sensitivity 0 keeps the current curve) and sample
+ * rate in Hz (0 keeps it). Returns device_id << 16 | sample rate, where
+ * device_id 3 has a wheel and 4 also buttons 4/5; -1 if the curve is
+ * out of range.
+ */
+int syscall_mouse_config(int sensitivity, int threshold, int factor, int sample_rate);
+
+/**
+ * Monotonic time: SYSCALL_CLOCK_GETTIME traps, user_clock_monotonic_ns
+ * reads the shared clock page (no trap) and only falls back to the
+ * syscall when there is no TSC
+ */
+int syscall_clock_gettime(int clock_id, uint64_t *ns);
+const clock_page_t *syscall_clock_page(void);
+uint64_t user_clock_monotonic_ns(void);
+
+/**
+ * Sleep for ns on a kernel timer (sub-millisecond when the LAPIC or PIT
+ * runs one-shot; rounded up to the 1ms tick otherwise)
+ */
+int syscall_nanosleep(uint64_t ns);
+
+/**
+ * Interrupt counts and handler timings per IRQ line (see irq_stats_t)
+ * flags: IRQ_STATS_RESET clears the counters after the copy
+ */
+int syscall_irq_stats(irq_stats_t *stats, unsigned int flags);
+
+/**
+ * Sampling profiler: the timer records the interrupted EIP and ring
+ * hz samples per second (0 = PROFILE_DEFAULT_HZ); start discards old samples
+ */
+int syscall_profile_start(unsigned int hz);
+int syscall_profile_stop(void);
+
+/**
+ * Drain up to max samples, oldest first; info (may be 0) gets the rate,
+ * the samples still waiting and the user image bases
+ */
+int syscall_profile_read(profile_sample_t *samples, int max, profile_info_t *info);
+
+/**
+ * Per-process CPU cycles, syscall, page-fault and switch counts
+ * Record 0 is idle time; returns the number of records filled
+ */
+int syscall_proc_stats(proc_stats_t *records, int max);
+
+/**
+ * Which performance counters are counting (see pmc.h); returns the
+ * pmc_info_t events mask, 0 when RDPMC must not be used (-1 for a null
+ * info)
+ */
+int syscall_pmc_info(pmc_info_t *info);
+
 #endif // USER_SYSCALLS_H
\ No newline at end of file
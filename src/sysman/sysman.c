@@ -17,11 +17,15 @@ void sysman_main_c(void) {
     // Display version at bottom right
     gui_draw_text(850, 730, "MaahiOS v0.1", 0xFFFFFF, 0);  // White text
     
+    // Show the splash
+    gui_present();
+    
     // Get orbit address
     unsigned int orbit_addr = syscall_get_orbit_address();
     
     if (orbit_addr == 0) {
         gui_draw_text(450, 420, "ERROR: ORBIT NOT LOADED", 0xFF0000, 0);
+        gui_present();
         while(1) __asm__ volatile("hlt");
     }
     
@@ -30,13 +34,16 @@ void sysman_main_c(void) {
     
     if (orbit_pid < 0) {
         gui_draw_text(450, 420, "ERROR: FAILED TO START ORBIT", 0xFF0000, 0);
+        gui_present();
         while(1) __asm__ volatile("hlt");
     }
     
-    // Sysman continues running as system tray
+    // Orbit takes the CPU at the end of this slice and keeps it (the
+    // diagnostics are in orbit's system monitor); sysman just waits
     gui_clear_screen(0x000000);
     gui_draw_text(10, 10, "Sysman running (PID 1)", 0x00FF00, 0);
+    gui_present();
     while(1) {
-        __asm__ volatile("hlt");
+        syscall_nanosleep(1000000000ULL);
     }
-}
\ No newline at end of file
+}
@@ -1,78 +1,147 @@
 #!/usr/bin/env python3
 """
-Convert BMP files to C byte arrays for embedding in MaahiOS
+Convert the desktop icon BMPs into a sprite atlas for MaahiOS
+
+Every icon is decoded once at build time: rows are flipped to top-down,
+colours are premultiplied by alpha, and all icons are packed into a
+single ARGB atlas with a metadata table. At run time a sprite is drawn
+by ID with one blit - no header parsing or row flipping per draw.
+
+Usage: bmp_to_c.py [icon_atlas.h]
+Writes libraries/icons/icon_atlas.h (the checked-in copy) by default;
+build.sh passes a path in build/binaries and compiles that instead.
 """
 
 import os
+import struct
+import sys
+
+ATLAS_MAX_WIDTH = 256
+
+# (file, sprite ID) - IDs are generated in this order
+ICONS = [
+    ('file_icon.bmp', 'ICON_SPRITE_FILE'),
+    ('process_icon.bmp', 'ICON_SPRITE_PROCESS'),
+    ('disk_icon.bmp', 'ICON_SPRITE_DISK'),
+    ('notebook_icon.bmp', 'ICON_SPRITE_NOTEBOOK'),
+]
+
+
+def load_bmp(filename):
+    """Return (width, height, rows) with rows top-down lists of ARGB ints"""
+    with open(filename, 'rb') as f:
+        data = f.read()
+    if data[:2] != b'BM':
+        raise SystemExit(f"{filename}: not a BMP file")
+    offset = struct.unpack_from('<I', data, 10)[0]
+    width, height, planes, bpp, compression = struct.unpack_from('<iiHHI', data, 18)
+    if bpp != 32 or compression not in (0, 3):
+        raise SystemExit(f"{filename}: only uncompressed 32-bit BMPs are supported")
+
+    bottom_up = height > 0
+    height = abs(height)
+    rows = []
+    for y in range(height):
+        start = offset + y * width * 4
+        rows.append(list(struct.unpack_from(f'<{width}I', data, start)))
+    if bottom_up:
+        rows.reverse()
+    return width, height, rows
+
+
+def premultiply(argb):
+    a = argb >> 24
+    r = ((argb >> 16) & 0xFF) * a
+    g = ((argb >> 8) & 0xFF) * a
+    b = (argb & 0xFF) * a
+    return (a << 24) | (((r + 127) // 255) << 16) | (((g + 127) // 255) << 8) | ((b + 127) // 255)
+
+
+def pack(sizes):
+    """Shelf-pack (width, height) boxes; returns positions and atlas size"""
+    order = sorted(range(len(sizes)), key=lambda i: -sizes[i][1])
+    positions = [None] * len(sizes)
+    x = y = shelf_h = atlas_w = 0
+    for i in order:
+        w, h = sizes[i]
+        if x + w > ATLAS_MAX_WIDTH:
+            x = 0
+            y += shelf_h
+            shelf_h = 0
+        positions[i] = (x, y)
+        x += w
+        shelf_h = max(shelf_h, h)
+        atlas_w = max(atlas_w, x)
+    return positions, atlas_w, y + shelf_h
 
-def bmp_to_c_array(bmp_filename, array_name):
-    """Convert BMP file to C byte array"""
-    with open(bmp_filename, 'rb') as f:
-        bmp_data = f.read()
-    
-    output = f"// {array_name} - Embedded BMP data\n"
-    output += f"const uint8_t {array_name}[{len(bmp_data)}] = {{\n    "
-    
-    for i, byte in enumerate(bmp_data):
-        output += f"0x{byte:02X}"
-        if i < len(bmp_data) - 1:
-            output += ","
-            if (i + 1) % 12 == 0:
-                output += "\n    "
-            else:
-                output += " "
-    
-    output += "\n};\n\n"
-    return output
 
 def main():
-    # Icons are now in tools directory
-    icons_dir = '.'
-    # Output C header to libraries/icons
-    output_dir = '../libraries/icons'
-    os.makedirs(output_dir, exist_ok=True)
-    output_file = os.path.join(output_dir, 'embedded_icons.h')
-    
-    header = """#ifndef EMBEDDED_ICONS_H
-#define EMBEDDED_ICONS_H
-
-#include <stdint.h>
-
-/**
- * Embedded BMP icon data for MaahiOS desktop
- * Generated from tools/*.bmp files
- */
+    icons_dir = os.path.dirname(os.path.abspath(__file__))
+    if len(sys.argv) > 1:
+        output_file = sys.argv[1]
+    else:
+        output_file = os.path.join(icons_dir, '..', 'libraries', 'icons', 'icon_atlas.h')
+    os.makedirs(os.path.dirname(os.path.abspath(output_file)), exist_ok=True)
+
+    sprites = []
+    for filename, sprite_id in ICONS:
+        path = os.path.join(icons_dir, filename)
+        print(f"Converting {filename}...")
+        sprites.append((sprite_id, filename) + load_bmp(path))
+
+    positions, atlas_w, atlas_h = pack([(s[2], s[3]) for s in sprites])
+    atlas = [0] * (atlas_w * atlas_h)
+    for (sprite_id, filename, w, h, rows), (px, py) in zip(sprites, positions):
+        for y in range(h):
+            for x in range(w):
+                atlas[(py + y) * atlas_w + px + x] = premultiply(rows[y][x])
+
+    out = []
+    out.append("#ifndef ICON_ATLAS_H")
+    out.append("#define ICON_ATLAS_H")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("/**")
+    out.append(" * Desktop icon atlas for MaahiOS")
+    out.append(" * Generated by tools/bmp_to_c.py - premultiplied ARGB, top-down rows")
+    out.append(" */")
+    out.append("")
+    out.append(f"#define ICON_ATLAS_WIDTH    {atlas_w}")
+    out.append(f"#define ICON_ATLAS_HEIGHT   {atlas_h}")
+    out.append("")
+    for i, s in enumerate(sprites):
+        out.append(f"#define {s[0]:<24}{i}")
+    out.append(f"#define {'ICON_SPRITE_COUNT':<24}{len(sprites)}")
+    out.append("")
+    out.append("typedef struct {")
+    out.append("    uint16_t x, y;              // Top-left in the atlas")
+    out.append("    uint16_t width, height;")
+    out.append("} icon_sprite_t;")
+    out.append("")
+    out.append("// Pixel data is only compiled where ICON_ATLAS_DATA is defined (libgui/sprite.c)")
+    out.append("#ifdef ICON_ATLAS_DATA")
+    out.append("")
+    out.append("const icon_sprite_t icon_sprites[ICON_SPRITE_COUNT] = {")
+    for (sprite_id, filename, w, h, rows), (px, py) in zip(sprites, positions):
+        out.append(f"    {{ {px:3d}, {py:3d}, {w:3d}, {h:3d} }},  // {sprite_id} ({filename})")
+    out.append("};")
+    out.append("")
+    out.append("const uint32_t icon_atlas[ICON_ATLAS_WIDTH * ICON_ATLAS_HEIGHT] = {")
+    for i in range(0, len(atlas), 8):
+        out.append("    " + ", ".join(f"0x{v:08X}" for v in atlas[i:i + 8]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("#endif // ICON_ATLAS_DATA")
+    out.append("")
+    out.append("#endif // ICON_ATLAS_H")
+    out.append("")
 
-"""
-    
-    footer = """#endif // EMBEDDED_ICONS_H
-"""
-    
-    content = header
-    
-    # Convert each BMP file
-    icons = {
-        'file_icon.bmp': 'icon_file_bmp',
-        'process_icon.bmp': 'icon_process_bmp',
-        'disk_icon.bmp': 'icon_disk_bmp',
-        'notebook_icon.bmp': 'icon_notebook_bmp'
-    }
-    
-    for filename, array_name in icons.items():
-        filepath = os.path.join(icons_dir, filename)
-        if os.path.exists(filepath):
-            print(f"Converting {filename}...")
-            content += bmp_to_c_array(filepath, array_name)
-        else:
-            print(f"Warning: {filepath} not found, skipping...")
-    
-    content += footer
-    
     with open(output_file, 'w') as f:
-        f.write(content)
-    
-    print(f"\nGenerated {output_file}")
-    print("Icons embedded and ready to use!")
+        f.write('\n'.join(out))
+
+    print(f"\nGenerated {output_file}: {len(sprites)} sprites in a {atlas_w}x{atlas_h} atlas")
+
 
 if __name__ == '__main__':
     main()
@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+"""
+Generate the MaahiOS font tables from a bitmap font source
+
+Reads tools/font/maahi_8x16.txt and writes font_data.c (build.sh puts it
+in build/binaries; src/lib/font_data.c is the checked-in copy) with:
+  - font_glyphs: per-glyph ink width, bearing and proportional advance
+  - font_bitmap: 1bpp rows, left-aligned to the ink (bit 7 = first ink column)
+  - font_alpha:  4bpp anti-aliased rows ((width + 1) / 2 bytes per row)
+
+The anti-aliased variant is derived from the bitmap: each glyph is scaled
+2x with EPX (which rounds corners and fills diagonal steps) and box-filtered
+back down, giving 0/25/75/100% coverage at the edges.
+
+Usage: font_to_c.py <font.txt> <font_data.c>
+"""
+
+import os
+import sys
+
+CELL_W = 8
+HEIGHT = 16
+FIRST = 0x20
+LAST = 0x7E
+SPACE_ADVANCE = 4
+
+
+def parse_font(path):
+    """Return {code or 'missing': [16 row ints]}"""
+    glyphs = {}
+    name = None
+    rows = []
+    with open(path) as f:
+        for lineno, line in enumerate(f, 1):
+            line = line.strip()
+            if not line or line.startswith('#') and name is None:
+                continue
+            if line.startswith('glyph '):
+                if name is not None:
+                    raise SystemExit(f"{path}:{lineno}: glyph {name} has {len(rows)} rows")
+                key = line.split()[1]
+                name = 'missing' if key == 'missing' else int(key, 0)
+                rows = []
+                continue
+            if name is None:
+                raise SystemExit(f"{path}:{lineno}: row outside a glyph")
+            if len(line) != CELL_W or set(line) - set('#.'):
+                raise SystemExit(f"{path}:{lineno}: rows are {CELL_W} of '#' or '.'")
+            rows.append(int(line.replace('#', '1').replace('.', '0'), 2))
+            if len(rows) == HEIGHT:
+                glyphs[name] = rows
+                name = None
+    if name is not None:
+        raise SystemExit(f"{path}: glyph {name} is incomplete")
+    for code in list(range(FIRST, LAST + 1)) + ['missing']:
+        if code not in glyphs:
+            raise SystemExit(f"{path}: glyph {code} is missing")
+    return glyphs
+
+
+def ink_extent(rows):
+    """First ink column and ink width (0, 0 for an empty glyph)"""
+    mask = 0
+    for r in rows:
+        mask |= r
+    if mask == 0:
+        return 0, 0
+    cols = [c for c in range(CELL_W) if mask & (0x80 >> c)]
+    return cols[0], cols[-1] - cols[0] + 1
+
+
+def antialias(rows):
+    """EPX 2x upscale then 2x2 box filter -> 16 rows of 8 alpha values (0-15)"""
+    def px(x, y):
+        if x < 0 or y < 0 or x >= CELL_W or y >= HEIGHT:
+            return 0
+        return 1 if rows[y] & (0x80 >> x) else 0
+
+    alpha = []
+    for y in range(HEIGHT):
+        out = []
+        for x in range(CELL_W):
+            p = px(x, y)
+            a, b, c, d = px(x, y - 1), px(x + 1, y), px(x - 1, y), px(x, y + 1)
+            s1 = a if (c == a and c != d and a != b) else p
+            s2 = b if (a == b and a != c and b != d) else p
+            s3 = c if (d == c and d != b and c != a) else p
+            s4 = d if (b == d and b != a and d != c) else p
+            coverage = s1 + s2 + s3 + s4
+            out.append((coverage * 15 + 2) // 4)
+        alpha.append(out)
+    return alpha
+
+
+def emit_bytes(values, indent='    ', per_line=16):
+    lines = []
+    for i in range(0, len(values), per_line):
+        lines.append(indent + ', '.join(f"0x{v:02X}" for v in values[i:i + per_line]) + ',')
+    return '\n'.join(lines)
+
+
+def main():
+    if len(sys.argv) != 3:
+        raise SystemExit(__doc__)
+    src, dst = sys.argv[1], sys.argv[2]
+    glyphs = parse_font(src)
+    order = list(range(FIRST, LAST + 1)) + ['missing']
+
+    meta = []
+    bitmap = []
+    alpha = []
+    for code in order:
+        rows = glyphs[code]
+        bearing, width = ink_extent(rows)
+        advance = width + 1 if width else SPACE_ADVANCE
+
+        # 1bpp, shifted so the first ink column is bit 7
+        bitmap.extend((r << bearing) & 0xFF for r in rows)
+
+        # 4bpp, ink columns only, high nibble first
+        aa = antialias(rows)
+        offset = len(alpha)
+        for y in range(HEIGHT):
+            for x in range(CELL_W):
+                if aa[y][x] and not bearing <= x < bearing + width:
+                    raise SystemExit(f"glyph {code}: anti-aliasing left the ink box")
+            cols = aa[y][bearing:bearing + width]
+            if len(cols) % 2:
+                cols.append(0)
+            for i in range(0, len(cols), 2):
+                alpha.append((cols[i] << 4) | cols[i + 1])
+        meta.append((code, offset, width, bearing, advance))
+
+    out = []
+    out.append("/*")
+    out.append(f" * Generated by tools/font_to_c.py from tools/font/{os.path.basename(src)}")
+    out.append(" * Do not edit - change the font source and rebuild")
+    out.append(" */")
+    out.append("")
+    out.append('#include "font.h"')
+    out.append("")
+    out.append("const font_glyph_t font_glyphs[FONT_GLYPH_COUNT] = {")
+    for code, offset, width, bearing, advance in meta:
+        label = 'missing' if code == 'missing' else repr(chr(code))
+        out.append(f"    {{ {offset:5d}, {width}, {bearing}, {advance} }},  // {label}")
+    out.append("};")
+    out.append("")
+    out.append("const uint8_t font_bitmap[FONT_GLYPH_COUNT * FONT_HEIGHT] = {")
+    out.append(emit_bytes(bitmap))
+    out.append("};")
+    out.append("")
+    out.append(f"const uint8_t font_alpha[{len(alpha)}] = {{")
+    out.append(emit_bytes(alpha))
+    out.append("};")
+    out.append("")
+
+    with open(dst, 'w') as f:
+        f.write('\n'.join(out))
+    print(f"Generated {dst}: {len(order)} glyphs, {len(alpha)} bytes of AA alpha")
+
+
+if __name__ == '__main__':
+    main()
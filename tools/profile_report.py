@@ -0,0 +1,176 @@
+#!/usr/bin/env python3
+"""
+Flat profile from MaahiOS profiler samples
+
+Press F12 in orbit to start the sampling profiler and F12 again to stop
+it; orbit then writes the samples to the serial log as
+
+  [PROF] BEGIN hz=1000 dropped=0 sysman=<hex> orbit=<hex>
+  [PROF] <eip>:<ring> <eip>:<ring> ...
+  [PROF] END
+
+This script resolves each EIP against the kernel, sysman and orbit ELF
+symbol tables and prints samples per function. Ring 0 samples belong to
+the kernel; ring 3 samples to whichever user image contains them (sysman
+is linked at 0 and runs in place from its module, so its load address
+comes from the BEGIN line).
+
+Usage (from the tools directory, after ./build.sh):
+  python3 profile_report.py ../qemu_serial.log
+  python3 profile_report.py serial.log --build ../build --top 30
+"""
+
+import argparse
+import bisect
+import os
+import struct
+import sys
+
+SHT_SYMTAB = 2
+SHF_ALLOC = 0x2
+SHF_EXECINSTR = 0x4
+STT_NOTYPE = 0
+STT_FUNC = 2
+
+
+class Image:
+    """Code symbols and address extent of one ELF file"""
+
+    def __init__(self, name, path):
+        self.name = name
+        self.starts = []
+        self.symbols = []       # (start, end or None, name), sorted by start
+        self.low = None
+        self.high = None
+        self.load(path)
+
+    def load(self, path):
+        with open(path, 'rb') as f:
+            data = f.read()
+        if data[:4] != b'\x7fELF' or data[4] != 1:
+            raise ValueError('%s: not a 32-bit ELF file' % path)
+
+        shoff, = struct.unpack_from('<I', data, 0x20)
+        shentsize, shnum = struct.unpack_from('<HH', data, 0x2E)
+        sections = [struct.unpack_from('<10I', data, shoff + i * shentsize) for i in range(shnum)]
+
+        for _, sh_type, flags, addr, _, size, _, _, _, _ in sections:
+            if flags & SHF_ALLOC and size:
+                self.low = addr if self.low is None else min(self.low, addr)
+                self.high = addr + size if self.high is None else max(self.high, addr + size)
+
+        found = []
+        for _, sh_type, _, _, offset, size, link, _, _, entsize in sections:
+            if sh_type != SHT_SYMTAB:
+                continue
+            strtab = sections[link]
+            for at in range(offset, offset + size, entsize or 16):
+                name_off, value, sym_size, info, _, shndx = struct.unpack_from('<IIIBBH', data, at)
+                if info & 0xF not in (STT_NOTYPE, STT_FUNC) or not 0 < shndx < len(sections):
+                    continue
+                if not sections[shndx][2] & SHF_EXECINSTR:
+                    continue
+                name_at = strtab[4] + name_off
+                name = data[name_at:data.index(b'\0', name_at)].decode('ascii', 'replace')
+                if name:
+                    found.append((value, value + sym_size if sym_size else None, name))
+
+        found.sort()
+        self.symbols = found
+        self.starts = [s[0] for s in found]
+
+    def contains(self, address):
+        return self.low is not None and self.low <= address < self.high
+
+    def lookup(self, address):
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i < 0:
+            return None
+        start, end, name = self.symbols[i]
+        if end is not None and address >= end:
+            return None
+        return name
+
+
+def read_samples(path):
+    """(info dict, [(eip, ring)]) of the last complete dump in a log"""
+    info, samples, current = None, [], None
+    with open(path, errors='replace') as f:
+        for line in f:
+            at = line.find('[PROF] ')
+            if at < 0:
+                continue
+            fields = line[at + 7:].split()
+            if not fields:
+                continue
+            if fields[0] == 'BEGIN':
+                current = {'info': dict(kv.split('=', 1) for kv in fields[1:] if '=' in kv), 'samples': []}
+            elif fields[0] == 'END':
+                if current is not None:
+                    info, samples = current['info'], current['samples']
+                current = None
+            elif current is not None:
+                for field in fields:
+                    eip, _, ring = field.partition(':')
+                    current['samples'].append((int(eip, 16), int(ring or '0')))
+    if info is None and current is not None:
+        info, samples = current['info'], current['samples']     # Log cut off before END
+    return info, samples
+
+
+def main():
+    tools = os.path.dirname(os.path.abspath(__file__))
+    parser = argparse.ArgumentParser(description='Flat profile from MaahiOS profiler samples')
+    parser.add_argument('log', help='serial log containing a [PROF] dump')
+    parser.add_argument('--build', default=os.path.join(tools, '..', 'build'),
+                        help='directory with kernel.bin, sysman.elf and orbit.elf')
+    parser.add_argument('--top', type=int, default=40, help='functions to list (0 = all)')
+    args = parser.parse_args()
+
+    info, samples = read_samples(args.log)
+    if info is None:
+        sys.exit('%s: no [PROF] dump found' % args.log)
+    if not samples:
+        sys.exit('%s: the dump has no samples' % args.log)
+
+    images = {}
+    for name, filename in (('kernel', 'kernel.bin'), ('sysman', 'sysman.elf'), ('orbit', 'orbit.elf')):
+        try:
+            images[name] = Image(name, os.path.join(args.build, filename))
+        except (OSError, ValueError) as e:
+            print('warning: %s' % e, file=sys.stderr)
+
+    bases = {'kernel': 0, 'sysman': int(info.get('sysman', '0'), 16), 'orbit': int(info.get('orbit', '0'), 16)}
+    if 'orbit' in images and images['orbit'].low is not None:
+        bases['orbit'] -= images['orbit'].low       # Linked where it runs: no relocation
+
+    counts = {}
+    rings = [0, 0, 0, 0]
+    for eip, ring in samples:
+        rings[ring & 3] += 1
+        where = '?'
+        function = '0x%08x' % eip
+        candidates = ['kernel'] if ring == 0 else ['orbit', 'sysman']
+        for name in candidates:
+            image = images.get(name)
+            if image and image.contains(eip - bases[name]):
+                where = name
+                function = image.lookup(eip - bases[name]) or function
+                break
+        counts[(where, function)] = counts.get((where, function), 0) + 1
+
+    total = len(samples)
+    print('%d samples at %s Hz, %s dropped - kernel %.1f%%, user %.1f%%' %
+          (total, info.get('hz', '?'), info.get('dropped', '?'),
+           100.0 * rings[0] / total, 100.0 * rings[3] / total))
+    print()
+    print('%8s %7s  %-7s %s' % ('samples', '%', 'image', 'function'))
+    ranked = sorted(counts.items(), key=lambda kv: -kv[1])
+    if args.top:
+        ranked = ranked[:args.top]
+    for (where, function), n in ranked:
+        print('%8d %6.2f%%  %-7s %s' % (n, 100.0 * n / total, where, function))
+
+
+if __name__ == '__main__':
+    main()
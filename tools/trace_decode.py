@@ -0,0 +1,238 @@
+#!/usr/bin/env python3
+"""
+Convert a MaahiOS kernel trace into Chrome trace JSON
+
+The kernel (built with TRACE=1 ./build.sh) keeps a ring of fixed-size
+records per CPU - see src/managers/trace/trace.h. Two ways to get it out:
+
+  serial   A kernel panic dumps the ring as "[TRACE] <offset> <hex>" lines
+           between "[TRACE] BEGIN" and "[TRACE] END". Pass the serial log.
+  memory   From the QEMU monitor:
+             pmemsave <addr> <size> trace.bin
+           with addr from `i686-elf-nm kernel.bin | grep trace_buffers`
+           and size = 32 + 24 * TRACE_RECORDS per CPU. Pass the file.
+
+Usage:
+  python3 trace_decode.py qemu_serial.log -o trace.json
+  python3 trace_decode.py trace.bin -o trace.json
+
+Open the result in chrome://tracing or https://ui.perfetto.dev.
+Syscalls and IRQs become nested slices on each CPU's track, the running
+process gets its own track, and page faults are instant events.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = b'MAAHITRC'
+HEADER = struct.Struct('<8sIIIIII')     # magic, version, cpu, tsc_khz, record_size, capacity, head
+RECORD = struct.Struct('<QI3I')         # tsc, event, arg[3]
+
+# Mirrors TRACE_EV_* in trace.h
+EV_SYSCALL_ENTER = 1
+EV_SYSCALL_EXIT = 2
+EV_IRQ_ENTER = 3
+EV_IRQ_EXIT = 4
+EV_CONTEXT_SWITCH = 5
+EV_PAGE_FAULT = 6
+
+IRQ_LAPIC_TIMER = 16                    # IRQ_STATS_LAPIC_TIMER
+IRQ_NAMES = {0: 'PIT', 1: 'keyboard', 4: 'COM1', 12: 'PS/2 mouse', IRQ_LAPIC_TIMER: 'LAPIC timer'}
+
+DEFAULT_SYSCALLS = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                                '..', 'src', 'syscalls', 'syscall_numbers.h')
+
+
+def load_syscall_names(path):
+    """Map syscall numbers to names from syscall_numbers.h"""
+    names = {}
+    try:
+        with open(path) as f:
+            for line in f:
+                m = re.match(r'\s*#define\s+SYSCALL_(\w+)\s+(\d+)', line)
+                if m:
+                    names.setdefault(int(m.group(2)), m.group(1).lower())
+    except OSError:
+        pass
+    return names
+
+
+def parse_buffer(data):
+    """Return (header dict, records oldest first) for one ring image"""
+    magic, version, cpu, tsc_khz, record_size, capacity, head = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != 1 or not capacity or capacity & (capacity - 1):
+        raise ValueError('not a trace buffer')      # e.g. the magic string in .rodata
+    if record_size != RECORD.size:
+        raise ValueError('record size %d, expected %d (version %d)' % (record_size, RECORD.size, version))
+
+    available = (len(data) - HEADER.size) // record_size
+    used = min(head, capacity, available)
+    first = head - used                 # Oldest record still in the ring
+    records = []
+    for n in range(first, first + used):
+        slot = n % capacity
+        if slot >= available:
+            continue
+        records.append(RECORD.unpack_from(data, HEADER.size + slot * record_size))
+
+    header = {'cpu': cpu, 'tsc_khz': tsc_khz, 'head': head, 'capacity': capacity}
+    return header, records
+
+
+def buffers_from_memory(data):
+    """Every ring in a raw memory image, found by its magic"""
+    buffers = []
+    at = data.find(MAGIC)
+    while at >= 0:
+        buffers.append(data[at:])
+        at = data.find(MAGIC, at + 1)
+    return buffers
+
+
+def buffers_from_serial(text):
+    """Rebuild ring images from the hex dump in a serial log"""
+    buffers = []
+    current = None
+    for line in text.splitlines():
+        at = line.find('[TRACE] ')
+        if at < 0:
+            continue
+        fields = line[at + 8:].split()
+        if not fields:
+            continue
+        if fields[0] == 'BEGIN':
+            current = bytearray()
+        elif fields[0] == 'END':
+            if current is not None:
+                buffers.append(bytes(current))
+            current = None
+        elif current is not None and len(fields) == 2:
+            offset = int(fields[0], 16)
+            chunk = bytes.fromhex(fields[1])
+            if offset != len(current):
+                print('warning: gap in dump at offset 0x%x' % len(current), file=sys.stderr)
+                if offset > len(current):
+                    current.extend(bytes(offset - len(current)))
+                else:
+                    del current[offset:]
+            current.extend(chunk)
+    if current:
+        buffers.append(bytes(current))  # Log cut off before END
+    return buffers
+
+
+def to_chrome(header, records, syscall_names):
+    """Chrome trace events for one CPU"""
+    cpu = header['cpu']
+    khz = header['tsc_khz'] or 1000000  # Unknown rate: show TSC ticks as 1 GHz
+    pid = 0
+    cpu_tid = cpu * 2 + 1
+    proc_tid = cpu * 2 + 2
+
+    stamped = [r for r in records if r[0]]
+    base = stamped[0][0] if stamped else 0
+
+    def ts(tsc):
+        return max(tsc - base, 0) * 1000.0 / khz    # Microseconds
+
+    events = [
+        {'ph': 'M', 'pid': pid, 'tid': cpu_tid, 'name': 'thread_name', 'args': {'name': 'cpu%d' % cpu}},
+        {'ph': 'M', 'pid': pid, 'tid': proc_tid, 'name': 'thread_name', 'args': {'name': 'cpu%d process' % cpu}},
+    ]
+    stack = []          # Open (kind, id) slices on the CPU track
+    running = None
+    last = 0.0
+
+    def close_to(kind, ident, t):
+        """End slices down to (kind, ident); ignore exits whose entry was overwritten"""
+        if (kind, ident) not in stack:
+            return
+        while stack:
+            top = stack.pop()
+            events.append({'ph': 'E', 'pid': pid, 'tid': cpu_tid, 'ts': t})
+            if top == (kind, ident):
+                break
+
+    for tsc, event, a0, a1, a2 in records:
+        t = ts(tsc)
+        last = max(last, t)
+        if event == EV_SYSCALL_ENTER:
+            name = syscall_names.get(a0, 'syscall %d' % a0)
+            events.append({'ph': 'B', 'pid': pid, 'tid': cpu_tid, 'ts': t, 'name': name,
+                           'cat': 'syscall', 'args': {'arg1': '0x%x' % a1, 'pid': a2}})
+            stack.append(('syscall', a0))
+        elif event == EV_SYSCALL_EXIT:
+            close_to('syscall', a0, t)
+        elif event == EV_IRQ_ENTER:
+            name = 'irq %d' % a0
+            if a0 in IRQ_NAMES:
+                name += ' ' + IRQ_NAMES[a0]
+            events.append({'ph': 'B', 'pid': pid, 'tid': cpu_tid, 'ts': t, 'name': name, 'cat': 'irq'})
+            stack.append(('irq', a0))
+        elif event == EV_IRQ_EXIT:
+            close_to('irq', a0, t)
+        elif event == EV_CONTEXT_SWITCH:
+            # The switch never returns to the interrupted kernel path
+            while stack:
+                stack.pop()
+                events.append({'ph': 'E', 'pid': pid, 'tid': cpu_tid, 'ts': t})
+            if running is not None:
+                events.append({'ph': 'E', 'pid': pid, 'tid': proc_tid, 'ts': t})
+            running = a1
+            events.append({'ph': 'B', 'pid': pid, 'tid': proc_tid, 'ts': t, 'name': 'pid %d' % a1,
+                           'cat': 'sched', 'args': {'prev': struct.unpack('<i', struct.pack('<I', a0))[0],
+                                                    'entry': '0x%08x' % a2}})
+        elif event == EV_PAGE_FAULT:
+            events.append({'ph': 'i', 'pid': pid, 'tid': cpu_tid, 'ts': t, 's': 't', 'name': 'page fault',
+                           'cat': 'fault', 'args': {'address': '0x%08x' % a0, 'error': '0x%x' % a1,
+                                                    'eip': '0x%08x' % a2}})
+        else:
+            events.append({'ph': 'i', 'pid': pid, 'tid': cpu_tid, 'ts': t, 's': 't',
+                           'name': 'event %d' % event, 'args': {'args': [a0, a1, a2]}})
+
+    for _ in stack:
+        events.append({'ph': 'E', 'pid': pid, 'tid': cpu_tid, 'ts': last})
+    if running is not None:
+        events.append({'ph': 'E', 'pid': pid, 'tid': proc_tid, 'ts': last})
+    return events
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Convert a MaahiOS trace dump to Chrome trace JSON')
+    parser.add_argument('input', help='serial log with a [TRACE] dump, or a pmemsave image')
+    parser.add_argument('-o', '--output', default='trace.json')
+    parser.add_argument('--syscalls', default=DEFAULT_SYSCALLS, help='syscall_numbers.h for syscall names')
+    args = parser.parse_args()
+
+    with open(args.input, 'rb') as f:
+        data = f.read()
+    if b'[TRACE] BEGIN' in data:
+        buffers = buffers_from_serial(data.decode('ascii', 'replace'))
+    else:
+        buffers = buffers_from_memory(data)
+    if not buffers:
+        sys.exit('%s: no trace found' % args.input)
+
+    syscall_names = load_syscall_names(args.syscalls)
+    events = []
+    for buf in buffers:
+        try:
+            header, records = parse_buffer(buf)
+        except (ValueError, struct.error) as e:
+            print('skipping buffer: %s' % e, file=sys.stderr)
+            continue
+        print('cpu%d: %d records (%d written, %d kHz TSC)' %
+              (header['cpu'], len(records), header['head'], header['tsc_khz']))
+        events.extend(to_chrome(header, records, syscall_names))
+
+    with open(args.output, 'w') as f:
+        json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, f)
+    print('Wrote %s (%d events)' % (args.output, len(events)))
+
+
+if __name__ == '__main__':
+    main()